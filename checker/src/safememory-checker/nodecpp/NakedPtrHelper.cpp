@@ -59,7 +59,9 @@ bool isNullablePtrName(const std::string &Name) {
 bool isSoftPtrCastName(const std::string& Name) {
   return Name == "safememory::soft_ptr_static_cast" ||
           Name == "safememory::soft_ptr_reinterpret_cast" ||
-          Name == "safememory::nullable_cast";
+          Name == "safememory::nullable_cast" ||
+          // mb: unchecked access, only safememory-instrument may add it
+          Name == "safememory::detail::proven_not_null";
 }
 
 bool isWaitForAllName(const std::string& Name) {
@@ -113,7 +115,11 @@ bool isStackOnlyIteratorName(const ClangTidyContext *Context,
   //hardcode some names that are really important, and have special rules
     return Name == "eastl::node_iterator" ||
       Name == "safememory::detail::hashtable_stack_only_iterator" ||
-      Name == "safememory::detail::array_stack_only_iterator";
+      Name == "safememory::detail::array_stack_only_iterator" ||
+      Name == "safememory::detail::btree_stack_only_iterator" ||
+      Name == "safememory::detail::circular_buffer_stack_only_iterator" ||
+      Name == "safememory::detail::stable_vector_iterator" ||
+      Name == "safememory::basic_string_view";
 }
 
 bool isSystemSafeFunction(const ClangTidyContext* Context, const std::string& Name) {
@@ -31,6 +31,7 @@
 #include "Dezombify1ASTVisitor.h"
 #include "Dezombify2ASTVisitor.h"
 #include "DezombiefyRelaxASTVisitor.h"
+#include "ProvenNotNullASTVisitor.h"
 
 
 namespace nodecpp {
@@ -43,11 +44,11 @@ using namespace std;
 void DezombiefyStats::printStats() {
   
   llvm::errs() << "Dezombiefy stats Vars:" << VarCount << ", This:" <<
-    ThisCount << ", Relaxed:" << RelaxedCount << "\n";
+    ThisCount << ", Relaxed:" << RelaxedCount << ", NotNull:" << NotNullCount << "\n";
 }
 
 
-void dezombiefy(ASTContext &Ctx, bool SilentMode) {
+void dezombiefy(ASTContext &Ctx, bool SilentMode, bool ProvenNotNull) {
       
   Dezombify1ASTVisitor Visitor1(Ctx, SilentMode);
   Visitor1.TraverseDecl(Ctx.getTranslationUnitDecl());
@@ -58,7 +59,16 @@ void dezombiefy(ASTContext &Ctx, bool SilentMode) {
   Dezombify2ASTVisitor Visitor2(Ctx, SilentMode);
   Visitor2.TraverseDecl(Ctx.getTranslationUnitDecl());
 
-  Visitor2.getStats().printStats();
+  auto Stats = Visitor2.getStats();
+  // mb: opt-in, until the pass has seen more code
+  if(ProvenNotNull) {
+    ProvenNotNullASTVisitor VisitorNotNull(Ctx, SilentMode);
+    VisitorNotNull.TraverseDecl(Ctx.getTranslationUnitDecl());
+
+    Stats.NotNullCount = VisitorNotNull.getCount();
+    Visitor2.addReplacement(VisitorNotNull.finishReplacements());
+  }
+  Stats.printStats();
 
   auto &Reps = Visitor2.finishReplacements();
   overwriteChangedFiles(Ctx, Reps, "safememory-dezombiefy");
@@ -38,13 +38,14 @@ struct DezombiefyStats {
   int VarCount = 0;
   int ThisCount = 0;
   int RelaxedCount = 0;
+  int NotNullCount = 0;
 
   void printStats();
 };
 
 
 
-void dezombiefy(clang::ASTContext &Context, bool SilentMode);
+void dezombiefy(clang::ASTContext &Context, bool SilentMode, bool ProvenNotNull);
 
 } // namespace nodecpp
 
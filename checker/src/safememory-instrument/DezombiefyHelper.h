@@ -94,6 +94,27 @@ bool isDezombiefyCandidate(clang::DeclRefExpr *E) {
   return false;
 }
 
+inline
+bool isNullablePtrRecord(const clang::CXXRecordDecl *Rd) {
+  if(!Rd)
+    return false;
+
+  auto Name = Rd->getQualifiedNameAsString();
+  return Name == "safememory::detail::nullable_ptr_impl" ||
+    Name == "safememory::detail::nullable_ptr_base_impl" ||
+    Name == "safememory::detail::nullable_ptr_no_checks" ||
+    Name == "safememory::detail::nullable_ptr_base_no_checks";
+}
+
+inline
+bool isNullablePtrType(clang::QualType Qt) {
+  Qt = Qt.getCanonicalType();
+  if(Qt->isReferenceType())
+    return false;
+
+  return isNullablePtrRecord(Qt->getAsCXXRecordDecl());
+}
+
 inline
 bool isLiteralExpr(const clang::Expr *E) {
   return llvm::isa<clang::IntegerLiteral>(E) || llvm::isa<clang::StringLiteral>(E) ||
@@ -80,6 +80,10 @@ FixOnly("fix-only", cl::desc("fix expressions that need to be refactored, but do
 // SilentMode("silent-mode", cl::desc("Don't emit error messages. Just do best effort.\n"),
 //     cl::cat(NodecppInstrumentCategory));
 
+static cl::opt<bool>
+ProvenNotNull("proven-not-null", cl::desc("Skip null checks at nullable_ptr dereferences proven not null.\n"),
+    cl::cat(NodecppInstrumentCategory));
+
 static cl::opt<bool>
 NoSilentMode("no-silent-mode", cl::desc("Emit error message at every place the tool can't verify (or make) code as zombie free.\n"),
     cl::cat(NodecppInstrumentCategory));
@@ -131,7 +135,7 @@ public:
 
   void HandleTranslationUnit(ASTContext &Context) override {
 
-      dezombiefy(Context, !NoSilentMode);
+      dezombiefy(Context, !NoSilentMode, ProvenNotNull);
     }
 };
 
@@ -0,0 +1,391 @@
+/* -------------------------------------------------------------------------------
+* Copyright (c) 2021, OLogN Technologies AG
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of the OLogN Technologies AG nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL OLogN Technologies AG BE LIABLE FOR ANY
+* DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* -------------------------------------------------------------------------------*/
+
+#ifndef NODECPP_INSTRUMENT_PROVENNOTNULLASTVISITOR_H
+#define NODECPP_INSTRUMENT_PROVENNOTNULLASTVISITOR_H
+
+#include "DezombiefyHelper.h"
+#include "BaseASTVisitor.h"
+
+#include "clang/AST/ASTConsumer.h"
+#include "clang/AST/ASTContext.h"
+#include "clang/AST/RecursiveASTVisitor.h"
+
+
+namespace nodecpp {
+
+using namespace clang;
+using namespace llvm;
+
+//------------------------------------------------------------------------====//
+// NullableUseCollector: classifies every use of a local nullable_ptr
+//====------------------------------------------------------------------------//
+
+class NullableUseCollector {
+
+public:
+  enum UseKind { ReadOnly, Assign };
+
+  // uses not found here are escapes (non-const ref, address taken, move, etc)
+  DenseMap<const DeclRefExpr *, UseKind> Uses;
+  // uses that are the object of operator-> or operator*
+  DenseSet<const DeclRefExpr *> Derefs;
+  DenseSet<const VarDecl *> Escaped;
+
+private:
+  static
+  const DeclRefExpr *getNullableRef(const Expr *E) {
+    if(!E)
+      return nullptr;
+
+    auto Dre = dyn_cast<DeclRefExpr>(E->IgnoreParenImpCasts());
+    if(!Dre)
+      return nullptr;
+
+    auto Vd = dyn_cast_or_null<VarDecl>(Dre->getDecl());
+    if(Vd && Vd->hasLocalStorage() && isNullablePtrType(Vd->getType()))
+      return Dre;
+
+    return nullptr;
+  }
+
+  static
+  bool isReadOnlyParam(QualType Qt) {
+    if(Qt->isReferenceType())
+      return Qt->isLValueReferenceType() &&
+        Qt.getNonReferenceType().isConstQualified();
+
+    // by value, the copy constructor will be classified on its own
+    return true;
+  }
+
+  void markArgs(const FunctionDecl *Fd, const CallExpr *Ce, unsigned ArgOffset) {
+    if(!Fd)
+      return;
+
+    for(unsigned I = ArgOffset; I < Ce->getNumArgs(); ++I) {
+      unsigned P = I - ArgOffset;
+      if(P >= Fd->getNumParams())
+        break;
+
+      if(auto Dre = getNullableRef(Ce->getArg(I))) {
+        if(isReadOnlyParam(Fd->getParamDecl(P)->getType()))
+          Uses[Dre] = ReadOnly;
+      }
+    }
+  }
+
+  void markObject(const CXXMethodDecl *Md, const Expr *Obj,
+    OverloadedOperatorKind Op) {
+    auto Dre = getNullableRef(Obj);
+    if(!Dre || !Md)
+      return;
+
+    if(Md->isConst()) {
+      Uses[Dre] = ReadOnly;
+      if(Op == OO_Arrow || Op == OO_Star)
+        Derefs.insert(Dre);
+    }
+    else if(Op == OO_Equal && isNullablePtrRecord(Md->getParent()))
+      Uses[Dre] = Assign;
+  }
+
+  void visitCall(const Stmt *St) {
+
+    if(auto Oce = dyn_cast<CXXOperatorCallExpr>(St)) {
+      auto Md = dyn_cast_or_null<CXXMethodDecl>(Oce->getDirectCallee());
+      if(Md) {
+        auto Op = Oce->getOperator();
+        // unary operator* has only the object
+        if(Op == OO_Star && Oce->getNumArgs() != 1)
+          Op = OO_None;
+        markObject(Md, Oce->getArg(0), Op);
+        markArgs(Md, Oce, 1);
+      }
+      else
+        markArgs(Oce->getDirectCallee(), Oce, 0);
+    }
+    else if(auto Mce = dyn_cast<CXXMemberCallExpr>(St)) {
+      markObject(Mce->getMethodDecl(), Mce->getImplicitObjectArgument(), OO_None);
+      markArgs(Mce->getMethodDecl(), Mce, 0);
+    }
+    else if(auto Ce = dyn_cast<CallExpr>(St)) {
+      markArgs(Ce->getDirectCallee(), Ce, 0);
+    }
+    else if(auto Cce = dyn_cast<CXXConstructExpr>(St)) {
+      auto Ctor = Cce->getConstructor();
+      for(unsigned I = 0; Ctor && I < Cce->getNumArgs() && I < Ctor->getNumParams(); ++I) {
+        if(auto Dre = getNullableRef(Cce->getArg(I))) {
+          if(isReadOnlyParam(Ctor->getParamDecl(I)->getType()))
+            Uses[Dre] = ReadOnly;
+        }
+      }
+    }
+  }
+
+public:
+  // pre-order walk, parents mark their children before we reach them
+  void collect(const Stmt *St) {
+    if(!St)
+      return;
+
+    visitCall(St);
+
+    if(auto Le = dyn_cast<LambdaExpr>(St)) {
+      for(auto &C : Le->captures()) {
+        if(C.capturesVariable() && C.getCaptureKind() == LCK_ByRef)
+          Escaped.insert(C.getCapturedVar());
+      }
+    }
+    else if(auto Dre = getNullableRef(dyn_cast<Expr>(St))) {
+      if(Dre == St && Uses.find(Dre) == Uses.end())
+        Escaped.insert(cast<VarDecl>(Dre->getDecl()));
+    }
+
+    for(auto Ch : St->children())
+      collect(Ch);
+  }
+};
+
+
+//------------------------------------------------------------------------====//
+// ProvenNotNullASTVisitor: rewrites dereferences of local nullable_ptr
+// dominated by a null test of the same variable
+//====------------------------------------------------------------------------//
+
+class ProvenNotNullASTVisitor
+  : public BaseASTVisitor<ProvenNotNullASTVisitor> {
+
+  using Base = BaseASTVisitor<ProvenNotNullASTVisitor>;
+
+  NullableUseCollector Collector;
+  DenseSet<const DeclRefExpr *> ToRewrite;
+  int Count = 0;
+
+  bool isCandidate(const DeclRefExpr *Dre) {
+    if(!Dre)
+      return false;
+    auto Vd = dyn_cast_or_null<VarDecl>(Dre->getDecl());
+    return Vd && Vd->hasLocalStorage() && isNullablePtrType(Vd->getType()) &&
+      Collector.Escaped.find(Vd) == Collector.Escaped.end();
+  }
+
+  const VarDecl *getTested(const Expr *E) {
+    auto Dre = dyn_cast_or_null<DeclRefExpr>(E->IgnoreParenImpCasts());
+    return isCandidate(Dre) ? cast<VarDecl>(Dre->getDecl()) : nullptr;
+  }
+
+  /// \brief Collects variables known not null when \c E evaluates to \c WhenTrue
+  void prove(const Expr *E, bool WhenTrue, SmallVectorImpl<const VarDecl *> &Vars) {
+
+    E = E->IgnoreParenImpCasts();
+
+    if(auto Uo = dyn_cast<UnaryOperator>(E)) {
+      if(Uo->getOpcode() == UO_LNot)
+        prove(Uo->getSubExpr(), !WhenTrue, Vars);
+    }
+    else if(auto Bo = dyn_cast<BinaryOperator>(E)) {
+      if((Bo->getOpcode() == BO_LAnd && WhenTrue) ||
+        (Bo->getOpcode() == BO_LOr && !WhenTrue)) {
+        prove(Bo->getLHS(), WhenTrue, Vars);
+        prove(Bo->getRHS(), WhenTrue, Vars);
+      }
+    }
+    else if(auto Mce = dyn_cast<CXXMemberCallExpr>(E)) {
+      // explicit operator bool
+      if(WhenTrue && isa<CXXConversionDecl>(Mce->getMethodDecl())) {
+        if(auto Vd = getTested(Mce->getImplicitObjectArgument()))
+          Vars.push_back(Vd);
+      }
+    }
+    else if(auto Oce = dyn_cast<CXXOperatorCallExpr>(E)) {
+      auto Op = Oce->getOperator();
+      if(Oce->getNumArgs() == 2 &&
+        isa<CXXNullPtrLiteralExpr>(Oce->getArg(1)->IgnoreParenImpCasts()) &&
+        ((Op == OO_ExclaimEqual && WhenTrue) || (Op == OO_EqualEqual && !WhenTrue))) {
+        if(auto Vd = getTested(Oce->getArg(0)))
+          Vars.push_back(Vd);
+      }
+    }
+  }
+
+  static
+  bool alwaysExits(const Stmt *St) {
+    if(!St)
+      return false;
+
+    if(isa<ReturnStmt>(St) || isa<BreakStmt>(St) ||
+      isa<ContinueStmt>(St) || isa<GotoStmt>(St))
+      return true;
+
+    if(auto Cs = dyn_cast<CompoundStmt>(St))
+      return !Cs->body_empty() && alwaysExits(Cs->body_back());
+
+    if(auto E = dyn_cast<Expr>(St))
+      return isa<CXXThrowExpr>(E->IgnoreImplicit()->IgnoreParenImpCasts());
+
+    return false;
+  }
+
+  // checks nothing inside St may change Vd or jump into the middle,
+  // and collects the dereferences we may rewrite
+  bool checkRegion(const Stmt *St, const VarDecl *Vd, bool InLambda,
+    SmallVectorImpl<const DeclRefExpr *> &Found) {
+
+    if(!St)
+      return true;
+
+    if(isa<LabelStmt>(St) || isa<SwitchCase>(St))
+      return false;
+
+    if(auto Dre = dyn_cast<DeclRefExpr>(St)) {
+      if(Dre->getDecl() == Vd) {
+        auto It = Collector.Uses.find(Dre);
+        if(It == Collector.Uses.end() || It->second != NullableUseCollector::ReadOnly)
+          return false;
+        if(!InLambda && Collector.Derefs.count(Dre))
+          Found.push_back(Dre);
+      }
+    }
+
+    InLambda = InLambda || isa<LambdaExpr>(St);
+    for(auto Ch : St->children()) {
+      if(!checkRegion(Ch, Vd, InLambda, Found))
+        return false;
+    }
+    return true;
+  }
+
+  // mb: a variable changed anywhere in the condition, i.e. if(p && (p = q, true)),
+  // may be tested before the change, so nothing is proven about it
+  void proveCond(const Expr *Cond, bool WhenTrue, SmallVectorImpl<const VarDecl *> &Vars) {
+    prove(Cond, WhenTrue, Vars);
+
+    SmallVector<const DeclRefExpr *, 8> Unused;
+    erase_if(Vars, [&](const VarDecl *Vd) {
+      return !checkRegion(Cond, Vd, false, Unused);
+    });
+  }
+
+  template<class It>
+  void addRegion(It Begin, It End, ArrayRef<const VarDecl *> Vars) {
+    for(auto Vd : Vars) {
+      SmallVector<const DeclRefExpr *, 8> Found;
+      bool Ok = true;
+      for(auto I = Begin; I != End && Ok; ++I)
+        Ok = checkRegion(*I, Vd, false, Found);
+
+      if(Ok)
+        ToRewrite.insert(Found.begin(), Found.end());
+    }
+  }
+
+  void analyze(const Stmt *St) {
+    if(!St)
+      return;
+
+    if(auto If = dyn_cast<IfStmt>(St)) {
+      if(!If->getInit() && !If->getConditionVariable() && !If->isConstexpr()) {
+        SmallVector<const VarDecl *, 4> WhenTrue;
+        proveCond(If->getCond(), true, WhenTrue);
+        const Stmt *Then = If->getThen();
+        addRegion(&Then, &Then + 1, WhenTrue);
+
+        if(const Stmt *Else = If->getElse()) {
+          SmallVector<const VarDecl *, 4> WhenFalse;
+          proveCond(If->getCond(), false, WhenFalse);
+          addRegion(&Else, &Else + 1, WhenFalse);
+        }
+      }
+    }
+    else if(auto Cs = dyn_cast<CompoundStmt>(St)) {
+      // if(!p) return; p->...
+      for(auto I = Cs->body_begin(); I != Cs->body_end(); ++I) {
+        auto If = dyn_cast<IfStmt>(*I);
+        if(If && !If->getInit() && !If->getConditionVariable() &&
+          !If->isConstexpr() && alwaysExits(If->getThen())) {
+          SmallVector<const VarDecl *, 4> WhenFalse;
+          proveCond(If->getCond(), false, WhenFalse);
+          addRegion(I + 1, Cs->body_end(), WhenFalse);
+        }
+      }
+    }
+
+    for(auto Ch : St->children())
+      analyze(Ch);
+  }
+
+public:
+  explicit ProvenNotNullASTVisitor(clang::ASTContext &Context, bool SilentMode):
+    Base(Context, SilentMode) {}
+
+  int getCount() const { return Count; }
+
+  bool VisitFunctionDecl(clang::FunctionDecl *D) {
+
+    // mb: templates may be instantiated with types other than nullable_ptr,
+    // we don't want inconsistent changes between instantiations
+    if (D->isDependentContext() || D->isTemplateInstantiation())
+      return Base::VisitFunctionDecl(D);
+
+    if(!D->doesThisDeclarationHaveABody())
+      return Base::VisitFunctionDecl(D);
+
+    Collector = NullableUseCollector();
+    ToRewrite.clear();
+
+    auto Body = D->getBody();
+    Collector.collect(Body);
+    analyze(Body);
+
+    for(auto Dre : ToRewrite) {
+      auto Loc = Dre->getBeginLoc();
+      if(Loc.isInvalid() || Loc.isMacroID())
+        continue;
+
+      auto ChRange = toCheckedCharRange(Dre->getSourceRange(),
+        Context.getSourceManager(), Context.getLangOpts());
+      if(ChRange.isValid()) {
+        ++Count;
+
+        SmallString<64> Fix;
+        Fix += "safememory::detail::proven_not_null( ";
+        Fix += Dre->getNameInfo().getAsString();
+        Fix += " )";
+
+        addReplacement(CodeChange::makeReplace(
+          Context.getSourceManager(), ChRange, Fix));
+      }
+    }
+
+    return Base::VisitFunctionDecl(D);
+  }
+};
+
+} // namespace nodecpp
+
+#endif // NODECPP_INSTRUMENT_PROVENNOTNULLASTVISITOR_H
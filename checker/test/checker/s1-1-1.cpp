@@ -14,3 +14,11 @@ void bad1() {
 	soft_ptr<long> l = soft_ptr_reinterpret_cast<long>( i );
 // CHECK: :[[@LINE-1]]:21: error: (S1.1.1)
 }
+
+void bad2() {
+
+	nullable_ptr<int> n;
+
+	int i = *detail::proven_not_null( n );
+// CHECK: :[[@LINE-1]]:11: error: (S1.1.1)
+}
@@ -677,6 +677,8 @@ class nullable_ptr_base_impl
 	friend T1* nullable_cast_impl( nullable_ptr_impl<T2> p );
 	template<class T1>
 	friend T1* nullable_cast_impl( nullable_ptr_impl<T1> p );
+	template<class T1>
+	friend T1* proven_not_null( const nullable_ptr_impl<T1>& p );
 
 	T* t;
 
@@ -921,6 +923,11 @@ T* nullable_cast_impl( nullable_ptr_impl<T> p ) {
 }
 
 
+template<class T>
+T* proven_not_null( const nullable_ptr_impl<T>& p ) {
+	return p.t;
+}
+
 template<class T, class T1>
 nullable_ptr_impl<T1> nullable_cast_impl( T* p ) {
 	return nullable_ptr_impl<T1>( p );
@@ -672,6 +672,8 @@ class nullable_ptr_base_no_checks
 	friend T1* nullable_cast_no_checks( nullable_ptr_no_checks<T2> p );
 	template<class T1>
 	friend T1* nullable_cast_no_checks( nullable_ptr_no_checks<T1> p );
+	template<class T1>
+	friend T1* proven_not_null( const nullable_ptr_no_checks<T1>& p );
 
 	T* t;
 
@@ -917,6 +919,11 @@ T* nullable_cast_no_checks( nullable_ptr_no_checks<T> p ) {
 }
 
 
+template<class T>
+T* proven_not_null( const nullable_ptr_no_checks<T>& p ) {
+	return p.t;
+}
+
 template<class T, class T1>
 nullable_ptr_no_checks<T1> nullable_cast_no_checks( T* p ) {
 	return nullable_ptr_no_checks<T1>( p );
@@ -0,0 +1,202 @@
+// RUN: %check_safememory_instrument --proven-not-null %s %t %p
+
+#include <safememory/safe_ptr.h>
+
+using namespace safememory;
+
+struct S {
+    int i = 0;
+    void method() {}
+};
+
+void byRef(nullable_ptr<S>& p);
+void byValue(nullable_ptr<S> p);
+
+int func1(nullable_ptr<S> p) {
+
+    if(p) {
+        p->method();
+// CHECK-FIXES: safememory::detail::proven_not_null( p )->method();
+        return (*p).i;
+// CHECK-FIXES: return (*safememory::detail::proven_not_null( p )).i;
+    }
+
+    if(p != nullptr)
+        p->method();
+// CHECK-FIXES: safememory::detail::proven_not_null( p )->method();
+
+    if(p == nullptr)
+        return 0;
+    else
+        p->method();
+// CHECK-FIXES: safememory::detail::proven_not_null( p )->method();
+
+    return 1;
+}
+
+int func2(nullable_ptr<S> p, bool b) {
+
+    if(!p)
+        return 0;
+
+    byValue(p);
+    p->method();
+// CHECK-FIXES: safememory::detail::proven_not_null( p )->method();
+
+    if(b && p)
+        return p->i;
+// CHECK-FIXES: return safememory::detail::proven_not_null( p )->i;
+
+    return p->i;
+// CHECK-FIXES: return safememory::detail::proven_not_null( p )->i;
+}
+
+int func3(nullable_ptr<S> p, nullable_ptr<S> q) {
+
+    // assignment inside the region
+    if(p) {
+        p->method();
+// CHECK-FIXES: p->method();
+        p = q;
+    }
+
+    // not dominated
+    if(q || p)
+        q->method();
+// CHECK-FIXES: q->method();
+
+    return 0;
+}
+
+int func4(nullable_ptr<S> p) {
+
+    // may be changed behind our back
+    byRef(p);
+
+    if(p)
+        return p->i;
+// CHECK-FIXES: return p->i;
+
+    return 0;
+}
+
+int func5(nullable_ptr<S> p, nullable_ptr<S> q) {
+
+    // assignment inside the condition
+    if(p && (p = q, true))
+        return p->i;
+// CHECK-FIXES: return p->i;
+
+    if(!p || (p = q, false))
+        return 0;
+
+    return p->i;
+// CHECK-FIXES: return p->i;
+}
+
+int func6(nullable_ptr<S> p, nullable_ptr<S> q) {
+
+    // alias by reference
+    nullable_ptr<S>& r = p;
+
+    if(p) {
+        r = q;
+        return p->i;
+// CHECK-FIXES: return p->i;
+    }
+
+    return 0;
+}
+
+int func7(nullable_ptr<S> p, nullable_ptr<S> q) {
+
+    // alias by pointer
+    auto pp = &p;
+
+    if(!p)
+        return 0;
+
+    *pp = q;
+    return p->i;
+// CHECK-FIXES: return p->i;
+}
+
+int func8(nullable_ptr<S> p, nullable_ptr<S> q) {
+
+    // calls that may reset it
+    if(p) {
+        p.swap(q);
+        return p->i;
+// CHECK-FIXES: return p->i;
+    }
+
+    return 0;
+}
+
+int func9(nullable_ptr<S> p, nullable_ptr<S> q) {
+
+    if(p) {
+        byRef(q);
+        byRef(p);
+        return p->i;
+// CHECK-FIXES: return p->i;
+    }
+
+    return 0;
+}
+
+int func10(nullable_ptr<S> p, nullable_ptr<S> q) {
+
+    // reset by a lambda
+    auto reset = [&]() { p = q; };
+
+    if(!p)
+        return 0;
+
+    reset();
+    return p->i;
+// CHECK-FIXES: return p->i;
+}
+
+int func11(nullable_ptr<S> p, nullable_ptr<S> q) {
+
+    int r = 0;
+
+    // loop conditions are not used
+    while(p) {
+        r += p->i;
+// CHECK-FIXES: r += p->i;
+        p = q;
+    }
+
+    for(; p; p = q)
+        r += p->i;
+// CHECK-FIXES: r += p->i;
+
+    // changed at the next iteration
+    if(p) {
+        for(int k = 0; k != 2; ++k) {
+            r += p->i;
+// CHECK-FIXES: r += p->i;
+            p = q;
+        }
+    }
+
+    for(int k = 0; k != 2; ++k) {
+        if(!p)
+            continue;
+        r += p->i;
+// CHECK-FIXES: r += p->i;
+        p = q;
+    }
+
+    // tested again at every iteration
+    for(int k = 0; k != 2; ++k) {
+        if(!p)
+            break;
+        r += p->i;
+// CHECK-FIXES: r += safememory::detail::proven_not_null( p )->i;
+    }
+
+    return r;
+}
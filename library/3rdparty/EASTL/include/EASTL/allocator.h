@@ -78,6 +78,12 @@ namespace eastl
 			return (T*)allocate(count * sizeof(T), flags);
 		}
 
+		// we don't know the real size of the block, so count is left as is
+		template<class T>
+		T* allocate_array_at_least(eastl_size_t& count, int flags = 0) {
+			return allocate_array<T>(count, flags);
+		}
+
 		template<class T>
 		T* allocate_array_zeroed(eastl_size_t count, int flags = 0) {
 			//TODO use aligned allocate
@@ -81,6 +81,11 @@ namespace eastl
 	/// is useful for cases whereby the calculation of the hash value for
 	/// a contained object is very expensive.
 	///
+	/// RehashPolicy
+	/// Chooses bucket counts and when to grow, its nested range_hashing type
+	/// maps a hash code to a bucket. Default is prime_rehash_policy with
+	/// mod_range_hashing.
+	///
 	/// find_as
 	/// In order to support the ability to have a hashtable of strings but
 	/// be able to do efficiently lookups via char pointers (i.e. so they
@@ -97,17 +102,17 @@ namespace eastl
 	///     i = hashMap.find_as("hello", hash<char*>(), equal_to_2<string, char*>());
 	///
 	template <typename Key, typename T, typename Hash = eastl::hash<Key>, typename Predicate = eastl::equal_to<Key>,
-			  typename Allocator = EASTLAllocatorType, bool bCacheHashCode = false>
+			  typename Allocator = EASTLAllocatorType, bool bCacheHashCode = false, typename RehashPolicy = prime_rehash_policy>
 	class hash_map
 		: public hashtable<Key, eastl::pair<const Key, T>, Allocator, eastl::use_first<eastl::pair<const Key, T> >, Predicate,
-							Hash, mod_range_hashing, default_ranged_hash, prime_rehash_policy, bCacheHashCode, true, true>
+							Hash, typename RehashPolicy::range_hashing, default_ranged_hash, RehashPolicy, bCacheHashCode, true, true>
 	{
 	public:
 		typedef hashtable<Key, eastl::pair<const Key, T>, Allocator,
 						  eastl::use_first<eastl::pair<const Key, T> >,
-						  Predicate, Hash, mod_range_hashing, default_ranged_hash,
-						  prime_rehash_policy, bCacheHashCode, true, true>        base_type;
-		typedef hash_map<Key, T, Hash, Predicate, Allocator, bCacheHashCode>      this_type;
+						  Predicate, Hash, typename RehashPolicy::range_hashing, default_ranged_hash,
+						  RehashPolicy, bCacheHashCode, true, true>        base_type;
+		typedef hash_map<Key, T, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>      this_type;
 		typedef typename base_type::size_type                                     size_type;
 		typedef typename base_type::key_type                                      key_type;
 		typedef T                                                                 mapped_type;
@@ -137,7 +142,7 @@ namespace eastl
 		/// Constructor which creates an empty container with allocator.
 		///
 		explicit hash_map(const allocator_type& allocator)
-			: base_type(0, Hash(), mod_range_hashing(), default_ranged_hash(),
+			: base_type(0, Hash(), typename RehashPolicy::range_hashing(), default_ranged_hash(),
 						Predicate(), eastl::use_first<eastl::pair<const Key, T> >(), allocator)
 		{
 			// Empty
@@ -152,7 +157,7 @@ namespace eastl
 		///
 		explicit hash_map(size_type nBucketCount, const Hash& hashFunction = Hash(),
 						  const Predicate& predicate = Predicate(), const allocator_type& allocator = EASTL_HASH_MAP_DEFAULT_ALLOCATOR)
-			: base_type(nBucketCount, hashFunction, mod_range_hashing(), default_ranged_hash(),
+			: base_type(nBucketCount, hashFunction, typename RehashPolicy::range_hashing(), default_ranged_hash(),
 						predicate, eastl::use_first<eastl::pair<const Key, T> >(), allocator)
 		{
 			// Empty
@@ -184,7 +189,7 @@ namespace eastl
 		///
 		hash_map(std::initializer_list<value_type> ilist, size_type nBucketCount = 0, const Hash& hashFunction = Hash(),
 				   const Predicate& predicate = Predicate(), const allocator_type& allocator = EASTL_HASH_MAP_DEFAULT_ALLOCATOR)
-			: base_type(ilist.begin(), ilist.end(), nBucketCount, hashFunction, mod_range_hashing(), default_ranged_hash(),
+			: base_type(ilist.begin(), ilist.end(), nBucketCount, hashFunction, typename RehashPolicy::range_hashing(), default_ranged_hash(),
 						predicate, eastl::use_first<eastl::pair<const Key, T> >(), allocator)
 		{
 			// Empty
@@ -199,7 +204,7 @@ namespace eastl
 		template <typename ForwardIterator>
 		hash_map(ForwardIterator first, ForwardIterator last, size_type nBucketCount = 0, const Hash& hashFunction = Hash(),
 				 const Predicate& predicate = Predicate(), const allocator_type& allocator = EASTL_HASH_MAP_DEFAULT_ALLOCATOR)
-			: base_type(first, last, nBucketCount, hashFunction, mod_range_hashing(), default_ranged_hash(),
+			: base_type(first, last, nBucketCount, hashFunction, typename RehashPolicy::range_hashing(), default_ranged_hash(),
 						predicate, eastl::use_first<eastl::pair<const Key, T> >(), allocator)
 		{
 			// Empty
@@ -347,8 +352,8 @@ namespace eastl
 	/// hash_map erase_if
 	///
 	/// https://en.cppreference.com/w/cpp/container/unordered_map/erase_if
-	template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator, bool bCacheHashCode, typename UserPredicate>
-	typename eastl::hash_map<Key, T, Hash, Predicate, Allocator, bCacheHashCode>::size_type erase_if(eastl::hash_map<Key, T, Hash, Predicate, Allocator, bCacheHashCode>& c, UserPredicate predicate)
+	template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator, bool bCacheHashCode, typename RehashPolicy, typename UserPredicate>
+	typename eastl::hash_map<Key, T, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>::size_type erase_if(eastl::hash_map<Key, T, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>& c, UserPredicate predicate)
 	{
 		auto oldSize = c.size();
 		// Erases all elements that satisfy the predicate from the container.
@@ -374,17 +379,17 @@ namespace eastl
 	/// documentation for hash_set for details.
 	///
 	template <typename Key, typename T, typename Hash = eastl::hash<Key>, typename Predicate = eastl::equal_to<Key>,
-			  typename Allocator = EASTLAllocatorType, bool bCacheHashCode = false>
+			  typename Allocator = EASTLAllocatorType, bool bCacheHashCode = false, typename RehashPolicy = prime_rehash_policy>
 	class hash_multimap
 		: public hashtable<Key, eastl::pair<const Key, T>, Allocator, eastl::use_first<eastl::pair<const Key, T> >, Predicate,
-						   Hash, mod_range_hashing, default_ranged_hash, prime_rehash_policy, bCacheHashCode, true, false>
+						   Hash, typename RehashPolicy::range_hashing, default_ranged_hash, RehashPolicy, bCacheHashCode, true, false>
 	{
 	public:
 		typedef hashtable<Key, eastl::pair<const Key, T>, Allocator,
 						  eastl::use_first<eastl::pair<const Key, T> >,
-						  Predicate, Hash, mod_range_hashing, default_ranged_hash,
-						  prime_rehash_policy, bCacheHashCode, true, false>           base_type;
-		typedef hash_multimap<Key, T, Hash, Predicate, Allocator, bCacheHashCode>     this_type;
+						  Predicate, Hash, typename RehashPolicy::range_hashing, default_ranged_hash,
+						  RehashPolicy, bCacheHashCode, true, false>           base_type;
+		typedef hash_multimap<Key, T, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>     this_type;
 		typedef typename base_type::size_type                                         size_type;
 		typedef typename base_type::key_type                                          key_type;
 		typedef T                                                                     mapped_type;
@@ -405,7 +410,7 @@ namespace eastl
 		/// Default constructor.
 		///
 		explicit hash_multimap(const allocator_type& allocator = EASTL_HASH_MULTIMAP_DEFAULT_ALLOCATOR)
-			: base_type(0, Hash(), mod_range_hashing(), default_ranged_hash(),
+			: base_type(0, Hash(), typename RehashPolicy::range_hashing(), default_ranged_hash(),
 						Predicate(), eastl::use_first<eastl::pair<const Key, T> >(), allocator)
 		{
 			// Empty
@@ -420,7 +425,7 @@ namespace eastl
 		///
 		explicit hash_multimap(size_type nBucketCount, const Hash& hashFunction = Hash(),
 							   const Predicate& predicate = Predicate(), const allocator_type& allocator = EASTL_HASH_MULTIMAP_DEFAULT_ALLOCATOR)
-			: base_type(nBucketCount, hashFunction, mod_range_hashing(), default_ranged_hash(),
+			: base_type(nBucketCount, hashFunction, typename RehashPolicy::range_hashing(), default_ranged_hash(),
 						predicate, eastl::use_first<eastl::pair<const Key, T> >(), allocator)
 		{
 			// Empty
@@ -452,7 +457,7 @@ namespace eastl
 		///
 		hash_multimap(std::initializer_list<value_type> ilist, size_type nBucketCount = 0, const Hash& hashFunction = Hash(),
 				   const Predicate& predicate = Predicate(), const allocator_type& allocator = EASTL_HASH_MULTIMAP_DEFAULT_ALLOCATOR)
-			: base_type(ilist.begin(), ilist.end(), nBucketCount, hashFunction, mod_range_hashing(), default_ranged_hash(),
+			: base_type(ilist.begin(), ilist.end(), nBucketCount, hashFunction, typename RehashPolicy::range_hashing(), default_ranged_hash(),
 						predicate, eastl::use_first<eastl::pair<const Key, T> >(), allocator)
 		{
 			// Empty
@@ -467,7 +472,7 @@ namespace eastl
 		template <typename ForwardIterator>
 		hash_multimap(ForwardIterator first, ForwardIterator last, size_type nBucketCount = 0, const Hash& hashFunction = Hash(),
 					  const Predicate& predicate = Predicate(), const allocator_type& allocator = EASTL_HASH_MULTIMAP_DEFAULT_ALLOCATOR)
-			: base_type(first, last, nBucketCount, hashFunction, mod_range_hashing(), default_ranged_hash(),
+			: base_type(first, last, nBucketCount, hashFunction, typename RehashPolicy::range_hashing(), default_ranged_hash(),
 						predicate, eastl::use_first<eastl::pair<const Key, T> >(), allocator)
 		{
 			// Empty
@@ -514,8 +519,8 @@ namespace eastl
 	/// hash_multimap erase_if
 	///
 	/// https://en.cppreference.com/w/cpp/container/unordered_multimap/erase_if
-	template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator, bool bCacheHashCode, typename UserPredicate>
-	typename eastl::hash_multimap<Key, T, Hash, Predicate, Allocator, bCacheHashCode>::size_type erase_if(eastl::hash_multimap<Key, T, Hash, Predicate, Allocator, bCacheHashCode>& c, UserPredicate predicate)
+	template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator, bool bCacheHashCode, typename RehashPolicy, typename UserPredicate>
+	typename eastl::hash_multimap<Key, T, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>::size_type erase_if(eastl::hash_multimap<Key, T, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>& c, UserPredicate predicate)
 	{
 		auto oldSize = c.size();
 		// Erases all elements that satisfy the predicate from the container.
@@ -539,11 +544,11 @@ namespace eastl
 	// global operators
 	///////////////////////////////////////////////////////////////////////
 
-	template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator, bool bCacheHashCode>
-	inline bool operator==(const hash_map<Key, T, Hash, Predicate, Allocator, bCacheHashCode>& a,
-						   const hash_map<Key, T, Hash, Predicate, Allocator, bCacheHashCode>& b)
+	template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator, bool bCacheHashCode, typename RehashPolicy>
+	inline bool operator==(const hash_map<Key, T, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>& a,
+						   const hash_map<Key, T, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>& b)
 	{
-		typedef typename hash_map<Key, T, Hash, Predicate, Allocator, bCacheHashCode>::const_iterator const_iterator;
+		typedef typename hash_map<Key, T, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>::const_iterator const_iterator;
 
 		// We implement branching with the assumption that the return value is usually false.
 		if(a.size() != b.size())
@@ -563,19 +568,19 @@ namespace eastl
 	}
 
 #if !defined(EA_COMPILER_HAS_THREE_WAY_COMPARISON)
-	template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator, bool bCacheHashCode>
-	inline bool operator!=(const hash_map<Key, T, Hash, Predicate, Allocator, bCacheHashCode>& a,
-						   const hash_map<Key, T, Hash, Predicate, Allocator, bCacheHashCode>& b)
+	template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator, bool bCacheHashCode, typename RehashPolicy>
+	inline bool operator!=(const hash_map<Key, T, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>& a,
+						   const hash_map<Key, T, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>& b)
 	{
 		return !(a == b);
 	}
 #endif
 
-	template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator, bool bCacheHashCode>
-	inline bool operator==(const hash_multimap<Key, T, Hash, Predicate, Allocator, bCacheHashCode>& a,
-						   const hash_multimap<Key, T, Hash, Predicate, Allocator, bCacheHashCode>& b)
+	template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator, bool bCacheHashCode, typename RehashPolicy>
+	inline bool operator==(const hash_multimap<Key, T, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>& a,
+						   const hash_multimap<Key, T, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>& b)
 	{
-		typedef typename hash_multimap<Key, T, Hash, Predicate, Allocator, bCacheHashCode>::const_iterator const_iterator;
+		typedef typename hash_multimap<Key, T, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>::const_iterator const_iterator;
 		typedef typename eastl::iterator_traits<const_iterator>::difference_type difference_type;
 
 		// We implement branching with the assumption that the return value is usually false.
@@ -621,9 +626,9 @@ namespace eastl
 	}
 
 #if !defined(EA_COMPILER_HAS_THREE_WAY_COMPARISON)
-	template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator, bool bCacheHashCode>
-	inline bool operator!=(const hash_multimap<Key, T, Hash, Predicate, Allocator, bCacheHashCode>& a,
-						   const hash_multimap<Key, T, Hash, Predicate, Allocator, bCacheHashCode>& b)
+	template <typename Key, typename T, typename Hash, typename Predicate, typename Allocator, bool bCacheHashCode, typename RehashPolicy>
+	inline bool operator!=(const hash_multimap<Key, T, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>& a,
+						   const hash_multimap<Key, T, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>& b)
 	{
 		return !(a == b);
 	}
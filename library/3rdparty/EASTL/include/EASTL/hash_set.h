@@ -81,6 +81,11 @@ namespace eastl
 	/// is useful for cases whereby the calculation of the hash value for
 	/// a contained object is very expensive.
 	///
+	/// RehashPolicy
+	/// Chooses bucket counts and when to grow, its nested range_hashing type
+	/// maps a hash code to a bucket. Default is prime_rehash_policy with
+	/// mod_range_hashing.
+	///
 	/// find_as
 	/// In order to support the ability to have a hashtable of strings but
 	/// be able to do efficiently lookups via char pointers (i.e. so they 
@@ -97,17 +102,17 @@ namespace eastl
 	///     i = hashSet.find_as("hello", hash<char*>(), equal_to_2<string, char*>());
 	///
 	template <typename Value, typename Hash = eastl::hash<Value>, typename Predicate = eastl::equal_to<Value>, 
-			  typename Allocator = EASTLAllocatorType, bool bCacheHashCode = false>
+			  typename Allocator = EASTLAllocatorType, bool bCacheHashCode = false, typename RehashPolicy = prime_rehash_policy>
 	class hash_set
 		: public hashtable<Value, Value, Allocator, eastl::use_self<Value>, Predicate,
-						   Hash, mod_range_hashing, default_ranged_hash, 
-						   prime_rehash_policy, bCacheHashCode, false, true>
+						   Hash, typename RehashPolicy::range_hashing, default_ranged_hash, 
+						   RehashPolicy, bCacheHashCode, false, true>
 	{
 	public:
 		typedef hashtable<Value, Value, Allocator, eastl::use_self<Value>, Predicate, 
-						  Hash, mod_range_hashing, default_ranged_hash,
-						  prime_rehash_policy, bCacheHashCode, false, true>       base_type;
-		typedef hash_set<Value, Hash, Predicate, Allocator, bCacheHashCode>       this_type;
+						  Hash, typename RehashPolicy::range_hashing, default_ranged_hash,
+						  RehashPolicy, bCacheHashCode, false, true>       base_type;
+		typedef hash_set<Value, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>       this_type;
 		typedef typename base_type::size_type                                     size_type;
 		typedef typename base_type::value_type                                    value_type;
 		typedef typename base_type::allocator_type                                allocator_type;
@@ -130,7 +135,7 @@ namespace eastl
 		/// Constructor which creates an empty container with allocator.
 		///
 		explicit hash_set(const allocator_type& allocator)
-			: base_type(0, Hash(), mod_range_hashing(), default_ranged_hash(), Predicate(), eastl::use_self<Value>(), allocator)
+			: base_type(0, Hash(), typename RehashPolicy::range_hashing(), default_ranged_hash(), Predicate(), eastl::use_self<Value>(), allocator)
 		{
 			// Empty
 		}
@@ -144,7 +149,7 @@ namespace eastl
 		///
 		explicit hash_set(size_type nBucketCount, const Hash& hashFunction = Hash(), const Predicate& predicate = Predicate(), 
 						  const allocator_type& allocator = EASTL_HASH_SET_DEFAULT_ALLOCATOR)
-			: base_type(nBucketCount, hashFunction, mod_range_hashing(), default_ranged_hash(), predicate, eastl::use_self<Value>(), allocator)
+			: base_type(nBucketCount, hashFunction, typename RehashPolicy::range_hashing(), default_ranged_hash(), predicate, eastl::use_self<Value>(), allocator)
 		{
 			// Empty
 		}
@@ -175,7 +180,7 @@ namespace eastl
 		///     
 		hash_set(std::initializer_list<value_type> ilist, size_type nBucketCount = 0, const Hash& hashFunction = Hash(), 
 				   const Predicate& predicate = Predicate(), const allocator_type& allocator = EASTL_HASH_SET_DEFAULT_ALLOCATOR)
-			: base_type(ilist.begin(), ilist.end(), nBucketCount, hashFunction, mod_range_hashing(), default_ranged_hash(), predicate, eastl::use_self<Value>(), allocator)
+			: base_type(ilist.begin(), ilist.end(), nBucketCount, hashFunction, typename RehashPolicy::range_hashing(), default_ranged_hash(), predicate, eastl::use_self<Value>(), allocator)
 		{
 			// Empty
 		}
@@ -189,7 +194,7 @@ namespace eastl
 		template <typename FowardIterator>
 		hash_set(FowardIterator first, FowardIterator last, size_type nBucketCount = 0, const Hash& hashFunction = Hash(), 
 				 const Predicate& predicate = Predicate(), const allocator_type& allocator = EASTL_HASH_SET_DEFAULT_ALLOCATOR)
-			: base_type(first, last, nBucketCount, hashFunction, mod_range_hashing(), default_ranged_hash(), predicate, eastl::use_self<Value>(), allocator)
+			: base_type(first, last, nBucketCount, hashFunction, typename RehashPolicy::range_hashing(), default_ranged_hash(), predicate, eastl::use_self<Value>(), allocator)
 		{
 			// Empty
 		}
@@ -217,8 +222,8 @@ namespace eastl
 	/// hash_set erase_if
 	///
 	/// https://en.cppreference.com/w/cpp/container/unordered_set/erase_if
-	template <typename Value, typename Hash, typename Predicate, typename Allocator, bool bCacheHashCode, typename UserPredicate>
-	typename eastl::hash_set<Value, Hash, Predicate, Allocator, bCacheHashCode>::size_type erase_if(eastl::hash_set<Value, Hash, Predicate, Allocator, bCacheHashCode>& c, UserPredicate predicate)
+	template <typename Value, typename Hash, typename Predicate, typename Allocator, bool bCacheHashCode, typename RehashPolicy, typename UserPredicate>
+	typename eastl::hash_set<Value, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>::size_type erase_if(eastl::hash_set<Value, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>& c, UserPredicate predicate)
 	{
 		auto oldSize = c.size();
 		// Erases all elements that satisfy the predicate pred from the container.
@@ -244,17 +249,17 @@ namespace eastl
 	/// for hash_set for details.
 	///
 	template <typename Value, typename Hash = eastl::hash<Value>, typename Predicate = eastl::equal_to<Value>, 
-			  typename Allocator = EASTLAllocatorType, bool bCacheHashCode = false>
+			  typename Allocator = EASTLAllocatorType, bool bCacheHashCode = false, typename RehashPolicy = prime_rehash_policy>
 	class hash_multiset
 		: public hashtable<Value, Value, Allocator, eastl::use_self<Value>, Predicate,
-						   Hash, mod_range_hashing, default_ranged_hash,
-						   prime_rehash_policy, bCacheHashCode, false, false>
+						   Hash, typename RehashPolicy::range_hashing, default_ranged_hash,
+						   RehashPolicy, bCacheHashCode, false, false>
 	{
 	public:
 		typedef hashtable<Value, Value, Allocator, eastl::use_self<Value>, Predicate,
-						  Hash, mod_range_hashing, default_ranged_hash,
-						  prime_rehash_policy, bCacheHashCode, false, false>          base_type;
-		typedef hash_multiset<Value, Hash, Predicate, Allocator, bCacheHashCode>      this_type;
+						  Hash, typename RehashPolicy::range_hashing, default_ranged_hash,
+						  RehashPolicy, bCacheHashCode, false, false>          base_type;
+		typedef hash_multiset<Value, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>      this_type;
 		typedef typename base_type::size_type                                         size_type;
 		typedef typename base_type::value_type                                        value_type;
 		typedef typename base_type::allocator_type                                    allocator_type;
@@ -266,7 +271,7 @@ namespace eastl
 		/// Default constructor.
 		/// 
 		explicit hash_multiset(const allocator_type& allocator = EASTL_HASH_MULTISET_DEFAULT_ALLOCATOR)
-			: base_type(0, Hash(), mod_range_hashing(), default_ranged_hash(), Predicate(), eastl::use_self<Value>(), allocator)
+			: base_type(0, Hash(), typename RehashPolicy::range_hashing(), default_ranged_hash(), Predicate(), eastl::use_self<Value>(), allocator)
 		{
 			// Empty
 		}
@@ -280,7 +285,7 @@ namespace eastl
 		///
 		explicit hash_multiset(size_type nBucketCount, const Hash& hashFunction = Hash(), 
 							   const Predicate& predicate = Predicate(), const allocator_type& allocator = EASTL_HASH_MULTISET_DEFAULT_ALLOCATOR)
-			: base_type(nBucketCount, hashFunction, mod_range_hashing(), default_ranged_hash(), predicate, eastl::use_self<Value>(), allocator)
+			: base_type(nBucketCount, hashFunction, typename RehashPolicy::range_hashing(), default_ranged_hash(), predicate, eastl::use_self<Value>(), allocator)
 		{
 			// Empty
 		}
@@ -311,7 +316,7 @@ namespace eastl
 		///     
 		hash_multiset(std::initializer_list<value_type> ilist, size_type nBucketCount = 0, const Hash& hashFunction = Hash(), 
 				   const Predicate& predicate = Predicate(), const allocator_type& allocator = EASTL_HASH_MULTISET_DEFAULT_ALLOCATOR)
-			: base_type(ilist.begin(), ilist.end(), nBucketCount, hashFunction, mod_range_hashing(), default_ranged_hash(), predicate, eastl::use_self<Value>(), allocator)
+			: base_type(ilist.begin(), ilist.end(), nBucketCount, hashFunction, typename RehashPolicy::range_hashing(), default_ranged_hash(), predicate, eastl::use_self<Value>(), allocator)
 		{
 			// Empty
 		}
@@ -325,7 +330,7 @@ namespace eastl
 		template <typename FowardIterator>
 		hash_multiset(FowardIterator first, FowardIterator last, size_type nBucketCount = 0, const Hash& hashFunction = Hash(), 
 					  const Predicate& predicate = Predicate(), const allocator_type& allocator = EASTL_HASH_MULTISET_DEFAULT_ALLOCATOR)
-			: base_type(first, last, nBucketCount, hashFunction, mod_range_hashing(), default_ranged_hash(), predicate, eastl::use_self<Value>(), allocator)
+			: base_type(first, last, nBucketCount, hashFunction, typename RehashPolicy::range_hashing(), default_ranged_hash(), predicate, eastl::use_self<Value>(), allocator)
 		{
 			// Empty
 		}
@@ -353,8 +358,8 @@ namespace eastl
 	/// hash_multiset erase_if
 	///
 	/// https://en.cppreference.com/w/cpp/container/unordered_multiset/erase_if
-	template <typename Value, typename Hash, typename Predicate, typename Allocator, bool bCacheHashCode, typename UserPredicate>
-	typename eastl::hash_multiset<Value, Hash, Predicate, Allocator, bCacheHashCode>::size_type erase_if(eastl::hash_multiset<Value, Hash, Predicate, Allocator, bCacheHashCode>& c, UserPredicate predicate)
+	template <typename Value, typename Hash, typename Predicate, typename Allocator, bool bCacheHashCode, typename RehashPolicy, typename UserPredicate>
+	typename eastl::hash_multiset<Value, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>::size_type erase_if(eastl::hash_multiset<Value, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>& c, UserPredicate predicate)
 	{
 		auto oldSize = c.size();
 		// Erases all elements that satisfy the predicate pred from the container.
@@ -378,11 +383,11 @@ namespace eastl
 	// global operators
 	///////////////////////////////////////////////////////////////////////
 
-	template <typename Value, typename Hash, typename Predicate, typename Allocator, bool bCacheHashCode>
-	inline bool operator==(const hash_set<Value, Hash, Predicate, Allocator, bCacheHashCode>& a, 
-						   const hash_set<Value, Hash, Predicate, Allocator, bCacheHashCode>& b)
+	template <typename Value, typename Hash, typename Predicate, typename Allocator, bool bCacheHashCode, typename RehashPolicy>
+	inline bool operator==(const hash_set<Value, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>& a, 
+						   const hash_set<Value, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>& b)
 	{
-		typedef typename hash_set<Value, Hash, Predicate, Allocator, bCacheHashCode>::const_iterator const_iterator;
+		typedef typename hash_set<Value, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>::const_iterator const_iterator;
 
 		// We implement branching with the assumption that the return value is usually false.
 		if(a.size() != b.size())
@@ -402,19 +407,19 @@ namespace eastl
 	}
 
 #if !defined(EA_COMPILER_HAS_THREE_WAY_COMPARISON)
-	template <typename Value, typename Hash, typename Predicate, typename Allocator, bool bCacheHashCode>
-	inline bool operator!=(const hash_set<Value, Hash, Predicate, Allocator, bCacheHashCode>& a, 
-						   const hash_set<Value, Hash, Predicate, Allocator, bCacheHashCode>& b)
+	template <typename Value, typename Hash, typename Predicate, typename Allocator, bool bCacheHashCode, typename RehashPolicy>
+	inline bool operator!=(const hash_set<Value, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>& a, 
+						   const hash_set<Value, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>& b)
 	{
 		return !(a == b);
 	}
 #endif
 
-	template <typename Value, typename Hash, typename Predicate, typename Allocator, bool bCacheHashCode>
-	inline bool operator==(const hash_multiset<Value, Hash, Predicate, Allocator, bCacheHashCode>& a, 
-						   const hash_multiset<Value, Hash, Predicate, Allocator, bCacheHashCode>& b)
+	template <typename Value, typename Hash, typename Predicate, typename Allocator, bool bCacheHashCode, typename RehashPolicy>
+	inline bool operator==(const hash_multiset<Value, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>& a, 
+						   const hash_multiset<Value, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>& b)
 	{
-		typedef typename hash_multiset<Value, Hash, Predicate, Allocator, bCacheHashCode>::const_iterator const_iterator;
+		typedef typename hash_multiset<Value, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>::const_iterator const_iterator;
 		typedef typename eastl::iterator_traits<const_iterator>::difference_type difference_type;
 
 		// We implement branching with the assumption that the return value is usually false.
@@ -460,9 +465,9 @@ namespace eastl
 	}
 
 #if !defined(EA_COMPILER_HAS_THREE_WAY_COMPARISON)
-	template <typename Value, typename Hash, typename Predicate, typename Allocator, bool bCacheHashCode>
-	inline bool operator!=(const hash_multiset<Value, Hash, Predicate, Allocator, bCacheHashCode>& a, 
-						   const hash_multiset<Value, Hash, Predicate, Allocator, bCacheHashCode>& b)
+	template <typename Value, typename Hash, typename Predicate, typename Allocator, bool bCacheHashCode, typename RehashPolicy>
+	inline bool operator!=(const hash_multiset<Value, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>& a, 
+						   const hash_multiset<Value, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>& b)
 	{
 		return !(a == b);
 	}
@@ -443,6 +443,8 @@ namespace eastl
 	struct EASTL_API prime_rehash_policy
 	{
 	public:
+		typedef mod_range_hashing range_hashing;  // How hash_map and hash_set map a hash code to a bucket.
+
 		float            mfMaxLoadFactor;
 		float            mfGrowthFactor;
 		mutable uint32_t mnNextResize;
@@ -965,13 +967,13 @@ namespace eastl
 			{ return begin(); }
 
 		iterator end() EA_NOEXCEPT
-			{ return iterator(mpBucketArray + mnBucketCount); }
+			{ return iterator(DoGetSentinel(), mpBucketArray + mnBucketCount); }
 
 		const_iterator end() const EA_NOEXCEPT
-			{ return const_iterator(mpBucketArray + mnBucketCount); }
+			{ return const_iterator(DoGetSentinel(), mpBucketArray + mnBucketCount); }
 
 		const_iterator cend() const EA_NOEXCEPT
-			{ return const_iterator(mpBucketArray + mnBucketCount); }
+			{ return const_iterator(DoGetSentinel(), mpBucketArray + mnBucketCount); }
 
 		// Returns an iterator to the first item in bucket n.
 		local_iterator begin(size_type n) EA_NOEXCEPT
@@ -1149,7 +1151,7 @@ namespace eastl
 			node_pointer const pNode = DoFindNode(mpBucketArray[n], c);
 
 			return pNode ? iterator(pNode, mpBucketArray + n) :
-						   iterator(mpBucketArray + mnBucketCount); // iterator(mpBucketArray + mnBucketCount) == end()
+						   iterator(DoGetSentinel(), mpBucketArray + mnBucketCount); // iterator(mpBucketArray + mnBucketCount) == end()
 		}
 
 		template<typename HashCodeT>
@@ -1166,7 +1168,7 @@ namespace eastl
 
 			return pNode ?
 					   const_iterator(pNode, mpBucketArray + n) :
-					   const_iterator(mpBucketArray + mnBucketCount); // iterator(mpBucketArray + mnBucketCount) == end()
+					   const_iterator(DoGetSentinel(), mpBucketArray + mnBucketCount); // iterator(mpBucketArray + mnBucketCount) == end()
 		}
 
 		iterator find_by_hash(const key_type& k, hash_code_t c)
@@ -1174,7 +1176,7 @@ namespace eastl
 			const size_type n = (size_type)bucket_index(c, (uint32_t)mnBucketCount);
 
 			node_pointer const pNode = DoFindNode(mpBucketArray[n], k, c);
-			return pNode ? iterator(pNode, mpBucketArray + n) : iterator(mpBucketArray + mnBucketCount); // iterator(mpBucketArray + mnBucketCount) == end()
+			return pNode ? iterator(pNode, mpBucketArray + n) : iterator(DoGetSentinel(), mpBucketArray + mnBucketCount); // iterator(mpBucketArray + mnBucketCount) == end()
 		}
 
 		const_iterator find_by_hash(const key_type& k, hash_code_t c) const
@@ -1182,7 +1184,7 @@ namespace eastl
 			const size_type n = (size_type)bucket_index(c, (uint32_t)mnBucketCount);
 
 			node_pointer const pNode = DoFindNode(mpBucketArray[n], k, c);
-			return pNode ? const_iterator(pNode, mpBucketArray + n) : const_iterator(mpBucketArray + mnBucketCount); // iterator(mpBucketArray + mnBucketCount) == end()
+			return pNode ? const_iterator(pNode, mpBucketArray + n) : const_iterator(DoGetSentinel(), mpBucketArray + mnBucketCount); // iterator(mpBucketArray + mnBucketCount) == end()
 		}
 
 		// Returns a pair that allows iterating over all nodes in a hash bucket
@@ -1229,6 +1231,11 @@ namespace eastl
 		void        DoFreeNode(node_pointer pNode);
 		void        DoFreeNodes(bucket_array_type pBucketArray, size_type);
 
+		// The extra bucket past the end always holds the sentinel, so end() can use it
+		// as a constant instead of loading it, and then 'it != end()' proves 'it' is not the sentinel.
+		static node_pointer DoGetSentinel() EA_NOEXCEPT
+			{ return allocator_type::template get_hashtable_sentinel<node_type>(); }
+
 		bucket_array_type DoAllocateBuckets(size_type n);
 		void        DoFreeBuckets(bucket_array_type pBucketArray, size_type n);
 
@@ -1773,7 +1780,7 @@ namespace eastl
 		const size_type   n = (size_type)bucket_index(k, c, (uint32_t)mnBucketCount);
 
 		node_pointer const pNode = DoFindNode(mpBucketArray[n], k, c);
-		return pNode ? iterator(pNode, mpBucketArray + n) : iterator(mpBucketArray + mnBucketCount); // iterator(mpBucketArray + mnBucketCount) == end()
+		return pNode ? iterator(pNode, mpBucketArray + n) : iterator(DoGetSentinel(), mpBucketArray + mnBucketCount); // iterator(mpBucketArray + mnBucketCount) == end()
 	}
 
 
@@ -1787,7 +1794,7 @@ namespace eastl
 		const size_type   n = (size_type)bucket_index(k, c, (uint32_t)mnBucketCount);
 
 		node_pointer const pNode = DoFindNode(mpBucketArray[n], k, c);
-		return pNode ? const_iterator(pNode, mpBucketArray + n) : const_iterator(mpBucketArray + mnBucketCount); // iterator(mpBucketArray + mnBucketCount) == end()
+		return pNode ? const_iterator(pNode, mpBucketArray + n) : const_iterator(DoGetSentinel(), mpBucketArray + mnBucketCount); // iterator(mpBucketArray + mnBucketCount) == end()
 	}
 
 
@@ -1802,7 +1809,7 @@ namespace eastl
 		const size_type   n = (size_type)(c % mnBucketCount); // This assumes we are using the mod range policy.
 
 		node_pointer const pNode = DoFindNodeT(mpBucketArray[n], other, predicate);
-		return pNode ? iterator(pNode, mpBucketArray + n) : iterator(mpBucketArray + mnBucketCount); // iterator(mpBucketArray + mnBucketCount) == end()
+		return pNode ? iterator(pNode, mpBucketArray + n) : iterator(DoGetSentinel(), mpBucketArray + mnBucketCount); // iterator(mpBucketArray + mnBucketCount) == end()
 	}
 
 
@@ -1817,7 +1824,7 @@ namespace eastl
 		const size_type   n = (size_type)(c % mnBucketCount); // This assumes we are using the mod range policy.
 
 		node_pointer const pNode = DoFindNodeT(mpBucketArray[n], other, predicate);
-		return pNode ? const_iterator(pNode, mpBucketArray + n) : const_iterator(mpBucketArray + mnBucketCount); // iterator(mpBucketArray + mnBucketCount) == end()
+		return pNode ? const_iterator(pNode, mpBucketArray + n) : const_iterator(DoGetSentinel(), mpBucketArray + mnBucketCount); // iterator(mpBucketArray + mnBucketCount) == end()
 	}
 
 
@@ -1885,8 +1892,8 @@ namespace eastl
 			return pair;
 		}
 
-		return eastl::pair<const_iterator, const_iterator>(const_iterator(mpBucketArray + mnBucketCount),
-														   const_iterator(mpBucketArray + mnBucketCount));
+		return eastl::pair<const_iterator, const_iterator>(const_iterator(DoGetSentinel(), mpBucketArray + mnBucketCount),
+														   const_iterator(DoGetSentinel(), mpBucketArray + mnBucketCount));
 	}
 
 
@@ -1909,8 +1916,8 @@ namespace eastl
 
 		}
 
-		return eastl::pair<iterator, iterator>(iterator(mpBucketArray + mnBucketCount),
-											   iterator(mpBucketArray + mnBucketCount));
+		return eastl::pair<iterator, iterator>(iterator(DoGetSentinel(), mpBucketArray + mnBucketCount),
+											   iterator(DoGetSentinel(), mpBucketArray + mnBucketCount));
 	}
 
 
@@ -1966,8 +1973,8 @@ namespace eastl
 			return eastl::pair<iterator, iterator>(first, last);
 		}
 
-		return eastl::pair<iterator, iterator>(iterator(mpBucketArray + mnBucketCount),  // iterator(mpBucketArray + mnBucketCount) == end()
-											   iterator(mpBucketArray + mnBucketCount));
+		return eastl::pair<iterator, iterator>(iterator(DoGetSentinel(), mpBucketArray + mnBucketCount),  // iterator(mpBucketArray + mnBucketCount) == end()
+											   iterator(DoGetSentinel(), mpBucketArray + mnBucketCount));
 	}
 
 
@@ -2003,8 +2010,8 @@ namespace eastl
 			return eastl::pair<const_iterator, const_iterator>(first, last);
 		}
 
-		return eastl::pair<const_iterator, const_iterator>(const_iterator(mpBucketArray + mnBucketCount),  // iterator(mpBucketArray + mnBucketCount) == end()
-														   const_iterator(mpBucketArray + mnBucketCount));
+		return eastl::pair<const_iterator, const_iterator>(const_iterator(DoGetSentinel(), mpBucketArray + mnBucketCount),  // iterator(mpBucketArray + mnBucketCount) == end()
+														   const_iterator(DoGetSentinel(), mpBucketArray + mnBucketCount));
 	}
 
 
@@ -722,6 +722,26 @@ namespace eastl
     #endif
 
 
+	///////////////////////////////////////////////////////////////////////
+	// is_trivially_relocatable
+	//
+	// Not part of the C++ Standard. True when an object can be moved to a new
+	// address by copying its bytes, with the source then left as raw memory
+	// without running its destructor. Defaults to is_trivially_copyable.
+	// Types that are relocatable but not trivially copyable (i.e. owning
+	// pointers and containers that only point to their heap memory) can
+	// specialize it. See uninitialized_relocate_ptr and relocation_fixup.
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename T>
+	struct is_trivially_relocatable : public eastl::integral_constant<bool, eastl::is_trivially_copyable<T>::value> {};
+
+	#if EASTL_VARIABLE_TEMPLATES_ENABLED
+		template <class T>
+		EA_CONSTEXPR bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+	#endif
+
+
 	///////////////////////////////////////////////////////////////////////
 	// is_constructible
 	//
@@ -35,6 +35,7 @@
 //    uninitialized_copy_ptr            - Extention to standard functionality.
 //    uninitialized_move_ptr            - Extention to standard functionality.
 //    uninitialized_move_ptr_if_noexcept- Extention to standard functionality.
+//    uninitialized_relocate_ptr        - Extention to standard functionality.
 //    uninitialized_fill_ptr            - Extention to standard functionality.
 //    uninitialized_fill_n_ptr          - Extention to standard functionality.
 //    uninitialized_copy_fill           - Extention to standard functionality.
@@ -794,6 +795,40 @@ namespace eastl
 	}
 
 
+	/// relocation_fixup
+	///
+	/// Extension point for trivially relocatable types that still have something bound to
+	/// their own address. relocated is called once on the whole range just relocated by
+	/// uninitialized_relocate_ptr, while the destination memory is already in place.
+	///
+	template <typename T>
+	struct relocation_fixup
+	{
+		static void relocated(T*, size_t) EA_NOEXCEPT {}
+	};
+
+
+	/// uninitialized_relocate_ptr
+	///
+	/// Moves [first, last) to the uninitialized memory at dest and leaves the source as
+	/// raw memory, without calling any constructor or destructor. T must be
+	/// is_trivially_relocatable, so this never throws. Ranges must not overlap.
+	///
+	template <typename T>
+	inline T* uninitialized_relocate_ptr(T* first, T* last, T* dest) EA_NOEXCEPT
+	{
+		const size_t n = (size_t)(last - first);
+
+		if(n)
+		{
+			memcpy(static_cast<void*>(dest), static_cast<const void*>(first), n * sizeof(T));
+			relocation_fixup<T>::relocated(dest, n);
+		}
+
+		return dest + n;
+	}
+
+
 	/// uninitialized_move_n
 	///
 	/// Moves count elements from a range beginning at first to an uninitialized memory area 
@@ -761,7 +761,9 @@ namespace eastl
 	protected:
 		// Helper functions for initialization/insertion operations.
 		heap_array_type DoAllocate(size_type n);
+		heap_array_type DoAllocateAtLeast(size_type& nCapacity);
 		void        DoFree(heap_array_type p, size_type n);
+		void        DoGrowCapacity(size_type n);
 		size_type   GetNewCapacity(size_type currentCapacity);
 		size_type   GetNewCapacity(size_type currentCapacity, size_type minimumGrowSize);
 		void        AllocateSelf();
@@ -1705,7 +1707,7 @@ namespace eastl
 			const size_type nCapacity = capacity();
 
 			if((nSize + n) > nCapacity)
-				reserve(GetNewCapacity(nCapacity, (nSize + n) - nCapacity));
+				DoGrowCapacity(GetNewCapacity(nCapacity, (nSize + n) - nCapacity));
 
 			pointer pNewEnd = CharStringUninitializedFillN(internalLayout().EndPtr(), n, c);
 			*pNewEnd = 0;
@@ -1728,9 +1730,9 @@ namespace eastl
 
 			if(nNewSize > nCapacity)
 			{
-				const size_type nLength = GetNewCapacity(nCapacity, nNewSize - nCapacity);
+				size_type nLength = GetNewCapacity(nCapacity, nNewSize - nCapacity);
 
-				heap_array_type pNewBegin = DoAllocate(nLength + 1);
+				heap_array_type pNewBegin = DoAllocateAtLeast(nLength);
 
 				pointer pNewEnd = CharStringUninitializedCopy(internalLayout().BeginPtr(), internalLayout().EndPtr(), allocator_type::to_raw(pNewBegin));
 				pNewEnd         = CharStringUninitializedCopy(pBegin,  pEnd,  pNewEnd);
@@ -2199,9 +2201,9 @@ namespace eastl
 			{
 				const size_type nOldSize = internalLayout().GetSize();
 				const size_type nOldCap  = capacity();
-				const size_type nLength  = GetNewCapacity(nOldCap, (nOldSize + n) - nOldCap);
+				size_type       nLength  = GetNewCapacity(nOldCap, (nOldSize + n) - nOldCap);
 
-				heap_array_type pNewBegin = DoAllocate(nLength + 1);
+				heap_array_type pNewBegin = DoAllocateAtLeast(nLength);
 
 				iterator pNewEnd = CharStringUninitializedCopy(internalLayout().BeginPtr(), p, allocator_type::to_raw(pNewBegin));
 				pNewEnd          = CharStringUninitializedFillN(pNewEnd, n, c);
@@ -2309,7 +2311,7 @@ namespace eastl
 				else
 					nLength = GetNewCapacity(nOldCap, (nOldSize + n) - nOldCap);
 
-				heap_array_type pNewBegin = DoAllocate(nLength + 1);
+				heap_array_type pNewBegin = DoAllocateAtLeast(nLength);
 
 				pointer pNewEnd = CharStringUninitializedCopy(internalLayout().BeginPtr(), p, allocator_type::to_raw(pNewBegin));
 				pNewEnd         = CharStringUninitializedCopy(pBegin, pEnd, pNewEnd);
@@ -2586,9 +2588,9 @@ namespace eastl
 				// I can't think of any easy way of doing this without allocating temporary memory.
 				const size_type nOldSize     = internalLayout().GetSize();
 				const size_type nOldCap      = capacity();
-				const size_type nNewCapacity = GetNewCapacity(nOldCap, (nOldSize + (nLength2 - nLength1)) - nOldCap);
+				size_type       nNewCapacity = GetNewCapacity(nOldCap, (nOldSize + (nLength2 - nLength1)) - nOldCap);
 
-				heap_array_type pNewBegin = DoAllocate(nNewCapacity + 1);
+				heap_array_type pNewBegin = DoAllocateAtLeast(nNewCapacity);
 
 				pointer pNewEnd = CharStringUninitializedCopy(internalLayout().BeginPtr(), pBegin1, allocator_type::to_raw(pNewBegin));
 				pNewEnd         = CharStringUninitializedCopy(pBegin2, pEnd2,   pNewEnd);
@@ -3222,9 +3224,9 @@ namespace eastl
 		{
 			const size_type nOldSize = internalLayout().GetSize();
 			const size_type nOldCap  = capacity();
-			const size_type nLength = GetNewCapacity(nOldCap, 1);
+			size_type nLength = GetNewCapacity(nOldCap, 1);
 
-			heap_array_type pNewBegin = DoAllocate(nLength + 1);
+			heap_array_type pNewBegin = DoAllocateAtLeast(nLength);
 
 			pNewPosition = CharStringUninitializedCopy(internalLayout().BeginPtr(), p, allocator_type::to_raw(pNewBegin));
 		   *pNewPosition = c;
@@ -3290,6 +3292,19 @@ namespace eastl
 	}
 
 
+	// Used when growing, allocates room for at least nCapacity characters plus the trailing 0,
+	// and updates nCapacity with whatever extra room the allocation has.
+	template <typename T, typename Allocator>
+	inline typename basic_string<T, Allocator>::heap_array_type
+	basic_string<T, Allocator>::DoAllocateAtLeast(size_type& nCapacity)
+	{
+		size_type n = nCapacity + 1;
+		heap_array_type p = get_allocator().template allocate_array_at_least<T>(n);
+		nCapacity = n - 1;
+		return p;
+	}
+
+
 	template <typename T, typename Allocator>
 	inline void basic_string<T, Allocator>::DoFree(heap_array_type p, size_type n)
 	{
@@ -3299,6 +3314,24 @@ namespace eastl
 	}
 
 
+	// Same as set_capacity(n) for n > capacity(), but keeps any extra room of the allocation.
+	template <typename T, typename Allocator>
+	void basic_string<T, Allocator>::DoGrowCapacity(size_type n)
+	{
+		heap_array_type pNewBegin = DoAllocateAtLeast(n);
+		const size_type nSavedSize = internalLayout().GetSize(); // save the size in case we transition from sso->heap
+
+		pointer pNewEnd = CharStringUninitializedCopy(internalLayout().BeginPtr(), internalLayout().EndPtr(), allocator_type::to_raw(pNewBegin));
+		*pNewEnd = 0;
+
+		DeallocateSelf();
+
+		internalLayout().SetHeapBeginPtr(pNewBegin);
+		internalLayout().SetHeapCapacity(n);
+		internalLayout().SetHeapSize(nSavedSize);
+	}
+
+
 	template <typename T, typename Allocator>
 	inline typename basic_string<T, Allocator>::size_type
 	basic_string<T, Allocator>::GetNewCapacity(size_type currentCapacity)
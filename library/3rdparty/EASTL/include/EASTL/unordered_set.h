@@ -29,8 +29,9 @@ namespace eastl
 				  typename Hash = eastl::hash<Value>,
 				  typename Predicate = eastl::equal_to<Value>,
 				  typename Allocator = EASTLAllocatorType,
-				  bool bCacheHashCode = false>
-		using unordered_set = hash_set<Value, Hash, Predicate, Allocator, bCacheHashCode>;
+				  bool bCacheHashCode = false,
+				  typename RehashPolicy = prime_rehash_policy>
+		using unordered_set = hash_set<Value, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>;
 	#endif
 
     /// unordered_multiset 
@@ -43,8 +44,9 @@ namespace eastl
 				  typename Hash = eastl::hash<Value>,
 				  typename Predicate = eastl::equal_to<Value>,
 				  typename Allocator = EASTLAllocatorType,
-				  bool bCacheHashCode = false>
-		using unordered_multiset = hash_multiset<Value, Hash, Predicate, Allocator, bCacheHashCode>;
+				  bool bCacheHashCode = false,
+				  typename RehashPolicy = prime_rehash_policy>
+		using unordered_multiset = hash_multiset<Value, Hash, Predicate, Allocator, bCacheHashCode, RehashPolicy>;
 	#endif
 
 } // namespace eastl
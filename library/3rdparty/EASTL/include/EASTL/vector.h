@@ -162,6 +162,7 @@ namespace eastl
 
 	protected:
 		array_type DoAllocate(size_type n);
+		array_type DoAllocateAtLeast(size_type& n);
 		void      DoFree(array_type p, size_type n);
 		size_type GetNewCapacity(size_type currentCapacity);
 
@@ -201,6 +202,7 @@ namespace eastl
 		using base_type::npos;
 		using base_type::GetNewCapacity;
 		using base_type::DoAllocate;
+		using base_type::DoAllocateAtLeast;
 		using base_type::DoFree;
 		using base_type::internalCapacityPtr;
 		using base_type::internalAllocator;
@@ -381,7 +383,9 @@ namespace eastl
 
 		void DoClearCapacity();
 
-		void DoGrow(size_type n);
+		void DoGrow(size_type n, bool bAtLeast = false); // bAtLeast adopts any extra room of the allocation, only used when growing geometrically.
+
+		pointer DoRelocate(array_type pNewData); // Only for is_trivially_relocatable value_type. Relocates all elements to pNewData and frees the old storage.
 
 		void DoSwap(this_type& x);
 
@@ -485,6 +489,31 @@ namespace eastl
 	}
 
 
+	// Used when growing geometrically, n is updated to the capacity actually allocated,
+	// so the slack at the end of the allocator bucket becomes usable capacity.
+	// When the caller asked for an explicit size (i.e. resize or insert of n elements beyond
+	// the geometric growth) we still allocate exactly, as users expect capacity() == size() there.
+	template <typename T, typename Allocator>
+	inline typename VectorBase<T, Allocator>::array_type VectorBase<T, Allocator>::DoAllocateAtLeast(size_type& n)
+	{
+		#if EASTL_ASSERT_ENABLED
+			if(EASTL_UNLIKELY(n >= 0x80000000))
+				EASTL_FAIL_MSG("vector::DoAllocateAtLeast -- improbably large request.");
+		#endif
+
+		if(EASTL_LIKELY(n))
+		{
+			auto p = internalAllocator().template allocate_array_at_least<T>(n);
+			EASTL_ASSERT_MSG(p != nullptr, "the behaviour of eastl::allocators that return nullptr is not defined.");
+			return p;
+		}
+		else
+		{
+			return nullptr;
+		}
+	}
+
+
 	template <typename T, typename Allocator>
 	inline void VectorBase<T, Allocator>::DoFree(array_type p, size_type n)
 	{
@@ -1080,7 +1109,7 @@ namespace eastl
 		{
 			const size_type nPrevSize = size_type(mpEnd - mpBegin);
 			const size_type nNewSize  = GetNewCapacity(nPrevSize);
-			DoGrow(nNewSize);
+			DoGrow(nNewSize, true);
 		}
  
 		return mpEnd++;
@@ -1640,8 +1669,8 @@ namespace eastl
 			{
 				const size_type nPrevSize = size_type(mpEnd - mpBegin);
 				const size_type nGrowSize = GetNewCapacity(nPrevSize);
-				const size_type nNewSize  = nGrowSize > (nPrevSize + n) ? nGrowSize : (nPrevSize + n);
-				auto            pNewData  = DoAllocate(nNewSize);
+				size_type       nNewSize  = nGrowSize > (nPrevSize + n) ? nGrowSize : (nPrevSize + n);
+				auto            pNewData  = nGrowSize > (nPrevSize + n) ? DoAllocateAtLeast(nNewSize) : DoAllocate(nNewSize);
 				auto raii = allocator_type::make_raii(pNewData);
 
 				#if EASTL_EXCEPTIONS_ENABLED
@@ -1716,8 +1745,8 @@ namespace eastl
 		{
 			const size_type nPrevSize = size_type(mpEnd - mpBegin);
 			const size_type nGrowSize = GetNewCapacity(nPrevSize);
-			const size_type nNewSize  = nGrowSize > (nPrevSize + n) ? nGrowSize : (nPrevSize + n);
-			auto            pNewData  = DoAllocate(nNewSize);
+			size_type       nNewSize  = nGrowSize > (nPrevSize + n) ? nGrowSize : (nPrevSize + n);
+			auto            pNewData  = nGrowSize > (nPrevSize + n) ? DoAllocateAtLeast(nNewSize) : DoAllocate(nNewSize);
 			auto raii = allocator_type::make_raii(pNewData);
 
 			#if EASTL_EXCEPTIONS_ENABLED
@@ -1760,15 +1789,22 @@ namespace eastl
 
 
 	template <typename T, typename Allocator>
-	void vector<T, Allocator>::DoGrow(size_type n)
+	void vector<T, Allocator>::DoGrow(size_type n, bool bAtLeast)
 	{
-		auto pNewData = DoAllocate(n);
+		auto pNewData = bAtLeast ? DoAllocateAtLeast(n) : DoAllocate(n);
 		auto raii = allocator_type::make_raii(pNewData);
 
-		pointer pNewEnd = eastl::uninitialized_move_ptr_if_noexcept(allocator_type::to_raw(mpBegin), mpEnd, allocator_type::to_raw(pNewData));
+		pointer pNewEnd;
 
-		eastl::destruct(allocator_type::to_raw(mpBegin), mpEnd);
-		DoFree(mpBegin, (size_type)(internalCapacityPtr() - mpBegin));
+		EA_CONSTEXPR_IF(eastl::is_trivially_relocatable<value_type>::value)
+			pNewEnd = DoRelocate(pNewData);
+		else
+		{
+			pNewEnd = eastl::uninitialized_move_ptr_if_noexcept(allocator_type::to_raw(mpBegin), mpEnd, allocator_type::to_raw(pNewData));
+
+			eastl::destruct(allocator_type::to_raw(mpBegin), mpEnd);
+			DoFree(mpBegin, (size_type)(internalCapacityPtr() - mpBegin));
+		}
 
 		mpBegin    = pNewData;
 		mpEnd      = pNewEnd;
@@ -1776,6 +1812,19 @@ namespace eastl
 	}
 
 
+	template <typename T, typename Allocator>
+	inline typename vector<T, Allocator>::pointer vector<T, Allocator>::DoRelocate(array_type pNewData)
+	{
+		// No move constructors and no destructors, elements are copied bitwise and the old
+		// storage is released as raw memory. Whatever is bound to the address of an element
+		// is fixed up once for the whole range by relocation_fixup.
+		pointer pNewEnd = eastl::uninitialized_relocate_ptr(allocator_type::to_raw(mpBegin), mpEnd, allocator_type::to_raw(pNewData));
+		DoFree(mpBegin, (size_type)(internalCapacityPtr() - mpBegin));
+
+		return pNewEnd;
+	}
+
+
 	template <typename T, typename Allocator>
 	inline void vector<T, Allocator>::DoSwap(this_type& x)
 	{
@@ -1793,10 +1842,32 @@ namespace eastl
 		{
 			const size_type nPrevSize = size_type(mpEnd - mpBegin);
 			const size_type nGrowSize = GetNewCapacity(nPrevSize);
-			const size_type nNewSize = eastl::max(nGrowSize, nPrevSize + n);
-			auto            pNewData = DoAllocate(nNewSize);
+			size_type       nNewSize = eastl::max(nGrowSize, nPrevSize + n);
+			auto            pNewData = nGrowSize > (nPrevSize + n) ? DoAllocateAtLeast(nNewSize) : DoAllocate(nNewSize);
 			auto raii = allocator_type::make_raii(pNewData);
 
+			EA_CONSTEXPR_IF(eastl::is_trivially_relocatable<value_type>::value)
+			{
+				// Fill before relocating, value may be an element of the old storage.
+				#if EASTL_EXCEPTIONS_ENABLED
+					try { eastl::uninitialized_fill_n_ptr(allocator_type::to_raw(pNewData) + nPrevSize, n, value); }
+					catch(...)
+					{
+						DoFree(pNewData, nNewSize);
+						throw;
+					}
+				#else
+					eastl::uninitialized_fill_n_ptr(allocator_type::to_raw(pNewData) + nPrevSize, n, value);
+				#endif
+
+				pointer pNewEnd = DoRelocate(pNewData) + n;
+
+				mpBegin    = pNewData;
+				mpEnd      = pNewEnd;
+				internalCapacityPtr() = pNewData + nNewSize;
+				return;
+			}
+
 			#if EASTL_EXCEPTIONS_ENABLED
 				pointer pNewEnd = allocator_type::to_raw(pNewData); // Assign pNewEnd a value here in case the copy throws.
 				try
@@ -1838,10 +1909,31 @@ namespace eastl
 		{
 			const size_type nPrevSize = size_type(mpEnd - mpBegin);
 			const size_type nGrowSize = GetNewCapacity(nPrevSize);
-			const size_type nNewSize = eastl::max(nGrowSize, nPrevSize + n);
-			auto            pNewData = DoAllocate(nNewSize);
+			size_type       nNewSize = eastl::max(nGrowSize, nPrevSize + n);
+			auto            pNewData = nGrowSize > (nPrevSize + n) ? DoAllocateAtLeast(nNewSize) : DoAllocate(nNewSize);
 			auto raii = allocator_type::make_raii(pNewData);
 
+			EA_CONSTEXPR_IF(eastl::is_trivially_relocatable<value_type>::value)
+			{
+				#if EASTL_EXCEPTIONS_ENABLED
+					try { eastl::uninitialized_default_fill_n(allocator_type::to_raw(pNewData) + nPrevSize, n); }
+					catch (...)
+					{
+						DoFree(pNewData, nNewSize);
+						throw;
+					}
+				#else
+					eastl::uninitialized_default_fill_n(allocator_type::to_raw(pNewData) + nPrevSize, n);
+				#endif
+
+				pointer pNewEnd = DoRelocate(pNewData) + n;
+
+				mpBegin = pNewData;
+				mpEnd = pNewEnd;
+				internalCapacityPtr() = pNewData + nNewSize;
+				return;
+			}
+
 			#if EASTL_EXCEPTIONS_ENABLED
 				pointer pNewEnd = allocator_type::to_raw(pNewData);  // Assign pNewEnd a value here in case the copy throws.
 				try { pNewEnd = eastl::uninitialized_move_ptr_if_noexcept(allocator_type::to_raw(mpBegin), mpEnd, allocator_type::to_raw(pNewData)); }
@@ -1912,8 +2004,8 @@ namespace eastl
 		{
 			const size_type nPosSize  = size_type(destPosition - mpBegin); // Index of the insertion position.
 			const size_type nPrevSize = size_type(mpEnd - mpBegin);
-			const size_type nNewSize  = GetNewCapacity(nPrevSize);
-			auto            pNewData  = DoAllocate(nNewSize);
+			size_type       nNewSize  = GetNewCapacity(nPrevSize);
+			auto            pNewData  = DoAllocateAtLeast(nNewSize);
 			auto raii = allocator_type::make_raii(pNewData);
 
 			#if EASTL_EXCEPTIONS_ENABLED
@@ -1956,10 +2048,32 @@ namespace eastl
 	void vector<T, Allocator>::DoInsertValueEnd(Args&&... args)
 	{
 		const size_type nPrevSize = size_type(mpEnd - mpBegin);
-		const size_type nNewSize  = GetNewCapacity(nPrevSize);
-		auto            pNewData  = DoAllocate(nNewSize);
+		size_type       nNewSize  = GetNewCapacity(nPrevSize);
+		auto            pNewData  = DoAllocateAtLeast(nNewSize);
 		auto raii = allocator_type::make_raii(pNewData);
 
+		EA_CONSTEXPR_IF(eastl::is_trivially_relocatable<value_type>::value)
+		{
+			// Construct the new value first, args may refer to an element of the old storage.
+			#if EASTL_EXCEPTIONS_ENABLED
+				try { ::new((void*)(allocator_type::to_raw(pNewData) + nPrevSize)) value_type(eastl::forward<Args>(args)...); }
+				catch(...)
+				{
+					DoFree(pNewData, nNewSize);
+					throw;
+				}
+			#else
+				::new((void*)(allocator_type::to_raw(pNewData) + nPrevSize)) value_type(eastl::forward<Args>(args)...);
+			#endif
+
+			pointer pNewEnd = DoRelocate(pNewData) + 1;
+
+			mpBegin    = pNewData;
+			mpEnd      = pNewEnd;
+			internalCapacityPtr() = pNewData + nNewSize;
+			return;
+		}
+
 		#if EASTL_EXCEPTIONS_ENABLED
 			pointer pNewEnd = allocator_type::to_raw(pNewData); // Assign pNewEnd a value here in case the copy throws.
 			try
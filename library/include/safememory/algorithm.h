@@ -31,6 +31,7 @@
 
 #include <EASTL/internal/config.h>
 #include <EASTL/algorithm.h>
+#include <EASTL/sort.h>
 #include <safememory/detail/array_iterator.h>
 #include <safememory/detail/hashtable_iterator.h>
 
@@ -67,6 +68,128 @@ namespace safememory {
 		return detail::array_stack_only_iterator<T, is_const, ArrPtr, is_dezombiefy>::makeIt(first, r);
 	}
 
+	namespace detail {
+
+		constexpr std::ptrdiff_t kSortInsertionLimit = 16;
+
+		template <typename T, typename Compare>
+		void sort_insertion(T* first, T* last, Compare& compare) {
+			for(T* current = first + 1; current < last; ++current) {
+				T value(eastl::move(*current));
+				T* end = current;
+				for(; end != first && compare(value, *(end - 1)); --end)
+					*end = eastl::move(*(end - 1));
+				*end = eastl::move(value);
+			}
+		}
+
+		template <typename T, typename Compare>
+		T* sort_median(T* a, T* b, T* c, Compare& compare) {
+			if(compare(*a, *b)) {
+				if(compare(*b, *c))
+					return b;
+				return compare(*a, *c) ? c : a;
+			}
+			if(compare(*a, *c))
+				return a;
+			return compare(*b, *c) ? c : b;
+		}
+
+		// mb: pivot is kept at *first, out of the partitioned range, so it is never moved
+		template <typename T, typename Compare>
+		T* sort_partition(T* first, T* last, Compare& compare) {
+			const T& pivot = *first;
+			T* lo = first + 1;
+			T* hi = last;
+			for(;; ++lo) {
+				while(lo < hi && compare(*lo, pivot))
+					++lo;
+				--hi;
+				while(lo < hi && compare(pivot, *hi))
+					--hi;
+				if(lo >= hi)
+					return lo;
+				eastl::iter_swap(lo, hi);
+			}
+		}
+
+		template <typename T, typename Compare>
+		void sort_impl(T* first, T* last, std::ptrdiff_t depth, Compare& compare) {
+			while(last - first > kSortInsertionLimit) {
+				if(depth == 0) {
+					// heap sort is index based, bounded by construction
+					eastl::partial_sort(first, last, last, compare);
+					return;
+				}
+				--depth;
+				eastl::iter_swap(first, sort_median(first + 1, first + (last - first) / 2, last - 1, compare));
+				T* cut = sort_partition(first, last, compare);
+				sort_impl(cut, last, depth, compare);
+				last = cut;
+			}
+			sort_insertion(first, last, compare);
+		}
+
+		/**
+		 * \brief introsort over a raw range that stays inside the range for any \p compare.
+		 * 
+		 * \c eastl::sort skips bounds checks on the partition scan and the final insertion
+		 * sort, that is only correct for a strict weak ordering. A comparator like \c a<=b
+		 * runs past the range. Here every scan is bounded, so a bad comparator gives an
+		 * unspecified order, but never touches memory outside the range.
+		 */
+		template <typename T, typename Compare>
+		void sort_raw(T* first, T* last, Compare& compare) {
+			if(last - first > 1)
+				sort_impl(first, last, 2 * static_cast<std::ptrdiff_t>(eastl::Internal::Log2(last - first)), compare);
+		}
+	} // namespace detail
+
+	template <typename IT>
+	void sort(IT first, IT last) {
+		eastl::sort(first, last);
+	}
+
+	template <typename IT, typename Compare>
+	void sort(IT first, IT last, Compare compare) {
+		eastl::sort(first, last, compare);
+	}
+
+	/**
+	 * \brief sort over a \c array_heap_safe_iterator range.
+	 * 
+	 * \c eastl::sort copies iterators in its inner loop, and each copy of a \a heap_safe
+	 * iterator registers its \c soft_ptr at the \c ControlBlock.
+	 * We validate the range once and sort the raw pointers instead, while \p first keeps
+	 * the array alive. Sorting raw pointers drops the per access bounds checks, so it is
+	 * done by \c detail::sort_raw, that stays inside the range for any comparator.
+	 */
+	template <typename T, typename ArrPtr, bool is_dezombiefy>
+	void sort(const detail::array_heap_safe_iterator<T, false, ArrPtr, is_dezombiefy>& first, const detail::array_heap_safe_iterator<T, false, ArrPtr, is_dezombiefy>& last) {
+		auto p = first.toRawOther(last);
+		eastl::less<T> compare;
+		detail::sort_raw(p.first, p.second, compare);
+	}
+
+	template <typename T, typename ArrPtr, bool is_dezombiefy, typename Compare>
+	void sort(const detail::array_heap_safe_iterator<T, false, ArrPtr, is_dezombiefy>& first, const detail::array_heap_safe_iterator<T, false, ArrPtr, is_dezombiefy>& last, Compare compare) {
+		auto p = first.toRawOther(last);
+		detail::sort_raw(p.first, p.second, compare);
+	}
+
+	template <typename T, typename ArrPtr, bool is_dezombiefy>
+	void sort(const detail::array_stack_only_iterator<T, false, ArrPtr, is_dezombiefy>& first, const detail::array_stack_only_iterator<T, false, ArrPtr, is_dezombiefy>& last) {
+		auto p = first.toRawOther(last);
+		eastl::less<T> compare;
+		detail::sort_raw(p.first, p.second, compare);
+	}
+
+	template <typename T, typename ArrPtr, bool is_dezombiefy, typename Compare>
+	void sort(const detail::array_stack_only_iterator<T, false, ArrPtr, is_dezombiefy>& first, const detail::array_stack_only_iterator<T, false, ArrPtr, is_dezombiefy>& last, Compare compare) {
+		auto p = first.toRawOther(last);
+		detail::sort_raw(p.first, p.second, compare);
+	}
+
 	/**
 	 * \c hashtable_stack_only_iterator can't be optimized, since we can easily check
 	 * the iterator pair is a valid range.
@@ -438,11 +438,184 @@ public:
 }; // class array_safe
 
 
+/** 
+ * \brief A SafeMemory array usable in \c constexpr context.
+ * 
+ * Unlike \c array this is an aggregate, elements are a public member array, so
+ * it can be initialized at compile time and placed in read-only memory.
+ * The price is it has no \c soft_this_ptr2, so there are no \a heap_safe iterators,
+ * only \a stack_only ones (raw pointers when safety is \c none).
+ * Intended for \c static \c constexpr tables, that like \c basic_string_literal live
+ * forever.
+ * 
+ * Indexing is checked as in \c array, when evaluated at compile time an out of range
+ * index doesn't compile. \c get<I>() checks the index with a \c static_assert.
+  */ 
+
+template <typename T, eastl_size_t N = 1, memory_safety Safety = safeness_declarator<T>::is_safe>
+struct constexpr_array
+{
+public:
+	typedef constexpr_array<T, N, Safety>                 this_type;
+	typedef T                                             value_type;
+	typedef value_type&                                   reference;
+	typedef const value_type&                             const_reference;
+	typedef value_type*                                   pointer;
+	typedef const value_type*                             const_pointer;
+	typedef eastl_size_t                                  size_type;
+	typedef ptrdiff_t                                     difference_type;
+
+	typedef typename detail::array_stack_only_iterator<T, false, T*>                stack_only_iterator;
+	typedef typename detail::array_stack_only_iterator<T, true, T*>                 const_stack_only_iterator;
+
+	static constexpr bool use_base_iterator = Safety == memory_safety::none;
+	
+	typedef std::conditional_t<use_base_iterator, pointer, stack_only_iterator>               iterator;
+	typedef std::conditional_t<use_base_iterator, const_pointer, const_stack_only_iterator>   const_iterator;
+	typedef eastl::reverse_iterator<iterator>                                                 reverse_iterator;
+	typedef eastl::reverse_iterator<const_iterator>                                           const_reverse_iterator;
+
+	static_assert(N != 0, "Empty safememory::constexpr_array not supported yet!");
+
+public:
+	static constexpr memory_safety is_safe = Safety;
+
+	static constexpr size_type count = N;
+
+	// mb: public to allow aggregate initialization, don't use directly
+	value_type mValue[N];
+
+	constexpr bool empty() const noexcept { return N == 0; }
+	constexpr size_type size() const noexcept { return N; }
+	constexpr size_type max_size() const noexcept { return N; }
+
+	constexpr pointer       begin_unsafe() noexcept { return mValue; }
+	constexpr const_pointer begin_unsafe() const noexcept { return mValue; }
+	constexpr const_pointer cbegin_unsafe() const noexcept { return mValue; }
+
+	constexpr pointer       end_unsafe() noexcept { return mValue + N; }
+	constexpr const_pointer end_unsafe() const noexcept { return mValue + N; }
+	constexpr const_pointer cend_unsafe() const noexcept { return mValue + N; }
+
+	iterator       begin() noexcept { return makeIt(begin_unsafe()); }
+	const_iterator begin() const noexcept { return makeIt(begin_unsafe()); }
+	const_iterator cbegin() const noexcept { return makeIt(begin_unsafe()); }
+
+	iterator       end() noexcept { return makeIt(end_unsafe()); }
+	const_iterator end() const noexcept { return makeIt(end_unsafe()); }
+	const_iterator cend() const noexcept { return makeIt(end_unsafe()); }
+
+	reverse_iterator       rbegin() noexcept { return reverse_iterator(makeIt(end_unsafe())); }
+	const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(makeIt(end_unsafe())); }
+	const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(makeIt(end_unsafe())); }
+
+	reverse_iterator       rend() noexcept { return reverse_iterator(makeIt(begin_unsafe())); }
+	const_reverse_iterator rend() const noexcept { return const_reverse_iterator(makeIt(begin_unsafe())); }
+	const_reverse_iterator crend() const noexcept { return const_reverse_iterator(makeIt(begin_unsafe())); }
+
+	constexpr void fill(const value_type& value) {
+		for(size_type i = 0; i != N; ++i)
+			mValue[i] = value;
+	}
+
+	void swap(this_type& x) noexcept(eastl::is_nothrow_swappable<value_type>::value) {
+		eastl::swap_ranges(begin_unsafe(), end_unsafe(), x.begin_unsafe());
+	}
+
+	constexpr reference       operator[](size_type i) {
+		if constexpr(is_safe == memory_safety::safe) {
+			if(NODECPP_UNLIKELY(i >= N))
+				ThrowRangeException();
+		}
+
+		return mValue[i];
+	}
+	
+	constexpr const_reference operator[](size_type i) const {
+		if constexpr(is_safe == memory_safety::safe) {
+			if(NODECPP_UNLIKELY(i >= N))
+				ThrowRangeException();
+		}
+
+		return mValue[i];
+	}
+
+	constexpr const_reference at(size_type i) const {
+		// check regarless of safety
+		if(NODECPP_UNLIKELY(i >= N))
+			ThrowRangeException();
+
+		return mValue[i];
+	}
+
+	constexpr reference       at(size_type i) {
+		// check regarless of safety
+		if(NODECPP_UNLIKELY(i >= N))
+			ThrowRangeException();
+
+		return mValue[i];
+	}
+
+	template <size_type I>
+	constexpr reference       get() noexcept {
+		static_assert(I < N, "safememory::constexpr_array index out of range");
+		return mValue[I];
+	}
+
+	template <size_type I>
+	constexpr const_reference get() const noexcept {
+		static_assert(I < N, "safememory::constexpr_array index out of range");
+		return mValue[I];
+	}
+
+	constexpr reference       front() noexcept { return mValue[0]; }
+	constexpr const_reference front() const noexcept { return mValue[0]; }
+
+	constexpr reference       back() noexcept { return mValue[N - 1]; }
+	constexpr const_reference back() const noexcept { return mValue[N - 1]; }
+
+	bool validate() const { return true; }
+	int  validate_iterator(const_pointer i) const {
+		if(i >= begin_unsafe())
+		{
+			if(i < end_unsafe())
+				return (eastl::isf_valid | eastl::isf_current | eastl::isf_can_dereference);
+
+			if(i <= end_unsafe())
+				return (eastl::isf_valid | eastl::isf_current);
+		}
+
+		return eastl::isf_none;
+	}
+
+	int  validate_iterator(const const_stack_only_iterator& i) const { return validate_iterator(i.toRaw(begin_unsafe())); }
+
+protected:
+	// mb: not constexpr, a throw evaluated at compile time is an error
+	[[noreturn]] static void ThrowRangeException() { throw nodecpp::error::out_of_range; }
+
+	iterator makeIt(pointer it) {
+		if constexpr (use_base_iterator)
+			return it;
+		else
+			return iterator::makePtr(mValue, it, N);
+	}
+	const_iterator makeIt(const_pointer it) const {
+		if constexpr (use_base_iterator)
+			return it;
+		else
+			return const_iterator::makePtr(const_cast<pointer>(mValue), it, N);
+	}
+
+}; // class constexpr_array
+
+
 ///////////////////////////////////////////////////////////////////////////
 // template deduction guides
 ///////////////////////////////////////////////////////////////////////////
 #ifdef __cpp_deduction_guides
 	template <class T, class... U> array(T, U...) -> array<T, 1 + sizeof...(U)>;
+	template <class T, class... U> constexpr_array(T, U...) -> constexpr_array<T, 1 + sizeof...(U)>;
 #endif
 
 
@@ -492,6 +665,38 @@ constexpr inline bool operator>=(const array<T, N, S>& a, const array<T, N, S>&
 }
 
 
+template <typename T, eastl_size_t N, memory_safety S>
+constexpr inline bool operator==(const constexpr_array<T, N, S>& a, const constexpr_array<T, N, S>& b)
+{
+	for(eastl_size_t i = 0; i != N; ++i)
+		if(!(a.mValue[i] == b.mValue[i]))
+			return false;
+
+	return true;
+}
+
+
+template <typename T, eastl_size_t N, memory_safety S>
+constexpr inline bool operator!=(const constexpr_array<T, N, S>& a, const constexpr_array<T, N, S>& b)
+{
+	return !operator==(a, b);
+}
+
+
+template <eastl_size_t I, typename T, eastl_size_t N, memory_safety S>
+constexpr inline T& get(constexpr_array<T, N, S>& a) noexcept
+{
+	return a.template get<I>();
+}
+
+
+template <eastl_size_t I, typename T, eastl_size_t N, memory_safety S>
+constexpr inline const T& get(const constexpr_array<T, N, S>& a) noexcept
+{
+	return a.template get<I>();
+}
+
+
 ///////////////////////////////////////////////////////////////////////
 // to_array
 ///////////////////////////////////////////////////////////////////////
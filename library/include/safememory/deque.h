@@ -0,0 +1,497 @@
+/* -------------------------------------------------------------------------------
+* Copyright (c) 2020, OLogN Technologies AG
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of the OLogN Technologies AG nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL OLogN Technologies AG BE LIABLE FOR ANY
+* DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* -------------------------------------------------------------------------------*/
+
+
+
+#ifndef SAFE_MEMORY_DEQUE_H
+#define SAFE_MEMORY_DEQUE_H
+
+#include <utility>
+#include <initializer_list>
+#include <EASTL/iterator.h>
+#include <EASTL/algorithm.h>
+#include <safememory/detail/allocator_to_eastl.h>
+#include <safememory/detail/circular_buffer.h>
+#include <safememory/detail/circular_buffer_iterator.h>
+#include <safe_memory_error.h>
+
+namespace safememory
+{
+	/**
+	 * \brief Double ended queue, implemented as a growable circular buffer (see detail/circular_buffer.h)
+	 * 
+	 * Push and pop at both ends are amortized O(1). Unlike \c std::deque elements are kept
+	 * in a single array, so growing invalidates all iterators and references, same as \c vector.
+	 * Since a zeroed or destructed instance is a valid empty deque,
+	 * no extra validation of the instance is needed before access.
+	 */
+	template <typename T, memory_safety Safety = safeness_declarator<T>::is_safe>
+	class SAFEMEMORY_DEEP_CONST_WHEN_PARAMS deque
+		: protected detail::circular_buffer<T, detail::allocator_to_eastl_deque<Safety>>
+	{
+	public:
+		typedef detail::circular_buffer<T, detail::allocator_to_eastl_deque<Safety>>  base_type;
+		typedef deque<T, Safety>                                                  this_type;
+
+		typedef typename base_type::value_type                                    value_type;
+		typedef typename base_type::size_type                                     size_type;
+		typedef typename base_type::difference_type                               difference_type;
+		typedef typename base_type::reference                                     reference;
+		typedef typename base_type::const_reference                               const_reference;
+		typedef value_type*                                                       pointer;
+		typedef const value_type*                                                 const_pointer;
+		typedef typename base_type::allocator_type                                allocator_type;
+		typedef typename base_type::iterator                                      iterator_base;
+		typedef typename base_type::const_iterator                                const_iterator_base;
+
+		typedef typename detail::circular_buffer_stack_only_iterator<iterator_base, iterator_base, allocator_type>       stack_only_iterator;
+		typedef typename detail::circular_buffer_stack_only_iterator<const_iterator_base, iterator_base, allocator_type>  const_stack_only_iterator;
+		typedef typename detail::circular_buffer_heap_safe_iterator<iterator_base, iterator_base, allocator_type>        heap_safe_iterator;
+		typedef typename detail::circular_buffer_heap_safe_iterator<const_iterator_base, iterator_base, allocator_type>   const_heap_safe_iterator;
+
+	    static constexpr memory_safety is_safe = allocator_type::is_safe;
+		// mb: for 'memory_safety::none' we can boil down to use the base iterator,
+		// same as unordered_map
+		static constexpr bool use_base_iterator = (is_safe == memory_safety::none);
+		
+		typedef std::conditional_t<use_base_iterator, iterator_base, stack_only_iterator>               iterator;
+		typedef std::conditional_t<use_base_iterator, const_iterator_base, const_stack_only_iterator>   const_iterator;
+		typedef eastl::reverse_iterator<iterator>                                                       reverse_iterator;
+		typedef eastl::reverse_iterator<const_iterator>                                                 const_reverse_iterator;
+
+		typedef heap_safe_iterator                                                    iterator_safe;
+		typedef const_heap_safe_iterator                                              const_iterator_safe;
+		typedef eastl::reverse_iterator<iterator_safe>                                reverse_iterator_safe;
+		typedef eastl::reverse_iterator<const_iterator_safe>                          const_reverse_iterator_safe;
+
+		using base_type::npos;
+
+	public:
+		deque() {}
+		explicit deque(size_type n) { resize(n); }
+		deque(size_type n, const value_type& value) { resize(n, value); }
+		deque(const this_type& x) = default;
+		deque(this_type&& x) = default;
+		deque(std::initializer_list<value_type> ilist) { assign(ilist); }
+
+		~deque() = default;
+
+		this_type& operator=(const this_type& x) = default;
+		this_type& operator=(this_type&& x) = default;
+		this_type& operator=(std::initializer_list<value_type> ilist) { assign(ilist); return *this; }
+
+		void swap(this_type& x) noexcept { base_type::swap(x); }
+
+		void assign(size_type n, const value_type& value) {
+			base_type::clear();
+			resize(n, value);
+		}
+
+		void assign(std::initializer_list<value_type> ilist) {
+			assign_unsafe(ilist.begin(), ilist.end());
+		}
+
+		template <typename InputIterator>
+		void assign_unsafe(InputIterator first, InputIterator last) {
+			base_type::clear();
+			for(; first != last; ++first)
+				emplace_back(*first);
+		}
+
+		iterator       begin() noexcept { return makeIt(base_type::begin()); }
+		const_iterator begin() const noexcept { return makeIt(base_type::begin()); }
+		const_iterator cbegin() const noexcept { return makeIt(base_type::cbegin()); }
+
+		iterator       end() noexcept { return makeIt(base_type::end()); }
+		const_iterator end() const noexcept { return makeIt(base_type::end()); }
+		const_iterator cend() const noexcept { return makeIt(base_type::cend()); }
+
+		reverse_iterator       rbegin() noexcept { return reverse_iterator(end()); }
+		const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+		const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(cend()); }
+
+		reverse_iterator       rend() noexcept { return reverse_iterator(begin()); }
+		const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+		const_reverse_iterator crend() const noexcept { return const_reverse_iterator(cbegin()); }
+
+		iterator_safe       begin_safe() { return makeSafeIt(base_type::begin()); }
+		const_iterator_safe begin_safe() const { return makeSafeIt(base_type::begin()); }
+		const_iterator_safe cbegin_safe() const { return makeSafeIt(base_type::cbegin()); }
+
+		iterator_safe       end_safe() { return makeSafeIt(base_type::end()); }
+		const_iterator_safe end_safe() const { return makeSafeIt(base_type::end()); }
+		const_iterator_safe cend_safe() const { return makeSafeIt(base_type::cend()); }
+
+		reverse_iterator_safe       rbegin_safe() { return reverse_iterator_safe(end_safe()); }
+		const_reverse_iterator_safe rbegin_safe() const { return const_reverse_iterator_safe(end_safe()); }
+		const_reverse_iterator_safe crbegin_safe() const { return const_reverse_iterator_safe(cend_safe()); }
+
+		reverse_iterator_safe       rend_safe() { return reverse_iterator_safe(begin_safe()); }
+		const_reverse_iterator_safe rend_safe() const { return const_reverse_iterator_safe(begin_safe()); }
+		const_reverse_iterator_safe crend_safe() const { return const_reverse_iterator_safe(cbegin_safe()); }
+
+		using base_type::empty;
+		using base_type::size;
+		using base_type::capacity;
+		using base_type::clear;
+
+		void reserve(size_type n) {
+			if(n > capacity())
+				base_type::reallocate(n);
+		}
+
+		void shrink_to_fit() {
+			if(size() != capacity())
+				base_type::reallocate(size());
+		}
+
+		void resize(size_type n) {
+			if(n < size())
+				base_type::truncate_back(n);
+			else {
+				reserve(n);
+				while(size() < n)
+					base_type::emplace_back_unchecked();
+			}
+		}
+
+		void resize(size_type n, const value_type& value) {
+			if(n < size())
+				base_type::truncate_back(n);
+			else {
+				// value may be an element of this deque, copy it before growing
+				if(n > capacity())
+					base_type::realloc_emplace_back(n, value);
+				else if(size() < n)
+					base_type::emplace_back_unchecked(value);
+
+				while(size() < n)
+					base_type::emplace_back_unchecked(base_type::at_unchecked(size() - 1));
+			}
+		}
+
+		reference       operator[](size_type n) { checkIndex(n); return base_type::at_unchecked(n); }
+		const_reference operator[](size_type n) const { checkIndex(n); return base_type::at_unchecked(n); }
+
+		reference at(size_type n) {
+			if(NODECPP_UNLIKELY(n >= size()))
+				ThrowRangeException();
+			return base_type::at_unchecked(n);
+		}
+
+		const_reference at(size_type n) const {
+			if(NODECPP_UNLIKELY(n >= size()))
+				ThrowRangeException();
+			return base_type::at_unchecked(n);
+		}
+
+		reference       front() { checkNotEmpty(); return base_type::at_unchecked(0); }
+		const_reference front() const { checkNotEmpty(); return base_type::at_unchecked(0); }
+
+		reference       back() { checkNotEmpty(); return base_type::at_unchecked(size() - 1); }
+		const_reference back() const { checkNotEmpty(); return base_type::at_unchecked(size() - 1); }
+
+		void push_back(const value_type& value) { emplace_back(value); }
+		void push_back(value_type&& value) { emplace_back(std::move(value)); }
+
+		void push_front(const value_type& value) { emplace_front(value); }
+		void push_front(value_type&& value) { emplace_front(std::move(value)); }
+
+		template <class... Args>
+		reference emplace_back(Args&&... args) {
+			if(NODECPP_UNLIKELY(base_type::full()))
+				return base_type::realloc_emplace_back(growCapacity(), std::forward<Args>(args)...);
+			return base_type::emplace_back_unchecked(std::forward<Args>(args)...);
+		}
+
+		template <class... Args>
+		reference emplace_front(Args&&... args) {
+			if(NODECPP_UNLIKELY(base_type::full()))
+				return base_type::realloc_emplace_front(growCapacity(), std::forward<Args>(args)...);
+			return base_type::emplace_front_unchecked(std::forward<Args>(args)...);
+		}
+
+		void pop_back() { checkNotEmpty(); base_type::pop_back(); }
+		void pop_front() { checkNotEmpty(); base_type::pop_front(); }
+
+		template <class... Args>
+		iterator emplace(const const_iterator& position, Args&&... args) {
+			return makeIt(emplaceAt(toIndex(position), std::forward<Args>(args)...));
+		}
+
+		template <class... Args>
+		iterator_safe emplace_safe(const const_iterator_safe& position, Args&&... args) {
+			return makeSafeIt(emplaceAt(toIndex(position), std::forward<Args>(args)...));
+		}
+
+		iterator insert(const const_iterator& position, const value_type& value) {
+			return makeIt(emplaceAt(toIndex(position), value));
+		}
+
+		iterator_safe insert_safe(const const_iterator_safe& position, const value_type& value) {
+			return makeSafeIt(emplaceAt(toIndex(position), value));
+		}
+
+		iterator insert(const const_iterator& position, value_type&& value) {
+			return makeIt(emplaceAt(toIndex(position), std::move(value)));
+		}
+
+		iterator_safe insert_safe(const const_iterator_safe& position, value_type&& value) {
+			return makeSafeIt(emplaceAt(toIndex(position), std::move(value)));
+		}
+
+		iterator erase(const const_iterator& position) {
+			return makeIt(eraseRange(toDerefIndex(position), 1));
+		}
+
+		iterator_safe erase_safe(const const_iterator_safe& position) {
+			return makeSafeIt(eraseRange(toDerefIndex(position), 1));
+		}
+
+		iterator erase(const const_iterator& first, const const_iterator& last) {
+			auto p = toIndex(first, last);
+			return makeIt(eraseRange(p.first, p.second - p.first));
+		}
+
+		iterator_safe erase_safe(const const_iterator_safe& first, const const_iterator_safe& last) {
+			auto p = toIndex(first, last);
+			return makeSafeIt(eraseRange(p.first, p.second - p.first));
+		}
+
+		bool operator==(const this_type& other) const {
+			return size() == other.size() && eastl::equal(base_type::begin(), base_type::end(), other.base_type::begin());
+		}
+		bool operator!=(const this_type& other) const {
+			return !operator==(other);
+		}
+		bool operator<(const this_type& other) const {
+			return eastl::lexicographical_compare(base_type::begin(), base_type::end(), other.base_type::begin(), other.base_type::end());
+		}
+
+		iterator_safe make_safe(const iterator& it) { return makeSafeIt(toBase(it)); }
+		const_iterator_safe make_safe(const const_iterator& it) const { return makeSafeIt(toBase(it)); }
+
+	protected:
+		[[noreturn]] static void ThrowRangeException() { throw nodecpp::error::out_of_range; }
+
+		void checkIndex(size_type n) const {
+			if constexpr(is_safe == memory_safety::safe) {
+				if(NODECPP_UNLIKELY(n >= size()))
+					ThrowRangeException();
+			}
+		}
+
+		void checkNotEmpty() const {
+			if constexpr(is_safe == memory_safety::safe) {
+				if(NODECPP_UNLIKELY(empty()))
+					ThrowRangeException();
+			}
+		}
+
+		size_type growCapacity() const {
+			return capacity() < base_type::kMinCapacity / 2 ? base_type::kMinCapacity : capacity() * 2;
+		}
+
+		template <class... Args>
+		size_type emplaceAt(size_type pos, Args&&... args) {
+			if(NODECPP_UNLIKELY(base_type::full())) {
+				// mb: grow first, so args referencing an element still work
+				// and shifting happens on the new array
+				value_type value(std::forward<Args>(args)...);
+				base_type::reallocate(growCapacity());
+				return base_type::emplace_at(pos, std::move(value));
+			}
+			return base_type::emplace_at(pos, std::forward<Args>(args)...);
+		}
+
+		size_type eraseRange(size_type first, size_type n) {
+			base_type::erase_range(first, first + n);
+			return first;
+		}
+
+		// iterators from other deque, or created before a push_front, are not valid positions
+		size_type toIndex(const const_iterator_base& it) const {
+			size_type ix = base_type::index_of(it);
+			if constexpr(is_safe == memory_safety::safe) {
+				if(NODECPP_UNLIKELY(ix == npos))
+					ThrowRangeException();
+			}
+			return ix;
+		}
+
+		size_type toIndex(const const_stack_only_iterator& it) const { return toIndex(it.toBase()); }
+		size_type toIndex(const const_heap_safe_iterator& it) const { return toIndex(it.toBase()); }
+
+		template <typename It>
+		size_type toDerefIndex(const It& it) const {
+			size_type ix = toIndex(it);
+			if constexpr(is_safe == memory_safety::safe) {
+				if(NODECPP_UNLIKELY(ix >= size()))
+					ThrowRangeException();
+			}
+			return ix;
+		}
+
+		template <typename It>
+		std::pair<size_type, size_type> toIndex(const It& first, const It& last) const {
+			size_type f = toIndex(first);
+			size_type l = toIndex(last);
+			if constexpr(is_safe == memory_safety::safe) {
+				if(NODECPP_UNLIKELY(f > l))
+					ThrowRangeException();
+			}
+			return { f, l };
+		}
+
+		const iterator_base& toBase(const iterator_base& it) const { return it; }
+		const const_iterator_base& toBase(const const_iterator_base& it) const { return it; }
+		const iterator_base& toBase(const stack_only_iterator& it) const { return it.toBase(); }
+		const const_iterator_base& toBase(const const_stack_only_iterator& it) const { return it.toBase(); }
+
+		iterator makeIt(const iterator_base& it) const {
+			if constexpr(use_base_iterator)
+				return it;
+			else
+				return iterator::fromBase(it);
+		}
+
+		const_iterator makeIt(const const_iterator_base& it) const {
+			if constexpr(use_base_iterator)
+				return it;
+			else
+				return const_iterator::fromBase(it);
+		}
+
+		iterator makeIt(size_type ix) { return makeIt(base_type::begin() + ix); }
+
+		iterator_safe makeSafeIt(const iterator_base& it) const {
+			return iterator_safe::makeIt(it, base_type::array_ptr());
+		}
+
+		const_iterator_safe makeSafeIt(const const_iterator_base& it) const {
+			return const_iterator_safe::makeIt(it, base_type::array_ptr());
+		}
+
+		iterator_safe makeSafeIt(size_type ix) { return makeSafeIt(base_type::begin() + ix); }
+	}; // deque
+
+
+	// deque_safe is kind of wrapper that forwards calls to their 'safe' counterpart.
+	// i.e. 'begin' -> 'begin_safe', 'end' -> 'end_safe' and so and so.
+	// this is useful for benchmarks and for tests
+	template <typename T, memory_safety Safety = safeness_declarator<T>::is_safe>
+	class SAFEMEMORY_DEEP_CONST_WHEN_PARAMS deque_safe
+		: public deque<T, Safety>
+	{
+	public:
+		typedef deque<T, Safety>                                                  base_type;
+		typedef deque_safe<T, Safety>                                             this_type;
+
+		using typename base_type::size_type;
+		using typename base_type::value_type;
+
+		typedef typename base_type::iterator_safe                                 iterator;
+		typedef typename base_type::const_iterator_safe                           const_iterator;
+		typedef typename base_type::reverse_iterator_safe                         reverse_iterator;
+		typedef typename base_type::const_reverse_iterator_safe                   const_reverse_iterator;
+
+	public:
+		deque_safe(): base_type() {}
+		explicit deque_safe(size_type n) : base_type(n) {}
+		deque_safe(size_type n, const value_type& value) : base_type(n, value) {}
+		deque_safe(const this_type& x) = default;
+		deque_safe(this_type&& x) = default;
+		deque_safe(std::initializer_list<value_type> ilist) : base_type(ilist) {}
+
+		~deque_safe() = default;
+
+		this_type& operator=(const this_type& x) = default;
+		this_type& operator=(this_type&& x) = default;
+		this_type& operator=(std::initializer_list<value_type> ilist) { 
+			base_type::operator=(ilist);
+			return *this;
+		}
+
+		iterator       begin() { return base_type::begin_safe(); }
+		const_iterator begin() const { return base_type::begin_safe(); }
+		const_iterator cbegin() const { return base_type::cbegin_safe(); }
+
+		iterator       end() { return base_type::end_safe(); }
+		const_iterator end() const { return base_type::end_safe(); }
+		const_iterator cend() const { return base_type::cend_safe(); }
+
+		reverse_iterator       rbegin() { return base_type::rbegin_safe(); }
+		const_reverse_iterator rbegin() const { return base_type::rbegin_safe(); }
+		const_reverse_iterator crbegin() const { return base_type::crbegin_safe(); }
+
+		reverse_iterator       rend() { return base_type::rend_safe(); }
+		const_reverse_iterator rend() const { return base_type::rend_safe(); }
+		const_reverse_iterator crend() const { return base_type::crend_safe(); }
+
+		template <class... Args>
+		iterator emplace(const_iterator position, Args&&... args) {
+			return base_type::emplace_safe(position, std::forward<Args>(args)...);
+		}
+
+		iterator insert(const_iterator position, const value_type& value) {
+			return base_type::insert_safe(position, value);
+		}
+
+		iterator insert(const_iterator position, value_type&& value) {
+			return base_type::insert_safe(position, std::move(value));
+		}
+
+		iterator erase(const_iterator position) {
+			return base_type::erase_safe(position);
+		}
+
+		iterator erase(const_iterator first, const_iterator last) {
+			return base_type::erase_safe(first, last);
+		}
+	}; // deque_safe
+
+
+	///////////////////////////////////////////////////////////////////////
+	// global operators
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename T, memory_safety Safety>
+	inline void swap(deque<T, Safety>& a, deque<T, Safety>& b) 
+	{
+		a.swap(b);
+	}
+
+	template <typename T, memory_safety Safety>
+	inline void swap(deque_safe<T, Safety>& a, deque_safe<T, Safety>& b) 
+	{
+		a.swap(b);
+	}
+
+} // namespace safememory
+
+
+#endif //SAFE_MEMORY_DEQUE_H
@@ -33,6 +33,7 @@
 #include <safememory/detail/flexible_array.h>
 #include <type_traits>
 #include <EASTL/internal/config.h> // for eastl_size_t
+#include <EASTL/memory.h> // for eastl::relocation_fixup
 
 /** \file
  * \brief Allocators feed by \a safememory containers into \c eastl ones.
@@ -175,6 +176,42 @@ soft_ptr_with_zero_offset<flexible_array<T>, is_safe> allocate_flexible_array_he
 	return { mm.first, dataForObj };
 }
 
+// mb: iibmalloc serves small requests from power of two buckets, and bigger ones in whole pages,
+// so anything we don't ask for up to the end of the bucket is lost anyway.
+// As we always request the rounded size, a wrong guess here only costs memory, never safety.
+constexpr std::size_t allocation_bucket_max = std::size_t(1) << 16;
+constexpr std::size_t allocation_page_size = std::size_t(1) << 12;
+
+constexpr std::size_t allocation_bucket_size(std::size_t sz) {
+
+	if(sz > allocation_bucket_max)
+		return (sz + allocation_page_size - 1) & ~(allocation_page_size - 1);
+
+	std::size_t bucket = 8;
+	while(bucket < sz)
+		bucket <<= 1;
+
+	return bucket;
+}
+
+/**
+ * \brief Allocates an array of at least \c count elements, and updates \c count
+ * with the real capacity, so the slack up to the allocator bucket is usable.
+ */
+template<memory_safety is_safe, typename T, bool zeroed>
+soft_ptr_with_zero_offset<flexible_array<T>, is_safe> allocate_flexible_array_at_least_helper(eastl_size_t& count) {
+
+	// zombie allocations have the control block in front, that goes in the same bucket
+	constexpr std::size_t head = is_safe == memory_safety::none ? 0 : sizeof(FirstControlBlock);
+
+	auto total = flexible_array<T>::calculateSize(count) + head;
+	auto capacity = flexible_array<T>::calculateCapacity(allocation_bucket_size(total) - head);
+	if(capacity > count)
+		count = capacity;
+
+	return allocate_flexible_array_helper<is_safe, T, zeroed>(count);
+}
+
 
 // two special values used inside eastl::hashtable
 // soft_ptr needs to have special behaviour around this values.
@@ -225,24 +262,41 @@ class soft_ptr_helper {
 	static soft_ptr_no_checks<T> make_soft_ptr_no_checks(fbc_ptr_t cb, T* t) {
 		return soft_ptr_no_checks<T>(cb, t);
 	}
+
+	/// \c p was relocated bitwise from another heap location,
+	/// same as the heap to heap branch of \c soft_ptr_impl move ctor
+	template<class T>
+	static void relocated(soft_ptr_base_impl<T>* p) {
+		using PointersT = typename soft_ptr_base_impl<T>::PointersT;
+#ifdef NODECPP_MEMORY_SAFETY_ON_DEMAND
+		if ( p->getDereferencablePtr() && p->getAllocatedPtr() != nullptr && p->getIdx_() != PointersT::max_data )
+#else
+		if ( p->getDereferencablePtr() && p->getIdx_() != PointersT::max_data )
+#endif
+			p->getControlBlock()->resetPtr(p->getIdx_(), p);
+	}
 };
 
 class soft_this_ptr_raii_impl {
 
 	void* stackTmp;
+	std::size_t stackSizeTmp;
 public:
-	soft_this_ptr_raii_impl(void* ptr) noexcept : stackTmp(thg_stackPtrForMakeOwningCall) {
+	soft_this_ptr_raii_impl(void* ptr, std::size_t sz) noexcept
+		: stackTmp(thg_stackPtrForMakeOwningCall), stackSizeTmp(thg_stackSizeForMakeOwningCall) {
 		thg_stackPtrForMakeOwningCall = ptr;
+		thg_stackSizeForMakeOwningCall = sz;
 	}
 
 	~soft_this_ptr_raii_impl() {
 		thg_stackPtrForMakeOwningCall = stackTmp;
+		thg_stackSizeForMakeOwningCall = stackSizeTmp;
 	}
 };
 
 class soft_this_ptr_raii_dummy {
 public:
-	soft_this_ptr_raii_dummy(void* ptr) {}
+	soft_this_ptr_raii_dummy(void*, std::size_t) {}
 };
 
 // we can safely use a dummy when the type is trivial.
@@ -287,6 +341,13 @@ public:
 		return allocate_flexible_array_helper<is_safe, T, !std::is_trivially_copyable_v<T>>(count);
 	}
 
+	/// allocates at least \c count elements, \c count is updated to the real capacity
+	template<class T>
+	array_pointer<T> allocate_array_at_least(eastl_size_t& count, int flags = 0) {
+		// for non trivial types, always zero memory
+		return allocate_flexible_array_at_least_helper<is_safe, T, !std::is_trivially_copyable_v<T>>(count);
+	}
+
 	template<class T>
 	array_pointer<T> allocate_array_zeroed(eastl_size_t count, int flags = 0) {
 		return allocate_flexible_array_helper<is_safe, T, true>(count);
@@ -317,18 +378,38 @@ public:
 		return p.get_raw_begin();
 	}
 
+	/// converts between node types sharing the same allocation, i.e. \c btree leaf and inner nodes
+	template<class T, class U>
+	static pointer<T> static_pointer_cast(const pointer<U>& p) {
+#ifdef NODECPP_MEMORY_SAFETY_ON_DEMAND
+		return {make_zero_offset_t{p.get_allocator_id()}, static_cast<T*>(p.get_raw_ptr())};
+#else
+		return {make_zero_offset_t{}, static_cast<T*>(p.get_raw_ptr())};
+#endif
+	}
+
+	/// bytes of the block at \c p where \c soft_this_ptr2 of the elements anchors on its control block.
+	/// A node lives as long as its element does
+	template<class T>
+	static std::size_t raii_size(const T*) { return sizeof(T); }
+
+	/// none for arrays, a slot outlives the element in it (i.e. \c pop_back or \c erase),
+	/// so anchoring there would keep a \c soft_ptr valid to an element already destroyed
+	template<class T>
+	static std::size_t raii_size(const flexible_array<T>*) { return 0; }
+
 #ifdef NODECPP_MEMORY_SAFETY_ON_DEMAND
 	template<class T>
 	static soft_this_ptr_raii<T> make_raii(const pointer<T>& p) {
 		if(p.get_allocator_id() != 0)
-			return {p.get_raw_ptr()};
+			return {p.get_raw_ptr(), raii_size(p.get_raw_ptr())};
 		else
-			return {nullptr};
+			return {nullptr, 0};
 	}
 #else
 	template<class T>
 	static soft_this_ptr_raii<T> make_raii(const pointer<T>& p) {
-		return {p.get_raw_ptr()};
+		return {p.get_raw_ptr(), raii_size(p.get_raw_ptr())};
 	}
 #endif
 
@@ -348,6 +429,12 @@ public:
 		return p.get_raw_ptr() == hashtable_sentinel<T>();
 	}
 
+	/// null and the sentinel fold in a single compare, as no node can live below the sentinel address
+	template<class T>
+	static bool is_null_or_hashtable_sentinel(const pointer<T>& p) {
+		return reinterpret_cast<uintptr_t>(p.get_raw_ptr()) <= reinterpret_cast<uintptr_t>(hashtable_sentinel<T>());
+	}
+
 	template<class T>
 	static bool is_empty_hashtable(const pointer<T>& a) {
 		return a.get_raw_ptr() == empty_hashtable_impl<T>();
@@ -400,6 +487,12 @@ public:
 		return allocate_flexible_array_helper<is_safe, T, false>(count);
 	}
 
+	/// allocates at least \c count elements, \c count is updated to the real capacity
+	template<class T>
+	array_pointer<T> allocate_array_at_least(eastl_size_t& count, int flags = 0) {
+		return allocate_flexible_array_at_least_helper<is_safe, T, false>(count);
+	}
+
 	template<class T>
 	array_pointer<T> allocate_array_zeroed(eastl_size_t count, int flags = 0) {
 		return allocate_flexible_array_helper<is_safe, T, true>(count);
@@ -430,10 +523,20 @@ public:
 		return p.get_raw_begin();
 	}
 
+	/// converts between node types sharing the same allocation, i.e. \c btree leaf and inner nodes
+	template<class T, class U>
+	static pointer<T> static_pointer_cast(const pointer<U>& p) {
+#ifdef NODECPP_MEMORY_SAFETY_ON_DEMAND
+		return {make_zero_offset_t{p.get_allocator_id()}, static_cast<T*>(p.get_raw_ptr())};
+#else
+		return {make_zero_offset_t{}, static_cast<T*>(p.get_raw_ptr())};
+#endif
+	}
+
 	// We don't have a ControlBlock, so soft_this_ptr can't possible work
 	template<class T>
 	static soft_this_ptr_raii_dummy make_raii(const pointer<T>& p) {
-		return {nullptr};
+		return {nullptr, 0};
 	}
 
 	template<class T>
@@ -451,6 +554,12 @@ public:
 		return p.get_raw_ptr() == hashtable_sentinel<T>();
 	}
 
+	/// null and the sentinel fold in a single compare, as no node can live below the sentinel address
+	template<class T>
+	static bool is_null_or_hashtable_sentinel(const pointer<T>& p) {
+		return reinterpret_cast<uintptr_t>(p.get_raw_ptr()) <= reinterpret_cast<uintptr_t>(hashtable_sentinel<T>());
+	}
+
 	template<class T>
 	static bool is_empty_hashtable(const pointer<T>& a) {
 		return a.get_raw_ptr() == empty_hashtable_no_checks<T>();
@@ -478,6 +587,151 @@ public:
 
 
 
+#ifndef SAFEMEMORY_HASHTABLE_NODE_POOL_CAPACITY
+#define SAFEMEMORY_HASHTABLE_NODE_POOL_CAPACITY 64
+#endif
+
+/**
+ * \brief Adds a per-container pool of released nodes to \c Base allocator.
+ *
+ * Under insert / erase churn every erased node goes to the zombie heap. Instead we keep
+ * up to \c node_pool_capacity() released nodes and hand them back on next \c allocate_node.
+ *
+ * Before a node enters the pool all \c soft_ptr to it are invalidated and its \a ControlBlock
+ * is reset, the same as a real deallocation, so a __safe__ iterator to an erased element
+ * throws on dereference even after its memory was recycled for a new element.
+ * Pooled memory stays type stable, only nodes of the owning container go in, and the free
+ * list link is kept in the node own \c mpNext, so a pooled node is still a node.
+ *
+ * With \c NODECPP_SAFE_PTR_USE_ON_STACK_OPTIMIZATION a \c soft_ptr on the stack is not
+ * registered at the \a ControlBlock, and with \c SAFEMEMORY_DEZOMBIEFY_ITERATORS a stack only
+ * iterator is a raw pointer checked by zombie detection. A pooled node is not a zombie,
+ * so in both cases the pool is disabled (capacity is always 0) for safe allocators.
+ *
+ * The pool is never shared, a copy of the allocator starts with an empty one.
+ */
+template<class Base>
+class node_pool_allocator_to_eastl : public Base {
+
+	soft_ptr_with_zero_offset_base mpFreeNodes;
+	eastl_size_t mnPoolSize = 0;
+	eastl_size_t mnPoolCapacity = pool_capacity(SAFEMEMORY_HASHTABLE_NODE_POOL_CAPACITY);
+	// every insert allocates a node and every erase releases one
+	eastl_size_t mnModifications = 0;
+	soft_ptr_with_zero_offset_base (*mpReleaseNode)(const soft_ptr_with_zero_offset_base&) = nullptr;
+
+	template<class T>
+	static typename Base::template pointer<T> to_pointer(const soft_ptr_with_zero_offset_base& p) {
+#ifdef NODECPP_MEMORY_SAFETY_ON_DEMAND
+		return {make_zero_offset_t{p.get_allocator_id()}, static_cast<T*>(p.get_raw())};
+#else
+		return {make_zero_offset_t{}, static_cast<T*>(p.get_raw())};
+#endif
+	}
+
+	/// releases a pooled node, returns the next one
+	template<class T>
+	static soft_ptr_with_zero_offset_base release_node(const soft_ptr_with_zero_offset_base& p) {
+		pointer<T> node = to_pointer<T>(p);
+		soft_ptr_with_zero_offset_base next = node->mpNext;
+		deallocate_helper<Base::is_safe, T>(node);
+		return next;
+	}
+
+	void release_pool(eastl_size_t keep) {
+		while(mnPoolSize > keep) {
+			mpFreeNodes = mpReleaseNode(mpFreeNodes);
+			--mnPoolSize;
+		}
+	}
+
+	static constexpr bool pool_enabled() {
+#if defined(NODECPP_SAFE_PTR_USE_ON_STACK_OPTIMIZATION) || defined(SAFEMEMORY_DEZOMBIEFY_ITERATORS)
+		return Base::is_safe == memory_safety::none;
+#else
+		return true;
+#endif
+	}
+
+	static constexpr eastl_size_t pool_capacity(eastl_size_t n) { return pool_enabled() ? n : 0; }
+
+public:
+	template<class T>
+	using pointer = typename Base::template pointer<T>;
+
+	node_pool_allocator_to_eastl() = default;
+
+	node_pool_allocator_to_eastl(const node_pool_allocator_to_eastl& other)
+		: Base(other), mnPoolCapacity(other.mnPoolCapacity) {}
+
+	node_pool_allocator_to_eastl& operator=(const node_pool_allocator_to_eastl& other) {
+		node_pool_capacity(other.mnPoolCapacity);
+		return *this;
+	}
+
+	~node_pool_allocator_to_eastl() { release_pool(0); }
+
+	template<class T>
+	pointer<T> allocate_node() {
+		++mnModifications;
+		if(mnPoolSize != 0) {
+			pointer<T> p = to_pointer<T>(mpFreeNodes);
+			mpFreeNodes = p->mpNext;
+			--mnPoolSize;
+			return p;
+		}
+		return Base::template allocate_node<T>();
+	}
+
+	template<class T>
+	void deallocate_node(const pointer<T>& p) {
+		++mnModifications;
+		if(p && mnPoolSize < mnPoolCapacity) {
+			T* dataForObj = p.get_raw_ptr();
+			if constexpr (Base::is_safe == memory_safety::safe) {
+#ifdef NODECPP_MEMORY_SAFETY_ON_DEMAND
+				auto allocatorID = p.get_allocator_id();
+				if(allocatorID != 0) {
+					auto cb = getControlBlock_(dataForObj);
+					cb->template updatePtrForListItemsWithInvalidPtr<T>();
+					cb->clear(allocatorID);
+					cb->init();
+				}
+#else
+				auto cb = getControlBlock_(dataForObj);
+				cb->template updatePtrForListItemsWithInvalidPtr<T>();
+				cb->clear();
+				cb->init();
+#endif
+			}
+			// mb: node is already destructed, only its link is alive again
+			::new (&dataForObj->mpNext) pointer<T>(to_pointer<T>(mpFreeNodes));
+			mpFreeNodes = p;
+			++mnPoolSize;
+			mpReleaseNode = &release_node<T>;
+		}
+		else
+			Base::deallocate_node(p);
+	}
+
+	eastl_size_t node_pool_size() const { return mnPoolSize; }
+	eastl_size_t node_pool_capacity() const { return mnPoolCapacity; }
+
+	/// changes each time a node is allocated or released, used to detect inserts and erases
+	const eastl_size_t& node_modifications() const { return mnModifications; }
+
+	/// releases pooled nodes above the new capacity
+	void node_pool_capacity(eastl_size_t n) {
+		mnPoolCapacity = pool_capacity(n);
+		release_pool(n);
+	}
+
+	//nodes are interchangeable between pools
+	bool operator==(const node_pool_allocator_to_eastl&) const { return true; }
+	bool operator!=(const node_pool_allocator_to_eastl&) const { return false; }
+};
+
+
 template<memory_safety Safety>
 using allocator_to_eastl_string = std::conditional_t<Safety == memory_safety::safe,
 			base_allocator_to_eastl_impl, base_allocator_to_eastl_no_checks>;
@@ -489,10 +743,47 @@ using allocator_to_eastl_vector = std::conditional_t<Safety == memory_safety::sa
 
 
 template<memory_safety Safety>
-using allocator_to_eastl_hashtable = std::conditional_t<Safety == memory_safety::safe,
+using allocator_to_eastl_hashtable = node_pool_allocator_to_eastl<std::conditional_t<Safety == memory_safety::safe,
+			base_allocator_to_eastl_impl, base_allocator_to_eastl_no_checks>>;
+
+template<memory_safety Safety>
+using allocator_to_eastl_btree = std::conditional_t<Safety == memory_safety::safe,
+			base_allocator_to_eastl_impl, base_allocator_to_eastl_no_checks>;
+
+template<memory_safety Safety>
+using allocator_to_eastl_deque = std::conditional_t<Safety == memory_safety::safe,
 			base_allocator_to_eastl_impl, base_allocator_to_eastl_no_checks>;
 
 
 } // namespace safememory::detail
 
+namespace eastl {
+
+// Pointers can be relocated bitwise by eastl::vector growth. owning_ptr is never registered
+// anywhere by its address, soft_ptr on the heap is, and gets its slot updated by relocation_fixup.
+// Lifecycle debug info is a non trivial member, so it disables the whole thing.
+#ifndef NODECPP_MEMORY_SAFETY_DBG_ADD_PTR_LIFECYCLE_INFO
+template<class T>
+struct is_trivially_relocatable<safememory::detail::owning_ptr_impl<T>> : public true_type {};
+
+template<class T>
+struct is_trivially_relocatable<safememory::detail::soft_ptr_impl<T>> : public true_type {};
+
+template<class T>
+struct relocation_fixup<safememory::detail::soft_ptr_impl<T>> {
+	static void relocated(safememory::detail::soft_ptr_impl<T>* p, size_t n) noexcept {
+		for(size_t i = 0; i != n; ++i)
+			safememory::detail::soft_ptr_helper::relocated(p + i);
+	}
+};
+#endif // NODECPP_MEMORY_SAFETY_DBG_ADD_PTR_LIFECYCLE_INFO
+
+template<class T>
+struct is_trivially_relocatable<safememory::detail::owning_ptr_no_checks<T>> : public true_type {};
+
+template<class T>
+struct is_trivially_relocatable<safememory::detail::soft_ptr_no_checks<T>> : public true_type {};
+
+} // namespace eastl
+
 #endif // SAFE_MEMORY_DETAIL_ALLOCATOR_TO_EASTL_H
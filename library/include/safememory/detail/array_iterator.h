@@ -53,21 +53,23 @@ namespace safememory::detail {
  * 
  * When used as \a stack_only iterator, it can point to array or buffer on the stack or
  * on the heap, static checker must enforce lifetime rules similar to those of raw pointers.
- * To make things easier for checker we provide a derived class \c array_stack_only_iterator
- * with exactly the same behaviour as this.
+ * To make things easier for checker we provide a class \c array_stack_only_iterator
+ * with the same behaviour as this.
  * 
  * When used as \a heap_safe iterator, it must point to an array on the heap and the class itself 
  * is also safe to store at the heap. This usually will use a \c soft_ptr as \p ArrPtr.
  * 
- * Current implementation uses a \c begin pointer and two indexes, but implementation with
- * Three pointers is also posible.
+ * Current implementation uses a \c begin pointer and two indexes, as \p ArrPtr may be a
+ * \c soft_ptr. \c array_stack_only_iterator uses three raw pointers instead.
  * 
  * Also at current implementation, we throw if iterator is at end or outside range.
  * 
  * 
  * On \c safememory::string because of SSO, we sometimes point to an array on the stack
- * and other times at an array on the heap. For \a heap_safe iterators, implementation will
- * always move the buffer to the heap before creating the iterator.
+ * and other times at an array on the heap. For \a heap_safe iterators, a SSO string that is
+ * part of an object on the heap is anchored with a \c soft_this_ptr2 and \p ArrPtr is a
+ * \c string_soft_buffer_ptr to the string itself. Otherwise implementation will move
+ * the buffer to the heap before creating the iterator.
  * The default constructed iterator is different from an iterator to an empty string,
  * as the \c eastl::basic_string implementation has a buffer with a \c '\0' character when empty.
  * Only a default contructed iterator will have \p ArrPtr as a \c nullptr .
@@ -494,15 +496,248 @@ public:
 /**
  * \brief Safe and generic iterator for arrays.
  * 
- * This iterator is exactly identical to \c array_heap_safe_iterator but checker
- * will enforce a different set of rules for it.
+ * Library will use this iterator when scope rules must be enforced on iterator,
+ * checker will not allow it to outlive the array, so we don't need to store
+ * an \p ArrPtr and an index like \c array_heap_safe_iterator does.
  * 
- * Library will use this iterator when scope rules must be enforced on iterator
+ * It holds three raw pointers, current, begin and end. Dereference is a single
+ * (unsigned) compare of current against the range, and the compiler can strength
+ * reduce and vectorize loops over it as over raw pointers.
  * 
+ * Same as \c array_heap_safe_iterator we throw if iterator is at end or outside range,
+ * and comparing iterators to different arrays throws.
  */
 template <typename T, bool is_const, typename ArrPtr, bool is_dezombiefy = false>
-class array_stack_only_iterator :protected array_heap_safe_iterator<T, is_const, ArrPtr, is_dezombiefy>
+class array_stack_only_iterator
 {
+protected:
+	typedef array_stack_only_iterator<T, is_const, ArrPtr, is_dezombiefy>    this_type;
+	typedef array_stack_only_iterator<T, false, ArrPtr, is_dezombiefy>       this_type_non_const;
+	typedef ArrPtr									                         array_pointer;
+
+	static_assert(std::is_pointer<array_pointer>::value, "stack only iterator only works with raw pointers");
+
+	// for non-const to const conversion
+	template<typename, bool, typename, bool>
+	friend class array_stack_only_iterator;
+
+	template<typename TT>
+	static constexpr bool sfinae = is_const && std::is_same_v<TT, this_type_non_const>;
+
+
+public:
+	typedef std::random_access_iterator_tag  			iterator_category;
+	typedef std::conditional_t<is_const, const T, T>	value_type;
+	typedef eastl_ssize_t                               difference_type;
+	typedef eastl_size_t                                size_type;
+	typedef value_type*									pointer;
+	typedef value_type&									reference;
+
+protected:
+	pointer _cur = nullptr;
+	pointer _begin = nullptr;
+	pointer _end = nullptr;
+
+	/// this ctor is private because it is unsafe and shouldn't be reached by user
+	constexpr array_stack_only_iterator(pointer cur, pointer begin, pointer end)
+		: _cur(cur), _begin(begin), _end(end) {}
+
+	[[noreturn]] static void ThrowRangeException() { throw nodecpp::error::out_of_range; }
+	[[noreturn]] static void ThrowNullException() { throw nodecpp::error::zero_pointer_access; }
+	[[noreturn]] static void ThrowInvalidArgumentException() { throw nodecpp::error::out_of_range; }
+
+public:
+	/// default ctor must always be available for iterators
+	constexpr array_stack_only_iterator() {}
+
+	/// static factory methods are unsafe but static checker tool will keep user hands away
+	static constexpr this_type makeIx(array_pointer arr, size_type ix, size_type sz) {
+
+		NODECPP_ASSERT(module_id, nodecpp::assert::AssertLevel::regular, ix <= sz);
+		return {arr + ix, arr, arr + sz};
+	}
+
+	static constexpr this_type makePtr(array_pointer arr, pointer to, size_type sz) {
+
+		return {to, arr, arr + sz};
+	}
+
+	template <typename Container>
+	static constexpr this_type makeIx(array_pointer arr, size_type ix, Container* container) {
+
+		return makeIx(arr, ix, static_cast<size_type>(container->capacity()));
+	}
+
+	template <typename Container>
+	static constexpr this_type makePtr(array_pointer arr, pointer to, Container* container) {
+
+		return makePtr(arr, to, static_cast<size_type>(container->capacity()));
+	}
+
+	static constexpr this_type makeIt(const this_type&  it, pointer to) {
+		return {to, it._begin, it._end};
+	}
+
+	array_stack_only_iterator(const array_stack_only_iterator& ri) = default;
+	array_stack_only_iterator& operator=(const array_stack_only_iterator& ri) = default;
+
+	array_stack_only_iterator(array_stack_only_iterator&& ri) = default; 
+	array_stack_only_iterator& operator=(array_stack_only_iterator&& ri) = default;
+
+	/// allow non-const to const constructor
+	template<typename Other, std::enable_if_t<sfinae<Other>, bool> = true>
+	constexpr array_stack_only_iterator(const Other& ri)
+		: _cur(ri._cur), _begin(ri._begin), _end(ri._end) {}
+
+	/// allow non-const to const assignment
+	template<typename Other, std::enable_if_t<sfinae<Other>, bool> = true>
+	array_stack_only_iterator& operator=(const Other& ri) {
+		this->_cur = ri._cur;
+		this->_begin = ri._begin;
+		this->_end = ri._end;
+		return *this;
+	}
+
+	~array_stack_only_iterator() {
+		_cur = nullptr;
+		_begin = nullptr;
+		_end = nullptr;
+		forcePreviousChangesToThisInDtor(this);
+	}
+
+	constexpr reference operator*() const { return *getDereferenceablePtr(_cur); }
+	constexpr pointer operator->() const { return getDereferenceablePtr(_cur); }
+
+	constexpr this_type& operator++() noexcept { ++_cur; return *this; }
+	constexpr this_type& operator--() noexcept { --_cur; return *this; }
+
+	constexpr this_type operator++(int) noexcept { this_type ri(*this); ++_cur; return ri; }
+	constexpr this_type operator--(int) noexcept { this_type ri(*this); --_cur; return ri; }
+
+	constexpr this_type operator+(difference_type n) const noexcept { return this_type(_cur + n, _begin, _end); }
+	constexpr this_type operator-(difference_type n) const noexcept { return this_type(_cur - n, _begin, _end); }
+
+	constexpr this_type& operator+=(difference_type n) noexcept { _cur += n; return *this; }
+	constexpr this_type& operator-=(difference_type n) noexcept { _cur -= n; return *this; }
+
+	constexpr reference operator[](difference_type n) const { return *getDereferenceablePtr(_cur + n); }
+
+	difference_type operator-(const this_type& ri) const noexcept {
+
+		// it1 == it2 => it1 - it2 == 0, even for null iterators
+		if(_begin == ri._begin)
+			return static_cast<difference_type>(_cur - ri._cur);
+		else
+			ThrowInvalidArgumentException();
+	}
+
+	bool operator==(const this_type& ri) const noexcept {
+
+		if(_begin == ri._begin)
+			return _cur == ri._cur;
+		else if(!_begin || !ri._begin)
+			return false;
+		else
+			ThrowInvalidArgumentException();
+	}
+
+	bool operator!=(const this_type& ri) const noexcept {
+		return !operator==(ri);
+	}
+
+	bool operator<(const this_type& ri) const noexcept {
+
+		if(_begin == ri._begin)
+			return _cur < ri._cur;
+		else if(!_begin)
+			return true;
+		else if(!ri._begin)
+			return false;
+		else
+			ThrowInvalidArgumentException();
+	}
+
+	bool operator>(const this_type& ri) const noexcept {
+		return ri.operator<(*this);
+	}
+
+	bool operator<=(const this_type& ri) const noexcept {
+		return !this->operator>(ri);
+	}
+
+	bool operator>=(const this_type& ri) const noexcept {
+		return !this->operator<(ri);
+	}
+
+	/// \brief Convert this iterator to raw pointer, see \c array_heap_safe_iterator::toRaw
+	pointer toRaw(const T* begin) const {
+
+		if(NODECPP_UNLIKELY(begin != _begin))
+			ThrowRangeException();
+		checkCur();
+
+		return _cur;
+	}
+
+	std::pair<pointer, pointer> toRaw(const T* begin, const this_type& ri) const {
+
+		if(NODECPP_UNLIKELY(begin != _begin))
+			ThrowRangeException();
+
+		return toRawOther(ri);
+	}
+
+	std::pair<pointer, pointer> toRawOther(const this_type& ri) const {
+
+		if(NODECPP_UNLIKELY(_begin !=  ri._begin))
+			ThrowRangeException();
+		else if(NODECPP_UNLIKELY(!(_cur <= ri._cur)))
+			ThrowRangeException();
+
+		ri.checkCur();
+
+		return {_cur, ri._cur};
+	}
+
+	protected:
+
+	/**
+	 * \brief get a pointer that is checked to be dereferenceable.
+	 * 
+	 * An unsigned distance to \c _begin is lower than the range size only when
+	 * \p p is in range. A null iterator has an empty range.
+ 	 */
+	constexpr pointer getDereferenceablePtr(pointer p) const {
+
+		if(NODECPP_UNLIKELY(!(static_cast<std::size_t>(p - _begin) < static_cast<std::size_t>(_end - _begin)))) {
+			if(!_begin)
+				ThrowNullException();
+			else
+				ThrowRangeException();
+		}
+
+		return p;
+	}
+
+	void checkCur() const {
+		if(NODECPP_UNLIKELY(!(static_cast<size_type>(_cur - _begin) <= static_cast<size_type>(_end - _begin))))
+			ThrowRangeException();
+	}
+};
+
+
+/**
+ * \brief Stack only iterator for arrays, dezombiefy version.
+ * 
+ * Dezombiefy must ask the container for its size on each dereference, so here
+ * we are exactly identical to \c array_heap_safe_iterator and only checker
+ * enforces a different set of rules.
+ */
+template <typename T, bool is_const, typename ArrPtr>
+class array_stack_only_iterator<T, is_const, ArrPtr, true> :protected array_heap_safe_iterator<T, is_const, ArrPtr, true>
+{
+	static constexpr bool is_dezombiefy = true;
+
 protected:
 	typedef array_stack_only_iterator<T, is_const, ArrPtr, is_dezombiefy>    this_type;
 	typedef array_stack_only_iterator<T, false, ArrPtr, is_dezombiefy>       this_type_non_const;
@@ -0,0 +1,978 @@
+/* -------------------------------------------------------------------------------
+* Copyright (c) 2020, OLogN Technologies AG
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of the OLogN Technologies AG nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL OLogN Technologies AG BE LIABLE FOR ANY
+* DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* -------------------------------------------------------------------------------*/
+
+
+#ifndef SAFE_MEMORY_DETAIL_BTREE_H
+#define SAFE_MEMORY_DETAIL_BTREE_H
+
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <safememory/detail/safe_ptr_common.h>
+#include <EASTL/algorithm.h>
+#include <EASTL/iterator.h>
+#include <EASTL/utility.h>
+#include <EASTL/internal/config.h> // for eastl_size_t
+
+/** \file
+ * \brief B-tree used as underlying implementation of \c safememory::map and \c safememory::set
+ * 
+ * Unlike \c eastl::rbtree that allocates one node per element, here every node keeps
+ * up to \c kNodeValues elements stored contiguously, so lookups and range scans touch
+ * a few cache lines per node instead of one node per element.
+ * 
+ * Nodes are allocated throught the same \a Allocator used by other containers
+ * (see allocator_to_eastl.h), and linked with \c Allocator::pointer, so \c soft_ptr to them
+ * can be created for heap safe iterators.
+ * Leaf nodes don't have room for children, inner nodes are a leaf plus the children array.
+ * 
+ * An empty tree doesn't allocate and has all members set to zero, so a zeroed instance
+ * is a valid empty tree, and destructor puts the instance back in such state.
+ * 
+ * As with any B-tree, insert and erase may move other elements between nodes, so they
+ * invalidate all iterators. Heap safe iterators will still be memory safe, since they
+ * check the node is alive and the position is in range.
+ */
+
+#ifndef SAFEMEMORY_BTREE_NODE_SIZE
+/// Target size in bytes of the elements stored in a single node.
+#define SAFEMEMORY_BTREE_NODE_SIZE 256
+#endif
+
+namespace safememory::detail {
+
+	template<class Value>
+	constexpr int btree_node_values() {
+		constexpr std::size_t n = SAFEMEMORY_BTREE_NODE_SIZE / sizeof(Value);
+		return n < 3 ? 3 : (n > 62 ? 62 : static_cast<int>(n));
+	}
+
+	template <typename Value, typename Allocator, int N>
+	struct btree_inner_node;
+
+	/**
+	 * \brief Leaf node, also the header of inner nodes
+	 */
+	template <typename Value, typename Allocator, int N>
+	struct btree_node
+	{
+		typedef Value                                           value_type;
+		typedef Allocator                                       allocator_type;
+		typedef btree_inner_node<Value, Allocator, N>           inner_node_type;
+		typedef typename allocator_type::template pointer<btree_node>  node_ptr;
+
+		static constexpr int kNodeValues = N;
+
+		node_ptr  mpParent;
+		uint16_t  mPosition = 0; // position of this node in its parent children
+		uint16_t  mCount = 0;
+		bool      mbLeaf = true;
+		alignas(value_type) unsigned char mValues[N * sizeof(value_type)];
+
+		explicit btree_node(bool leaf) : mbLeaf(leaf) {}
+
+		value_type* value_ptr(int i) { return reinterpret_cast<value_type*>(mValues) + i; }
+		const value_type* value_ptr(int i) const { return reinterpret_cast<const value_type*>(mValues) + i; }
+		value_type& value(int i) { return *value_ptr(i); }
+		const value_type& value(int i) const { return *value_ptr(i); }
+
+		btree_node* parent() const { return mpParent.get_raw_ptr(); }
+
+		const node_ptr& child_ptr(int i) const { return static_cast<const inner_node_type*>(this)->mpChildren[i]; }
+		btree_node* child(int i) const { return child_ptr(i).get_raw_ptr(); }
+
+		/// pointer to this node, as stored in the tree. Not available for a leaf root.
+		const node_ptr& self_ptr() const {
+			if(mpParent)
+				return parent()->child_ptr(mPosition);
+
+			NODECPP_ASSERT(module_id, nodecpp::assert::AssertLevel::regular, !mbLeaf);
+			return child(0)->mpParent;
+		}
+	};
+
+	template <typename Value, typename Allocator, int N>
+	struct btree_inner_node : public btree_node<Value, Allocator, N>
+	{
+		typedef btree_node<Value, Allocator, N>                 base_type;
+		typedef typename base_type::node_ptr                    node_ptr;
+
+		node_ptr mpChildren[N + 1];
+
+		btree_inner_node() : base_type(false) {}
+	};
+
+
+	/**
+	 * \brief Raw (unchecked) iterator, a node and a position inside such node.
+	 * 
+	 * The end iterator is one past the last value of the rightmost leaf,
+	 * or \c nullptr on an empty tree.
+	 */
+	template <typename Node, typename Pointer, typename Reference>
+	struct btree_iterator
+	{
+		typedef btree_iterator<Node, Pointer, Reference>                             this_type;
+		typedef btree_iterator<Node, typename Node::value_type*, typename Node::value_type&>  this_type_non_const;
+		typedef Node                                                                 node_type;
+		typedef typename Node::value_type                                            value_type;
+		typedef Pointer                                                              pointer;
+		typedef Reference                                                            reference;
+		typedef ptrdiff_t                                                            difference_type;
+		typedef EASTL_ITC_NS::bidirectional_iterator_tag                             iterator_category;
+
+		node_type* mpNode = nullptr;
+		int        mPosition = 0;
+
+		btree_iterator() {}
+		btree_iterator(node_type* node, int position) : mpNode(node), mPosition(position) {}
+		btree_iterator(const this_type_non_const& x) : mpNode(x.mpNode), mPosition(x.mPosition) {}
+
+		btree_iterator& operator=(const this_type_non_const& x) {
+			mpNode = x.mpNode;
+			mPosition = x.mPosition;
+			return *this;
+		}
+
+		reference operator*() const { return mpNode->value(mPosition); }
+		pointer operator->() const { return mpNode->value_ptr(mPosition); }
+
+		this_type& operator++() { increment(); return *this; }
+		this_type operator++(int) { this_type temp(*this); increment(); return temp; }
+
+		this_type& operator--() { decrement(); return *this; }
+		this_type operator--(int) { this_type temp(*this); decrement(); return temp; }
+
+		void increment() {
+			if(mpNode->mbLeaf) {
+				if(++mPosition < mpNode->mCount)
+					return;
+
+				node_type* n = mpNode;
+				int pos = mPosition;
+				while(pos == n->mCount && n->mpParent) {
+					pos = n->mPosition;
+					n = n->parent();
+				}
+				// if we got to the root, we were already at the last value, stay at end
+				if(pos < n->mCount) {
+					mpNode = n;
+					mPosition = pos;
+				}
+			}
+			else {
+				mpNode = mpNode->child(mPosition + 1);
+				while(!mpNode->mbLeaf)
+					mpNode = mpNode->child(0);
+				mPosition = 0;
+			}
+		}
+
+		void decrement() {
+			if(mpNode->mbLeaf) {
+				if(--mPosition >= 0)
+					return;
+
+				node_type* n = mpNode;
+				int pos = mPosition;
+				while(pos < 0 && n->mpParent) {
+					pos = n->mPosition - 1;
+					n = n->parent();
+				}
+				// decrement of begin, stay at begin
+				if(pos >= 0) {
+					mpNode = n;
+					mPosition = pos;
+				}
+				else
+					mPosition = 0;
+			}
+			else {
+				mpNode = mpNode->child(mPosition);
+				while(!mpNode->mbLeaf)
+					mpNode = mpNode->child(mpNode->mCount);
+				mPosition = mpNode->mCount - 1;
+			}
+		}
+
+		bool operator==(const this_type& other) const { return mpNode == other.mpNode && mPosition == other.mPosition; }
+		bool operator!=(const this_type& other) const { return !operator==(other); }
+
+		node_type* get_node() const { return mpNode; }
+		int get_position() const { return mPosition; }
+	};
+
+
+	/**
+	 * \brief B-tree with unique keys, \c ExtractKey gets the key from a value.
+	 */
+	template <typename Key, typename Value, typename Compare, typename Allocator, typename ExtractKey>
+	class btree
+	{
+	public:
+		typedef Key                                                                  key_type;
+		typedef Value                                                                value_type;
+		typedef Compare                                                              key_compare;
+		typedef Allocator                                                            allocator_type;
+		typedef ExtractKey                                                           extract_key;
+		typedef eastl_size_t                                                         size_type;
+		typedef ptrdiff_t                                                            difference_type;
+		typedef value_type&                                                          reference;
+		typedef const value_type&                                                    const_reference;
+
+		static constexpr size_type npos = static_cast<size_type>(-1);
+		static constexpr int kNodeValues = btree_node_values<value_type>();
+		static constexpr int kMinNodeValues = kNodeValues / 2;
+
+		typedef btree_node<value_type, allocator_type, kNodeValues>                  node_type;
+		typedef btree_inner_node<value_type, allocator_type, kNodeValues>            inner_node_type;
+		typedef typename node_type::node_ptr                                         node_ptr;
+		typedef typename allocator_type::template pointer<inner_node_type>           inner_node_ptr;
+
+		typedef btree_iterator<node_type, value_type*, value_type&>                  iterator;
+		typedef btree_iterator<node_type, const value_type*, const value_type&>      const_iterator;
+		typedef eastl::pair<iterator, bool>                                          insert_return_type;
+
+	protected:
+		node_ptr      mpRoot;
+		node_type*    mpLeftmost = nullptr;
+		node_type*    mpRightmost = nullptr;
+		size_type     mnSize = 0;
+		key_compare   mCompare;
+		allocator_type mAllocator;
+
+	public:
+		btree() {}
+		explicit btree(const key_compare& compare) : mCompare(compare) {}
+
+		btree(const btree& x) : mCompare(x.mCompare) {
+			for(const_iterator it = x.begin(), itEnd = x.end(); it != itEnd; ++it)
+				emplace_back_sorted(*it);
+		}
+
+		btree(btree&& x) : mCompare(x.mCompare) { swap(x); }
+
+		~btree() { clear(); }
+
+		btree& operator=(const btree& x) {
+			if(this != &x) {
+				clear();
+				mCompare = x.mCompare;
+				for(const_iterator it = x.begin(), itEnd = x.end(); it != itEnd; ++it)
+					emplace_back_sorted(*it);
+			}
+			return *this;
+		}
+
+		btree& operator=(btree&& x) {
+			if(this != &x) {
+				clear();
+				swap(x);
+			}
+			return *this;
+		}
+
+		void swap(btree& x) {
+			eastl::swap(mpRoot, x.mpRoot);
+			eastl::swap(mpLeftmost, x.mpLeftmost);
+			eastl::swap(mpRightmost, x.mpRightmost);
+			eastl::swap(mnSize, x.mnSize);
+			eastl::swap(mCompare, x.mCompare);
+		}
+
+		iterator       begin() noexcept { return {mpLeftmost, 0}; }
+		const_iterator begin() const noexcept { return {mpLeftmost, 0}; }
+		const_iterator cbegin() const noexcept { return {mpLeftmost, 0}; }
+
+		iterator       end() noexcept { return {mpRightmost, mpRightmost ? mpRightmost->mCount : 0}; }
+		const_iterator end() const noexcept { return {mpRightmost, mpRightmost ? mpRightmost->mCount : 0}; }
+		const_iterator cend() const noexcept { return end(); }
+
+		bool      empty() const noexcept { return mnSize == 0; }
+		size_type size() const noexcept { return mnSize; }
+
+		key_compare key_comp() const { return mCompare; }
+
+		void clear() {
+			if(mpRoot)
+				clear_subtree(mpRoot);
+
+			mpRoot = nullptr;
+			mpLeftmost = nullptr;
+			mpRightmost = nullptr;
+			mnSize = 0;
+		}
+
+		template <typename K>
+		iterator find(const K& key) {
+			node_type* n = mpRoot.get_raw_ptr();
+			while(n) {
+				int pos = lower_bound_in_node(n, key);
+				if(pos < n->mCount && !mCompare(key, extract_key()(n->value(pos))))
+					return {n, pos};
+				if(n->mbLeaf)
+					break;
+				n = n->child(pos);
+			}
+			return end();
+		}
+
+		template <typename K>
+		const_iterator find(const K& key) const { return const_cast<btree*>(this)->find(key); }
+
+		template <typename K>
+		iterator lower_bound(const K& key) {
+			iterator res = end();
+			node_type* n = mpRoot.get_raw_ptr();
+			while(n) {
+				int pos = lower_bound_in_node(n, key);
+				if(pos < n->mCount)
+					res = {n, pos};
+				if(n->mbLeaf)
+					break;
+				n = n->child(pos);
+			}
+			return res;
+		}
+
+		template <typename K>
+		const_iterator lower_bound(const K& key) const { return const_cast<btree*>(this)->lower_bound(key); }
+
+		template <typename K>
+		iterator upper_bound(const K& key) {
+			iterator res = end();
+			node_type* n = mpRoot.get_raw_ptr();
+			while(n) {
+				int pos = upper_bound_in_node(n, key);
+				if(pos < n->mCount)
+					res = {n, pos};
+				if(n->mbLeaf)
+					break;
+				n = n->child(pos);
+			}
+			return res;
+		}
+
+		template <typename K>
+		const_iterator upper_bound(const K& key) const { return const_cast<btree*>(this)->upper_bound(key); }
+
+		template <typename K>
+		eastl::pair<iterator, iterator> equal_range(const K& key) {
+			iterator it = find(key);
+			if(it == end())
+				return {it, it};
+			iterator next = it;
+			next.increment();
+			return {it, next};
+		}
+
+		template <typename K>
+		eastl::pair<const_iterator, const_iterator> equal_range(const K& key) const {
+			auto r = const_cast<btree*>(this)->equal_range(key);
+			return {r.first, r.second};
+		}
+
+		template <typename K>
+		size_type count(const K& key) const { return find(key) != end() ? 1 : 0; }
+
+		/// inserts a value constructed from \c args if \c key is not already there
+		template <typename K, typename... Args>
+		insert_return_type emplace_unique_key(const K& key, Args&&... args) {
+			node_type* n;
+			int pos;
+			if(find_insert_position(key, n, pos))
+				return { iterator(n, pos), false };
+			if(!n)
+				return { emplace_first(std::forward<Args>(args)...), true };
+			return { emplace_at(n, pos, std::forward<Args>(args)...), true };
+		}
+
+		/// as \c emplace_unique_key, but the value is constructed before the tree is modified,
+		/// so \c args may refer to values already in this tree
+		template <typename K, typename... Args>
+		insert_return_type emplace_unique_key_detached(const K& key, Args&&... args) {
+			node_type* n;
+			int pos;
+			if(find_insert_position(key, n, pos))
+				return { iterator(n, pos), false };
+			value_type value(std::forward<Args>(args)...);
+			if(!n)
+				return { emplace_first(std::move(value)), true };
+			return { emplace_at(n, pos, std::move(value)), true };
+		}
+
+		template <typename... Args>
+		insert_return_type emplace_unique(Args&&... args) {
+			// key must be known before we find where the value goes
+			value_type value(std::forward<Args>(args)...);
+			return emplace_unique_key(extract_key()(value), std::move(value));
+		}
+
+		insert_return_type insert_unique(const value_type& value) {
+			return emplace_unique_key(extract_key()(value), value);
+		}
+
+		insert_return_type insert_unique(value_type&& value) {
+			return emplace_unique_key(extract_key()(value), std::move(value));
+		}
+
+		iterator erase(const_iterator position) {
+			node_type* n = position.mpNode;
+			int pos = position.mPosition;
+
+			bool internal = !n->mbLeaf;
+			if(internal) {
+				// replace the value with the largest one from the left subtree,
+				// and remove that one from its leaf
+				node_type* leaf = n->child(pos);
+				while(!leaf->mbLeaf)
+					leaf = leaf->child(leaf->mCount);
+
+				n->value_ptr(pos)->~value_type();
+				relocate(n->value_ptr(pos), leaf->value_ptr(leaf->mCount - 1));
+				--leaf->mCount;
+				n = leaf;
+				pos = leaf->mCount;
+			}
+			else {
+				n->value_ptr(pos)->~value_type();
+				for(int i = pos + 1; i < n->mCount; ++i)
+					relocate(n->value_ptr(i - 1), n->value_ptr(i));
+				--n->mCount;
+			}
+			--mnSize;
+
+			iterator res = rebalance_after_erase(n, pos);
+			// the value we moved up from the leaf is previous to the one we are looking for
+			if(internal)
+				res.increment();
+			return res;
+		}
+
+		iterator erase(const_iterator first, const_iterator last) {
+			// erase invalidates iterators, so we count first
+			return erase(first, distance(first, last));
+		}
+
+		/// erases \c n values starting at \c first
+		iterator erase(const_iterator first, size_type n) {
+			iterator res(first.mpNode, first.mPosition);
+			for(; n != 0; --n)
+				res = erase(res);
+			return res;
+		}
+
+		/// number of values in [first, last), or \c npos if \c last is not reachable from \c first
+		size_type distance(const_iterator first, const_iterator last) const {
+			size_type n = 0;
+			const_iterator itEnd = end();
+			for(; first != last; first.increment(), ++n) {
+				// mb: a stale position would never reach last, bound the walk by the tree size
+				if(first == itEnd || n == mnSize || !first.mpNode || first.mPosition >= first.mpNode->mCount)
+					return npos;
+			}
+			return n;
+		}
+
+		template <typename K>
+		size_type erase_key(const K& key) {
+			iterator it = find(key);
+			if(it == end())
+				return 0;
+			erase(it);
+			return 1;
+		}
+
+		/// pointer to a node, as needed by heap safe iterators
+		node_ptr node_pointer(const node_type* n) const {
+			if(!n)
+				return nullptr;
+			return n->mpParent ? n->self_ptr() : mpRoot;
+		}
+
+		/// checks all tree invariants, intended for tests
+		bool validate() const {
+			if(!mpRoot)
+				return mnSize == 0 && !mpLeftmost && !mpRightmost;
+
+			node_type* r = mpRoot.get_raw_ptr();
+			if(r->mpParent || r->mCount == 0)
+				return false;
+
+			size_type count = 0;
+			int depth = -1;
+			if(!validate_subtree(r, 0, depth, count))
+				return false;
+
+			node_type* l = r;
+			while(!l->mbLeaf)
+				l = l->child(0);
+			node_type* rr = r;
+			while(!rr->mbLeaf)
+				rr = rr->child(rr->mCount);
+
+			if(l != mpLeftmost || rr != mpRightmost || count != mnSize)
+				return false;
+
+			for(const_iterator it = begin(), next = begin(); it != end(); it = next) {
+				next.increment();
+				if(next != end() && !mCompare(extract_key()(*it), extract_key()(*next)))
+					return false;
+			}
+			return true;
+		}
+
+		int validate_iterator(const_iterator it) const {
+			for(const_iterator i = begin(); i != end(); i.increment()) {
+				if(i == it)
+					return (eastl::isf_valid | eastl::isf_current | eastl::isf_can_dereference);
+			}
+
+			if(it == end())
+				return (eastl::isf_valid | eastl::isf_current);
+
+			return eastl::isf_none;
+		}
+
+	protected:
+		/// finds where \c key is, or the leaf position where it should be inserted.
+		/// \c n is \c nullptr for an empty tree.
+		template <typename K>
+		bool find_insert_position(const K& key, node_type*& n, int& pos) const {
+			n = mpRightmost;
+			if(!n)
+				return false;
+
+			// mb: ascending inserts are very common, go straight to the end
+			if(mCompare(extract_key()(n->value(n->mCount - 1)), key)) {
+				pos = n->mCount;
+				return false;
+			}
+
+			n = mpRoot.get_raw_ptr();
+			for(;;) {
+				pos = lower_bound_in_node(n, key);
+				if(pos < n->mCount && !mCompare(key, extract_key()(n->value(pos))))
+					return true;
+				if(n->mbLeaf)
+					return false;
+				n = n->child(pos);
+			}
+		}
+
+		template <typename K>
+		int lower_bound_in_node(const node_type* n, const K& key) const {
+			int lo = 0, hi = n->mCount;
+			while(lo != hi) {
+				int mid = (lo + hi) / 2;
+				if(mCompare(extract_key()(n->value(mid)), key))
+					lo = mid + 1;
+				else
+					hi = mid;
+			}
+			return lo;
+		}
+
+		template <typename K>
+		int upper_bound_in_node(const node_type* n, const K& key) const {
+			int lo = 0, hi = n->mCount;
+			while(lo != hi) {
+				int mid = (lo + hi) / 2;
+				if(mCompare(key, extract_key()(n->value(mid))))
+					hi = mid;
+				else
+					lo = mid + 1;
+			}
+			return lo;
+		}
+
+		static void relocate(value_type* dst, value_type* src) {
+			::new(dst) value_type(std::move(*src));
+			src->~value_type();
+		}
+
+		node_ptr allocate_node(bool leaf) {
+			if(leaf) {
+				node_ptr p = mAllocator.template allocate_node<node_type>();
+				::new(p.get_raw_ptr()) node_type(true);
+				return p;
+			}
+			else {
+				inner_node_ptr p = mAllocator.template allocate_node<inner_node_type>();
+				::new(p.get_raw_ptr()) inner_node_type();
+				return allocator_type::template static_pointer_cast<node_type>(p);
+			}
+		}
+
+		void deallocate_node(const node_ptr& p) {
+			if(p->mbLeaf)
+				mAllocator.template deallocate_node<node_type>(p);
+			else
+				mAllocator.template deallocate_node<inner_node_type>(allocator_type::template static_pointer_cast<inner_node_type>(p));
+		}
+
+		static void set_child(node_type* n, const node_ptr& self, int i, const node_ptr& c) {
+			static_cast<inner_node_type*>(n)->mpChildren[i] = c;
+			c->mpParent = self;
+			c->mPosition = static_cast<uint16_t>(i);
+		}
+
+		void clear_subtree(const node_ptr& p) {
+			node_type* n = p.get_raw_ptr();
+			for(int i = 0; i < n->mCount; ++i)
+				n->value_ptr(i)->~value_type();
+
+			if(!n->mbLeaf) {
+				for(int i = 0; i <= n->mCount; ++i)
+					clear_subtree(n->child_ptr(i));
+			}
+			deallocate_node(p);
+		}
+
+		template <typename... Args>
+		iterator emplace_first(Args&&... args) {
+			mpRoot = allocate_node(true);
+			mpLeftmost = mpRightmost = mpRoot.get_raw_ptr();
+#if EASTL_EXCEPTIONS_ENABLED
+			try {
+#endif
+				return emplace_at(mpLeftmost, 0, std::forward<Args>(args)...);
+#if EASTL_EXCEPTIONS_ENABLED
+			}
+			catch(...) {
+				clear();
+				throw;
+			}
+#endif
+		}
+
+		/// the value appended must be greater than any other already in the tree
+		template <typename... Args>
+		iterator emplace_back_sorted(Args&&... args) {
+			if(!mpRoot)
+				return emplace_first(std::forward<Args>(args)...);
+			return emplace_at(mpRightmost, mpRightmost->mCount, std::forward<Args>(args)...);
+		}
+
+		template <typename... Args>
+		iterator emplace_at(node_type* n, int pos, Args&&... args) {
+			if(n->mCount == kNodeValues)
+				split_node(n, pos);
+
+			for(int i = n->mCount; i > pos; --i)
+				relocate(n->value_ptr(i), n->value_ptr(i - 1));
+
+#if EASTL_EXCEPTIONS_ENABLED
+			try {
+#endif
+				::new(n->value_ptr(pos)) value_type(std::forward<Args>(args)...);
+#if EASTL_EXCEPTIONS_ENABLED
+			}
+			catch(...) {
+				for(int i = pos; i < n->mCount; ++i)
+					relocate(n->value_ptr(i), n->value_ptr(i + 1));
+				throw;
+			}
+#endif
+			++n->mCount;
+			++mnSize;
+			return {n, pos};
+		}
+
+		/// splits full node \c n, so a new value can be inserted at \c pos.
+		/// On return \c n and \c pos are updated to where such value must go.
+		void split_node(node_type*& n, int& pos) {
+			node_type* parent = n->parent();
+			if(!parent) {
+				node_ptr self = mpRoot;
+				mpRoot = allocate_node(false);
+				parent = mpRoot.get_raw_ptr();
+				set_child(parent, mpRoot, 0, self);
+			}
+			else if(parent->mCount == kNodeValues) {
+				int parentPos = n->mPosition;
+				split_node(parent, parentPos);
+				parent = n->parent();
+			}
+
+			// mb: when inserting at either end, don't split in half,
+			// so sequential inserts leave nodes full
+			int mid = kNodeValues / 2;
+			if(pos == kNodeValues)
+				mid = kNodeValues - 1;
+			else if(pos == 0)
+				mid = 0;
+
+			int count = n->mCount;
+			node_ptr parentPtr = node_pointer(parent);
+			node_ptr siblingPtr = allocate_node(n->mbLeaf);
+			node_type* sibling = siblingPtr.get_raw_ptr();
+
+			for(int i = mid + 1; i < count; ++i)
+				relocate(sibling->value_ptr(i - mid - 1), n->value_ptr(i));
+			sibling->mCount = static_cast<uint16_t>(count - mid - 1);
+
+			if(!n->mbLeaf) {
+				for(int i = mid + 1; i <= count; ++i)
+					set_child(sibling, siblingPtr, i - mid - 1, n->child_ptr(i));
+			}
+
+			// make room in parent for the median value and the new sibling
+			int p = n->mPosition;
+			for(int i = parent->mCount; i > p; --i)
+				relocate(parent->value_ptr(i), parent->value_ptr(i - 1));
+			for(int i = parent->mCount + 1; i > p + 1; --i)
+				set_child(parent, parentPtr, i, parent->child_ptr(i - 1));
+
+			relocate(parent->value_ptr(p), n->value_ptr(mid));
+			set_child(parent, parentPtr, p + 1, siblingPtr);
+			++parent->mCount;
+			n->mCount = static_cast<uint16_t>(mid);
+
+			if(n == mpRightmost)
+				mpRightmost = sibling;
+
+			if(pos > mid) {
+				n = sibling;
+				pos -= mid + 1;
+			}
+		}
+
+		iterator rebalance_after_erase(node_type* n, int pos) {
+			iterator res(n, pos);
+			bool first = true;
+			for(;;) {
+				if(!n->mpParent) {
+					shrink_root();
+					if(!mpRoot)
+						return end();
+					break;
+				}
+				if(n->mCount >= kMinNodeValues)
+					break;
+
+				bool merged = merge_or_rebalance(n, pos);
+				// values on the leaf may have moved
+				if(first) {
+					res = {n, pos};
+					first = false;
+				}
+				if(!merged)
+					break;
+
+				pos = n->mPosition;
+				n = n->parent();
+			}
+
+			if(res.mPosition == res.mpNode->mCount) {
+				res.mPosition = res.mpNode->mCount - 1;
+				res.increment();
+			}
+			return res;
+		}
+
+		void shrink_root() {
+			node_type* r = mpRoot.get_raw_ptr();
+			if(r->mCount != 0)
+				return;
+
+			if(r->mbLeaf) {
+				deallocate_node(mpRoot);
+				mpRoot = nullptr;
+				mpLeftmost = nullptr;
+				mpRightmost = nullptr;
+			}
+			else {
+				node_ptr child = r->child_ptr(0);
+				deallocate_node(mpRoot);
+				mpRoot = child;
+				child->mpParent = nullptr;
+				child->mPosition = 0;
+			}
+		}
+
+		/// merges or moves values from siblings into underflowed node \c n,
+		/// \c n and \c pos keep track of the same value.
+		/// Returns \c true if parent lost a value and may need rebalance.
+		bool merge_or_rebalance(node_type*& n, int& pos) {
+			node_type* parent = n->parent();
+			int p = n->mPosition;
+
+			if(p > 0) {
+				node_type* left = parent->child(p - 1);
+				if(1 + left->mCount + n->mCount <= kNodeValues) {
+					pos += 1 + left->mCount;
+					merge_nodes(left, n);
+					n = left;
+					return true;
+				}
+			}
+
+			if(p < parent->mCount) {
+				node_type* right = parent->child(p + 1);
+				if(1 + n->mCount + right->mCount <= kNodeValues) {
+					merge_nodes(n, right);
+					return true;
+				}
+
+				// mb: when erasing from the front don't rebalance,
+				// values would be moved just to be erased
+				if(right->mCount > kMinNodeValues && (n->mCount == 0 || pos > 0)) {
+					int toMove = eastl::min((right->mCount - n->mCount) / 2, right->mCount - 1);
+					move_right_to_left(n, right, toMove);
+					return false;
+				}
+			}
+
+			if(p > 0) {
+				node_type* left = parent->child(p - 1);
+				if(left->mCount > kMinNodeValues && (n->mCount == 0 || pos < n->mCount)) {
+					int toMove = eastl::min((left->mCount - n->mCount) / 2, left->mCount - 1);
+					move_left_to_right(left, n, toMove);
+					pos += toMove;
+					return false;
+				}
+			}
+
+			return false;
+		}
+
+		/// appends separator and all values from \c right into \c left, and deallocates \c right
+		void merge_nodes(node_type* left, node_type* right) {
+			node_type* parent = left->parent();
+			int p = left->mPosition;
+			int count = left->mCount;
+
+			relocate(left->value_ptr(count), parent->value_ptr(p));
+			for(int i = 0; i < right->mCount; ++i)
+				relocate(left->value_ptr(count + 1 + i), right->value_ptr(i));
+
+			if(!left->mbLeaf) {
+				node_ptr leftPtr = parent->child_ptr(p);
+				for(int i = 0; i <= right->mCount; ++i)
+					set_child(left, leftPtr, count + 1 + i, right->child_ptr(i));
+			}
+
+			left->mCount = static_cast<uint16_t>(count + 1 + right->mCount);
+			right->mCount = 0;
+
+			node_ptr rightPtr = parent->child_ptr(p + 1);
+			node_ptr parentPtr = node_pointer(parent);
+			for(int i = p + 1; i < parent->mCount; ++i)
+				relocate(parent->value_ptr(i - 1), parent->value_ptr(i));
+			for(int i = p + 2; i <= parent->mCount; ++i)
+				set_child(parent, parentPtr, i - 1, parent->child_ptr(i));
+			--parent->mCount;
+
+			if(right == mpRightmost)
+				mpRightmost = left;
+
+			deallocate_node(rightPtr);
+		}
+
+		/// moves \c k values from \c right to its left sibling \c n, throught the parent
+		void move_right_to_left(node_type* n, node_type* right, int k) {
+			node_type* parent = n->parent();
+			int p = n->mPosition;
+			int count = n->mCount;
+
+			relocate(n->value_ptr(count), parent->value_ptr(p));
+			for(int i = 0; i < k - 1; ++i)
+				relocate(n->value_ptr(count + 1 + i), right->value_ptr(i));
+			relocate(parent->value_ptr(p), right->value_ptr(k - 1));
+			for(int i = k; i < right->mCount; ++i)
+				relocate(right->value_ptr(i - k), right->value_ptr(i));
+
+			if(!n->mbLeaf) {
+				node_ptr nPtr = parent->child_ptr(p);
+				node_ptr rightPtr = parent->child_ptr(p + 1);
+				for(int i = 0; i < k; ++i)
+					set_child(n, nPtr, count + 1 + i, right->child_ptr(i));
+				for(int i = k; i <= right->mCount; ++i)
+					set_child(right, rightPtr, i - k, right->child_ptr(i));
+			}
+
+			n->mCount = static_cast<uint16_t>(count + k);
+			right->mCount = static_cast<uint16_t>(right->mCount - k);
+		}
+
+		/// moves \c k values from \c left to its right sibling \c n, throught the parent
+		void move_left_to_right(node_type* left, node_type* n, int k) {
+			node_type* parent = n->parent();
+			int p = left->mPosition;
+			int count = n->mCount;
+			int leftCount = left->mCount;
+
+			for(int i = count - 1; i >= 0; --i)
+				relocate(n->value_ptr(i + k), n->value_ptr(i));
+			relocate(n->value_ptr(k - 1), parent->value_ptr(p));
+			for(int i = 0; i < k - 1; ++i)
+				relocate(n->value_ptr(i), left->value_ptr(leftCount - k + 1 + i));
+			relocate(parent->value_ptr(p), left->value_ptr(leftCount - k));
+
+			if(!n->mbLeaf) {
+				node_ptr nPtr = parent->child_ptr(p + 1);
+				for(int i = count; i >= 0; --i)
+					set_child(n, nPtr, i + k, n->child_ptr(i));
+				for(int i = 0; i < k; ++i)
+					set_child(n, nPtr, i, left->child_ptr(leftCount - k + 1 + i));
+			}
+
+			n->mCount = static_cast<uint16_t>(count + k);
+			left->mCount = static_cast<uint16_t>(leftCount - k);
+		}
+
+		bool validate_subtree(const node_type* n, int level, int& leafLevel, size_type& count) const {
+			if(n->mCount > kNodeValues)
+				return false;
+			count += n->mCount;
+
+			if(n->mbLeaf) {
+				if(leafLevel == -1)
+					leafLevel = level;
+				return leafLevel == level;
+			}
+
+			for(int i = 0; i <= n->mCount; ++i) {
+				const node_type* c = n->child(i);
+				if(c->parent() != n || c->mPosition != i || c->mCount == 0)
+					return false;
+				if(i < n->mCount && mCompare(extract_key()(n->value(i)), extract_key()(c->value(c->mCount - 1))))
+					return false;
+				if(i > 0 && mCompare(extract_key()(c->value(0)), extract_key()(n->value(i - 1))))
+					return false;
+				if(!validate_subtree(c, level + 1, leafLevel, count))
+					return false;
+			}
+			return true;
+		}
+	}; // btree
+
+} // namespace safememory::detail
+
+#endif // SAFE_MEMORY_DETAIL_BTREE_H
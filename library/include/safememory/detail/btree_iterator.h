@@ -0,0 +1,316 @@
+/* -------------------------------------------------------------------------------
+* Copyright (c) 2020, OLogN Technologies AG
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of the OLogN Technologies AG nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL OLogN Technologies AG BE LIABLE FOR ANY
+* DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* -------------------------------------------------------------------------------*/
+
+
+#ifndef SAFE_MEMORY_DETAIL_BTREE_ITERATOR_H
+#define SAFE_MEMORY_DETAIL_BTREE_ITERATOR_H
+
+#include <safememory/detail/instrument.h>
+#include <safe_memory_error.h>
+
+namespace safememory::detail {
+
+	/**
+	 * \brief Iterator wrapper for \c btree stack only iterators
+	 */
+	template <typename BaseIt, typename BaseNonConstIt, typename Allocator>
+	class btree_stack_only_iterator : protected BaseIt
+	{
+	public:
+		typedef BaseIt                                                   base_type;
+		typedef Allocator                                                allocator_type;
+		typedef btree_stack_only_iterator<BaseIt, BaseNonConstIt, Allocator>          this_type;
+		typedef btree_stack_only_iterator<BaseNonConstIt, BaseNonConstIt, Allocator>  this_type_non_const;
+
+		typedef typename base_type::node_type                            node_type;
+		typedef typename base_type::value_type                           value_type;
+		typedef typename base_type::pointer                              pointer;
+		typedef typename base_type::reference                            reference;
+		typedef typename base_type::difference_type                      difference_type;
+		typedef typename base_type::iterator_category                    iterator_category;
+
+	    static constexpr memory_safety is_safe = allocator_type::is_safe;
+
+	    static constexpr bool is_const = !std::is_same_v<this_type, this_type_non_const>;
+
+		template <typename, typename, typename>
+		friend class btree_stack_only_iterator;
+
+		template<typename TT>
+		static constexpr bool sfinae = is_const && std::is_same_v<TT, this_type_non_const>;
+
+		[[noreturn]] static void ThrowRangeException() { throw nodecpp::error::out_of_range; }
+		[[noreturn]] static void ThrowNullException() { throw nodecpp::error::zero_pointer_access; }
+
+    public:
+		btree_stack_only_iterator() :base_type() { }
+
+		btree_stack_only_iterator(const this_type&) = default;
+		btree_stack_only_iterator& operator=(const btree_stack_only_iterator& ri) = default;
+
+		btree_stack_only_iterator(btree_stack_only_iterator&& ri) = default; 
+		btree_stack_only_iterator& operator=(btree_stack_only_iterator&& ri) = default;
+
+		~btree_stack_only_iterator() = default;
+
+		template<typename Other, std::enable_if_t<sfinae<Other>, bool> = true>
+		btree_stack_only_iterator(const Other& other)
+			: base_type(other) { }
+
+		template<typename Other, std::enable_if_t<sfinae<Other>, bool> = true>
+		btree_stack_only_iterator& operator=(const Other& other) {
+			base_type::operator=(static_cast<const typename Other::base_type&>(other));
+			return *this;
+		}
+
+		reference operator*() const {
+			checkDerefenceable();
+			return base_type::operator*();
+		}
+
+		pointer operator->() const {
+			checkDerefenceable();
+			return base_type::operator->();
+		}
+
+		this_type& operator++() {
+			checkDerefenceable();
+			base_type::increment();
+			return *this;
+		}
+
+		this_type operator++(int) {
+			this_type temp(*this);
+			operator++();
+			return temp;
+		}
+
+		this_type& operator--() {
+			checkDecrementable();
+			base_type::decrement();
+			return *this;
+		}
+
+		this_type operator--(int) {
+			this_type temp(*this);
+			operator--();
+			return temp;
+		}
+
+		bool operator==(const this_type& other) const {
+			return base_type::operator==(other);
+		}
+		bool operator!=(const this_type& other) const {
+			return base_type::operator!=(other);
+		}
+
+		void checkDerefenceable() const {
+			if(NODECPP_UNLIKELY(!base_type::mpNode))
+				ThrowNullException();
+
+#ifdef SAFEMEMORY_DEZOMBIEFY_ITERATORS
+			checkNotZombie(base_type::mpNode);
+#endif
+			if(NODECPP_UNLIKELY(base_type::mPosition >= base_type::mpNode->mCount))
+				ThrowRangeException();
+		}
+
+		void checkDecrementable() const {
+			if(NODECPP_UNLIKELY(!base_type::mpNode))
+				ThrowNullException();
+
+#ifdef SAFEMEMORY_DEZOMBIEFY_ITERATORS
+			checkNotZombie(base_type::mpNode);
+#endif
+			// end is one past the last value of a leaf
+			if(NODECPP_UNLIKELY(base_type::mPosition > base_type::mpNode->mCount))
+				ThrowRangeException();
+		}
+
+		// mb: unlike hashtable, null is a valid base iterator, end of an empty tree
+		const base_type& toBase() const { return *this; }
+
+		static this_type& fromBase(base_type& b) { return static_cast<this_type&>(b); }
+		static const this_type& fromBase(const base_type& b) { return static_cast<const this_type&>(b); }
+	}; // btree_stack_only_iterator
+
+
+	/**
+	 * \brief Iterator for \c btree heap safe iterators
+	 * 
+	 * Keeps a \c soft_ptr to the node, so it will throw instead of touching
+	 * a node that was deallocated. Since inserts and erases may move values
+	 * between nodes, position is checked against node count on every access.
+	 */
+	template <typename BaseIt, typename BaseNonConstIt, typename Allocator>
+	class btree_heap_safe_iterator : protected BaseIt
+	{
+	public:
+		typedef BaseIt                                                   base_type;
+		typedef Allocator                                                allocator_type;
+		typedef btree_heap_safe_iterator<BaseIt, BaseNonConstIt, Allocator>          this_type;
+		typedef btree_heap_safe_iterator<BaseNonConstIt, BaseNonConstIt, Allocator>  this_type_non_const;
+
+		typedef typename base_type::node_type                            node_type;
+		typedef typename base_type::value_type                           value_type;
+		typedef typename base_type::pointer                              pointer;
+		typedef typename base_type::reference                            reference;
+		typedef typename base_type::difference_type                      difference_type;
+		typedef typename base_type::iterator_category                    iterator_category;
+
+	    static constexpr memory_safety is_safe = allocator_type::is_safe;
+
+	    static constexpr bool is_const = !std::is_same_v<this_type, this_type_non_const>;
+
+		template <typename, typename, typename>
+		friend class btree_heap_safe_iterator;
+
+		template<typename TT>
+		static constexpr bool sfinae = is_const && std::is_same_v<TT, this_type_non_const>;
+
+		typedef typename allocator_type::template pointer<node_type>                  zero_node_ptr;
+        typedef typename allocator_type::template soft_pointer<node_type>             soft_node_ptr;
+
+		soft_node_ptr    mpSoftNode;
+
+		[[noreturn]] static void ThrowRangeException() { throw nodecpp::error::out_of_range; }
+		[[noreturn]] static void ThrowNullException() { throw nodecpp::error::zero_pointer_access; }
+
+		btree_heap_safe_iterator(const BaseIt& it, const zero_node_ptr& node)
+			: base_type(it), mpSoftNode(allocator_type::to_soft(node)) { }
+
+    public:
+
+		/// \c node must be the pointer to \c it node, as stored in the tree
+        static this_type makeIt(const BaseIt& it, const zero_node_ptr& node) {
+			NODECPP_ASSERT(module_id, nodecpp::assert::AssertLevel::regular, it.get_node() == node.get_raw_ptr());
+			return { it, node };
+        }
+
+		btree_heap_safe_iterator() :base_type() { }
+
+		btree_heap_safe_iterator(const this_type&) = default;
+		btree_heap_safe_iterator& operator=(const btree_heap_safe_iterator& ri) = default;
+
+		btree_heap_safe_iterator(btree_heap_safe_iterator&& ri) = default; 
+		btree_heap_safe_iterator& operator=(btree_heap_safe_iterator&& ri) = default;
+
+		~btree_heap_safe_iterator() = default;
+
+		template<typename Other, std::enable_if_t<sfinae<Other>, bool> = true>
+		btree_heap_safe_iterator(const Other& other)
+			: base_type(other), mpSoftNode(other.mpSoftNode) { }
+
+		template<typename Other, std::enable_if_t<sfinae<Other>, bool> = true>
+		btree_heap_safe_iterator& operator=(const Other& other) {
+			base_type::operator=(static_cast<const typename Other::base_type&>(other));
+			this->mpSoftNode = other.mpSoftNode;
+			return *this;
+		}
+
+		reference operator*() const {
+			checkDerefenceable();
+			return base_type::operator*();
+		}
+
+		pointer operator->() const {
+			checkDerefenceable();
+			return base_type::operator->();
+		}
+
+		this_type& operator++() {
+			checkDerefenceable();
+			node_type* prev = base_type::mpNode;
+			base_type::increment();
+			setSoftNode(prev);
+			return *this;
+		}
+
+		this_type operator++(int) {
+			this_type temp(*this);
+			operator++();
+			return temp;
+		}
+
+		this_type& operator--() {
+			checkDecrementable();
+			node_type* prev = base_type::mpNode;
+			base_type::decrement();
+			setSoftNode(prev);
+			return *this;
+		}
+
+		this_type operator--(int) {
+			this_type temp(*this);
+			operator--();
+			return temp;
+		}
+
+		bool operator==(const this_type& other) const {
+			return base_type::operator==(other);
+		}
+		bool operator!=(const this_type& other) const {
+			return base_type::operator!=(other);
+		}
+
+		void checkDerefenceable() const {
+			if(NODECPP_UNLIKELY(!base_type::mpNode))
+				ThrowNullException();
+
+			checkNotInvalidated(mpSoftNode);
+
+			if(NODECPP_UNLIKELY(base_type::mPosition >= base_type::mpNode->mCount))
+				ThrowRangeException();
+		}
+
+		void checkDecrementable() const {
+			if(NODECPP_UNLIKELY(!base_type::mpNode))
+				ThrowNullException();
+
+			checkNotInvalidated(mpSoftNode);
+
+			if(NODECPP_UNLIKELY(base_type::mPosition > base_type::mpNode->mCount))
+				ThrowRangeException();
+		}
+
+		void setSoftNode(const node_type* prev) {
+			// a leaf root never changes node, and it is the only one without self_ptr
+			if(base_type::mpNode != prev)
+				mpSoftNode = allocator_type::to_soft(base_type::mpNode->self_ptr());
+		}
+
+		// mb: unlike hashtable, null is a valid base iterator, end of an empty tree
+		const base_type& toBase() const {
+			if(base_type::mpNode)
+				checkNotInvalidated(mpSoftNode);
+			
+			return *this;
+		}
+	}; // btree_heap_safe_iterator
+} // namespace safememory::detail 
+
+#endif // SAFE_MEMORY_DETAIL_BTREE_ITERATOR_H
@@ -0,0 +1,466 @@
+/* -------------------------------------------------------------------------------
+* Copyright (c) 2020, OLogN Technologies AG
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of the OLogN Technologies AG nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL OLogN Technologies AG BE LIABLE FOR ANY
+* DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* -------------------------------------------------------------------------------*/
+
+
+
+#ifndef SAFE_MEMORY_DETAIL_CIRCULAR_BUFFER_H
+#define SAFE_MEMORY_DETAIL_CIRCULAR_BUFFER_H
+
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <safememory/detail/safe_ptr_common.h>
+#include <safememory/detail/flexible_array.h>
+#include <EASTL/algorithm.h>
+#include <EASTL/iterator.h>
+#include <EASTL/internal/config.h> // for eastl_size_t
+
+/** \file
+ * \brief Circular buffer used as underlying implementation of \c safememory::deque
+ * and \c safememory::ring_buffer
+ * 
+ * Elements are kept in a single array allocated with \c Allocator::allocate_array,
+ * starting at \c mBegin and wrapping around at the end of the array.
+ * So push and pop at both ends are O(1) and element access is a single index
+ * calculation, and since there is only one array, heap safe iterators need a single
+ * \c soft_ptr to it.
+ * 
+ * Unlike \c eastl::deque that allocates a subarray even when empty, an empty buffer
+ * doesn't allocate and has all members set to zero, so a zeroed instance is a valid
+ * empty buffer, and destructor puts the instance back in such state.
+ * 
+ * Growing reallocates the array, so it invalidates all iterators, the same as
+ * \c vector does. Heap safe iterators will still be memory safe, since they check
+ * the array is alive.
+ */
+
+namespace safememory::detail {
+
+	/**
+	 * \brief Raw (unchecked) iterator, the array, the position of the first element
+	 * when the iterator was created and an index relative to it.
+	 * 
+	 * Since \c mBegin is always lower than capacity and \c mIndex is lower or equal
+	 * than size, a single wrap around is enought to get the physical position.
+	 */
+	template <typename T, typename Pointer, typename Reference>
+	struct circular_buffer_iterator
+	{
+		typedef circular_buffer_iterator<T, Pointer, Reference>      this_type;
+		typedef circular_buffer_iterator<T, T*, T&>                  this_type_non_const;
+		typedef flexible_array<T>                                    array_type;
+		typedef T                                                    value_type;
+		typedef Pointer                                              pointer;
+		typedef Reference                                            reference;
+		typedef eastl_size_t                                         size_type;
+		typedef eastl_ssize_t                                        difference_type;
+		typedef EASTL_ITC_NS::random_access_iterator_tag             iterator_category;
+
+		array_type* mpArray = nullptr;
+		size_type   mBegin = 0;
+		size_type   mIndex = 0;
+
+		circular_buffer_iterator() {}
+		circular_buffer_iterator(array_type* arr, size_type begin, size_type index)
+			: mpArray(arr), mBegin(begin), mIndex(index) {}
+		circular_buffer_iterator(const this_type_non_const& x)
+			: mpArray(x.mpArray), mBegin(x.mBegin), mIndex(x.mIndex) {}
+
+		circular_buffer_iterator& operator=(const this_type_non_const& x) {
+			mpArray = x.mpArray;
+			mBegin = x.mBegin;
+			mIndex = x.mIndex;
+			return *this;
+		}
+
+		size_type get_physical(size_type index) const {
+			size_type pos = mBegin + index;
+			size_type cap = mpArray->size();
+			return pos >= cap ? pos - cap : pos;
+		}
+
+		pointer get_ptr(size_type index) const { return mpArray->data() + get_physical(index); }
+
+		reference operator*() const { return *get_ptr(mIndex); }
+		pointer operator->() const { return get_ptr(mIndex); }
+		reference operator[](difference_type n) const { return *get_ptr(mIndex + n); }
+
+		this_type& operator++() { ++mIndex; return *this; }
+		this_type operator++(int) { this_type temp(*this); ++mIndex; return temp; }
+
+		this_type& operator--() { --mIndex; return *this; }
+		this_type operator--(int) { this_type temp(*this); --mIndex; return temp; }
+
+		this_type& operator+=(difference_type n) { mIndex += n; return *this; }
+		this_type& operator-=(difference_type n) { mIndex -= n; return *this; }
+
+		this_type operator+(difference_type n) const { return {mpArray, mBegin, mIndex + n}; }
+		this_type operator-(difference_type n) const { return {mpArray, mBegin, mIndex - n}; }
+
+		difference_type operator-(const this_type& other) const {
+			return static_cast<difference_type>(mIndex - other.mIndex);
+		}
+
+		bool operator==(const this_type& other) const { return mpArray == other.mpArray && mIndex == other.mIndex; }
+		bool operator!=(const this_type& other) const { return !operator==(other); }
+		bool operator<(const this_type& other) const { return mIndex < other.mIndex; }
+		bool operator>(const this_type& other) const { return other.mIndex < mIndex; }
+		bool operator<=(const this_type& other) const { return !(other.mIndex < mIndex); }
+		bool operator>=(const this_type& other) const { return !(mIndex < other.mIndex); }
+
+		array_type* get_array() const { return mpArray; }
+		size_type get_index() const { return mIndex; }
+	};
+
+	template <typename T, typename Pointer, typename Reference>
+	inline circular_buffer_iterator<T, Pointer, Reference>
+	operator+(eastl_ssize_t n, const circular_buffer_iterator<T, Pointer, Reference>& it) {
+		return it + n;
+	}
+
+
+	/**
+	 * \brief Array of elements with wrap around, growth policy is left to derived classes.
+	 */
+	template <typename T, typename Allocator>
+	class circular_buffer
+	{
+	public:
+		typedef T                                                                    value_type;
+		typedef Allocator                                                            allocator_type;
+		typedef eastl_size_t                                                         size_type;
+		typedef eastl_ssize_t                                                        difference_type;
+		typedef value_type&                                                          reference;
+		typedef const value_type&                                                    const_reference;
+
+		typedef flexible_array<T>                                                    array_type;
+		typedef typename allocator_type::template array_pointer<T>                   array_pointer;
+
+		typedef circular_buffer_iterator<T, T*, T&>                                  iterator;
+		typedef circular_buffer_iterator<T, const T*, const T&>                      const_iterator;
+
+		static constexpr size_type npos = static_cast<size_type>(-1);
+		static constexpr size_type kMinCapacity = 8;
+
+	protected:
+		array_pointer  mpArray;
+		size_type      mBegin = 0;
+		size_type      mSize = 0;
+		allocator_type mAllocator;
+
+	public:
+		circular_buffer() {}
+
+		circular_buffer(const circular_buffer& x) {
+			if(x.mSize != 0) {
+				reallocate(x.mSize);
+				for(size_type i = 0; i != x.mSize; ++i)
+					emplace_back_unchecked(x.at_unchecked(i));
+			}
+		}
+
+		circular_buffer(circular_buffer&& x) { swap(x); }
+
+		~circular_buffer() { free_array(); }
+
+		circular_buffer& operator=(const circular_buffer& x) {
+			if(this != &x) {
+				clear();
+				if(capacity() < x.mSize)
+					reallocate(x.mSize);
+				for(size_type i = 0; i != x.mSize; ++i)
+					emplace_back_unchecked(x.at_unchecked(i));
+			}
+			return *this;
+		}
+
+		circular_buffer& operator=(circular_buffer&& x) {
+			if(this != &x) {
+				free_array();
+				swap(x);
+			}
+			return *this;
+		}
+
+		void swap(circular_buffer& x) {
+			eastl::swap(mpArray, x.mpArray);
+			eastl::swap(mBegin, x.mBegin);
+			eastl::swap(mSize, x.mSize);
+		}
+
+		iterator       begin() noexcept { return {mpArray.get_raw_ptr(), mBegin, 0}; }
+		const_iterator begin() const noexcept { return {mpArray.get_raw_ptr(), mBegin, 0}; }
+		const_iterator cbegin() const noexcept { return begin(); }
+
+		iterator       end() noexcept { return {mpArray.get_raw_ptr(), mBegin, mSize}; }
+		const_iterator end() const noexcept { return {mpArray.get_raw_ptr(), mBegin, mSize}; }
+		const_iterator cend() const noexcept { return end(); }
+
+		bool      empty() const noexcept { return mSize == 0; }
+		size_type size() const noexcept { return mSize; }
+		size_type capacity() const noexcept { return mpArray ? mpArray->size() : 0; }
+		bool      full() const noexcept { return mSize == capacity(); }
+
+		reference       at_unchecked(size_type n) { return *slot(n); }
+		const_reference at_unchecked(size_type n) const { return *slot(n); }
+
+		const array_pointer& array_ptr() const noexcept { return mpArray; }
+
+		void clear() {
+			for(size_type i = 0; i != mSize; ++i)
+				slot(i)->~value_type();
+
+			mBegin = 0;
+			mSize = 0;
+		}
+
+		/// moves all elements to a new array of \c n capacity, \c n must be at least \c size()
+		void reallocate(size_type n) {
+			NODECPP_ASSERT(module_id, nodecpp::assert::AssertLevel::regular, n >= mSize);
+
+			array_pointer pNew = n != 0 ? mAllocator.template allocate_array<T>(n) : array_pointer();
+			relocate_to(pNew, 0, n);
+			mBegin = 0;
+		}
+
+		/// constructs at the back, there must be room for it
+		template <typename... Args>
+		reference emplace_back_unchecked(Args&&... args) {
+			NODECPP_ASSERT(module_id, nodecpp::assert::AssertLevel::regular, mSize < capacity());
+
+			value_type* p = slot(mSize);
+			::new(static_cast<void*>(p)) value_type(std::forward<Args>(args)...);
+			++mSize;
+			return *p;
+		}
+
+		/// constructs at the front, there must be room for it
+		template <typename... Args>
+		reference emplace_front_unchecked(Args&&... args) {
+			NODECPP_ASSERT(module_id, nodecpp::assert::AssertLevel::regular, mSize < capacity());
+
+			size_type newBegin = mBegin != 0 ? mBegin - 1 : capacity() - 1;
+			value_type* p = data() + newBegin;
+			::new(static_cast<void*>(p)) value_type(std::forward<Args>(args)...);
+			mBegin = newBegin;
+			++mSize;
+			return *p;
+		}
+
+		/// grows to \c n capacity and constructs at the back, arguments may reference an element
+		template <typename... Args>
+		reference realloc_emplace_back(size_type n, Args&&... args) {
+			array_pointer pNew = mAllocator.template allocate_array<T>(n);
+			value_type* p = allocator_type::to_raw(pNew) + mSize;
+			construct_or_free(pNew, n, p, std::forward<Args>(args)...);
+			relocate_to(pNew, 0, n, p);
+			mBegin = 0;
+			++mSize;
+			return *p;
+		}
+
+		/// grows to \c n capacity and constructs at the front, arguments may reference an element
+		template <typename... Args>
+		reference realloc_emplace_front(size_type n, Args&&... args) {
+			array_pointer pNew = mAllocator.template allocate_array<T>(n);
+			value_type* p = allocator_type::to_raw(pNew) + (n - 1);
+			construct_or_free(pNew, n, p, std::forward<Args>(args)...);
+			// elements go at [0, mSize), the new one wraps around as the first
+			relocate_to(pNew, 0, n, p);
+			mBegin = n - 1;
+			++mSize;
+			return *p;
+		}
+
+		/// buffer is full, the front element is overwritten and becomes the back
+		template <typename... Args>
+		reference emplace_back_overwrite(Args&&... args) {
+			NODECPP_ASSERT(module_id, nodecpp::assert::AssertLevel::regular, mSize != 0 && mSize == capacity());
+
+			value_type* p = slot(0);
+			*p = value_type(std::forward<Args>(args)...);
+			mBegin = next(mBegin);
+			return *p;
+		}
+
+		/// buffer is full, the back element is overwritten and becomes the front
+		template <typename... Args>
+		reference emplace_front_overwrite(Args&&... args) {
+			NODECPP_ASSERT(module_id, nodecpp::assert::AssertLevel::regular, mSize != 0 && mSize == capacity());
+
+			value_type* p = slot(mSize - 1);
+			*p = value_type(std::forward<Args>(args)...);
+			mBegin = p - data();
+			return *p;
+		}
+
+		void pop_back() {
+			NODECPP_ASSERT(module_id, nodecpp::assert::AssertLevel::regular, mSize != 0);
+			slot(mSize - 1)->~value_type();
+			--mSize;
+		}
+
+		void pop_front() {
+			NODECPP_ASSERT(module_id, nodecpp::assert::AssertLevel::regular, mSize != 0);
+			slot(0)->~value_type();
+			mBegin = next(mBegin);
+			--mSize;
+		}
+
+		/// inserts at \c pos shifting the shorter side, there must be room for one more element
+		template <typename... Args>
+		size_type emplace_at(size_type pos, Args&&... args) {
+			NODECPP_ASSERT(module_id, nodecpp::assert::AssertLevel::regular, pos <= mSize);
+
+			if(pos == mSize) {
+				emplace_back_unchecked(std::forward<Args>(args)...);
+				return pos;
+			}
+			else if(pos == 0) {
+				emplace_front_unchecked(std::forward<Args>(args)...);
+				return pos;
+			}
+
+			// args may reference an element that is about to move
+			value_type value(std::forward<Args>(args)...);
+
+			if(pos < mSize / 2) {
+				emplace_front_unchecked(std::move(at_unchecked(0)));
+				for(size_type i = 1; i != pos; ++i)
+					at_unchecked(i) = std::move(at_unchecked(i + 1));
+			}
+			else {
+				emplace_back_unchecked(std::move(at_unchecked(mSize - 1)));
+				for(size_type i = mSize - 2; i != pos; --i)
+					at_unchecked(i) = std::move(at_unchecked(i - 1));
+			}
+			at_unchecked(pos) = std::move(value);
+			return pos;
+		}
+
+		/// erases [first, last) shifting the shorter side
+		void erase_range(size_type first, size_type last) {
+			NODECPP_ASSERT(module_id, nodecpp::assert::AssertLevel::regular, first <= last && last <= mSize);
+
+			size_type n = last - first;
+			if(n == 0)
+				return;
+
+			if(first < mSize - last) {
+				for(size_type i = first; i != 0; --i)
+					at_unchecked(i - 1 + n) = std::move(at_unchecked(i - 1));
+				for(size_type i = 0; i != n; ++i)
+					pop_front();
+			}
+			else {
+				for(size_type i = last; i != mSize; ++i)
+					at_unchecked(i - n) = std::move(at_unchecked(i));
+				for(size_type i = 0; i != n; ++i)
+					pop_back();
+			}
+		}
+
+		/// drops elements from the front until only \c n remain
+		void truncate_front(size_type n) {
+			while(mSize > n)
+				pop_front();
+		}
+
+		/// drops elements from the back until only \c n remain
+		void truncate_back(size_type n) {
+			while(mSize > n)
+				pop_back();
+		}
+
+		/// index of \c it, or \c npos if it doesn't point to this buffer
+		size_type index_of(const const_iterator& it) const noexcept {
+			if(it.mpArray != mpArray.get_raw_ptr() || it.mBegin != mBegin || it.mIndex > mSize)
+				return npos;
+			return it.mIndex;
+		}
+
+	protected:
+		value_type* data() const noexcept { return allocator_type::to_raw(mpArray); }
+
+		size_type next(size_type pos) const noexcept {
+			return pos + 1 != capacity() ? pos + 1 : 0;
+		}
+
+		value_type* slot(size_type n) const noexcept {
+			size_type pos = mBegin + n;
+			size_type cap = mpArray->size();
+			return data() + (pos >= cap ? pos - cap : pos);
+		}
+
+		template <typename... Args>
+		void construct_or_free(const array_pointer& pNew, size_type n, value_type* p, Args&&... args) {
+			try {
+				::new(static_cast<void*>(p)) value_type(std::forward<Args>(args)...);
+			}
+			catch(...) {
+				mAllocator.deallocate_array(pNew, n);
+				throw;
+			}
+		}
+
+		/// moves elements to \c pNew starting at \c pos, and frees current array.
+		/// \c extra is an already constructed element in \c pNew to destroy on failure
+		void relocate_to(const array_pointer& pNew, size_type pos, size_type n, value_type* extra = nullptr) {
+			value_type* pData = allocator_type::to_raw(pNew);
+			size_type i = 0;
+			try {
+				for(; i != mSize; ++i)
+					::new(static_cast<void*>(pData + pos + i)) value_type(std::move_if_noexcept(at_unchecked(i)));
+			}
+			catch(...) {
+				for(size_type j = 0; j != i; ++j)
+					pData[pos + j].~value_type();
+				if(extra)
+					extra->~value_type();
+				mAllocator.deallocate_array(pNew, n);
+				throw;
+			}
+
+			size_type sz = mSize;
+			free_array();
+			mpArray = pNew;
+			mSize = sz;
+		}
+
+		void free_array() {
+			clear();
+
+			if(mpArray) {
+				mAllocator.deallocate_array(mpArray, mpArray->size());
+				mpArray = nullptr;
+			}
+		}
+	};
+
+} // namespace safememory::detail 
+
+#endif // SAFE_MEMORY_DETAIL_CIRCULAR_BUFFER_H
@@ -0,0 +1,312 @@
+/* -------------------------------------------------------------------------------
+* Copyright (c) 2020, OLogN Technologies AG
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of the OLogN Technologies AG nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL OLogN Technologies AG BE LIABLE FOR ANY
+* DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* -------------------------------------------------------------------------------*/
+
+
+
+#ifndef SAFE_MEMORY_DETAIL_CIRCULAR_BUFFER_ITERATOR_H
+#define SAFE_MEMORY_DETAIL_CIRCULAR_BUFFER_ITERATOR_H
+
+#include <safememory/detail/instrument.h>
+#include <safe_memory_error.h>
+
+namespace safememory::detail {
+
+	/**
+	 * \brief Iterator wrapper for \c circular_buffer stack only iterators
+	 * 
+	 * Same as \c vector iterators, index is checked against the array capacity,
+	 * that is enought to never touch memory outside the array.
+	 */
+	template <typename BaseIt, typename BaseNonConstIt, typename Allocator>
+	class circular_buffer_stack_only_iterator : protected BaseIt
+	{
+	public:
+		typedef BaseIt                                                   base_type;
+		typedef Allocator                                                allocator_type;
+		typedef circular_buffer_stack_only_iterator<BaseIt, BaseNonConstIt, Allocator>          this_type;
+		typedef circular_buffer_stack_only_iterator<BaseNonConstIt, BaseNonConstIt, Allocator>  this_type_non_const;
+
+		typedef typename base_type::value_type                           value_type;
+		typedef typename base_type::pointer                              pointer;
+		typedef typename base_type::reference                            reference;
+		typedef typename base_type::size_type                            size_type;
+		typedef typename base_type::difference_type                      difference_type;
+		typedef typename base_type::iterator_category                    iterator_category;
+
+	    static constexpr memory_safety is_safe = allocator_type::is_safe;
+
+	    static constexpr bool is_const = !std::is_same_v<this_type, this_type_non_const>;
+
+		template <typename, typename, typename>
+		friend class circular_buffer_stack_only_iterator;
+
+		template<typename TT>
+		static constexpr bool sfinae = is_const && std::is_same_v<TT, this_type_non_const>;
+
+		[[noreturn]] static void ThrowRangeException() { throw nodecpp::error::out_of_range; }
+		[[noreturn]] static void ThrowNullException() { throw nodecpp::error::zero_pointer_access; }
+		[[noreturn]] static void ThrowInvalidArgumentException() { throw nodecpp::error::out_of_range; }
+
+		circular_buffer_stack_only_iterator(const base_type& it) : base_type(it) { }
+
+    public:
+		circular_buffer_stack_only_iterator() :base_type() { }
+
+		circular_buffer_stack_only_iterator(const this_type&) = default;
+		circular_buffer_stack_only_iterator& operator=(const circular_buffer_stack_only_iterator& ri) = default;
+
+		circular_buffer_stack_only_iterator(circular_buffer_stack_only_iterator&& ri) = default; 
+		circular_buffer_stack_only_iterator& operator=(circular_buffer_stack_only_iterator&& ri) = default;
+
+		~circular_buffer_stack_only_iterator() = default;
+
+		template<typename Other, std::enable_if_t<sfinae<Other>, bool> = true>
+		circular_buffer_stack_only_iterator(const Other& other)
+			: base_type(other) { }
+
+		template<typename Other, std::enable_if_t<sfinae<Other>, bool> = true>
+		circular_buffer_stack_only_iterator& operator=(const Other& other) {
+			base_type::operator=(static_cast<const typename Other::base_type&>(other));
+			return *this;
+		}
+
+		reference operator*() const {
+			checkDerefenceable(base_type::mIndex);
+			return base_type::operator*();
+		}
+
+		pointer operator->() const {
+			checkDerefenceable(base_type::mIndex);
+			return base_type::operator->();
+		}
+
+		reference operator[](difference_type n) const {
+			checkDerefenceable(base_type::mIndex + n);
+			return base_type::operator[](n);
+		}
+
+		this_type& operator++() { base_type::operator++(); return *this; }
+		this_type operator++(int) { this_type temp(*this); base_type::operator++(); return temp; }
+
+		this_type& operator--() { base_type::operator--(); return *this; }
+		this_type operator--(int) { this_type temp(*this); base_type::operator--(); return temp; }
+
+		this_type& operator+=(difference_type n) { base_type::operator+=(n); return *this; }
+		this_type& operator-=(difference_type n) { base_type::operator-=(n); return *this; }
+
+		this_type operator+(difference_type n) const { return this_type(base_type::operator+(n)); }
+		this_type operator-(difference_type n) const { return this_type(base_type::operator-(n)); }
+
+		difference_type operator-(const this_type& other) const {
+			checkSameArray(other);
+			return base_type::operator-(other);
+		}
+
+		bool operator==(const this_type& other) const { return base_type::operator==(other); }
+		bool operator!=(const this_type& other) const { return base_type::operator!=(other); }
+
+		bool operator<(const this_type& other) const { checkSameArray(other); return base_type::operator<(other); }
+		bool operator>(const this_type& other) const { checkSameArray(other); return base_type::operator>(other); }
+		bool operator<=(const this_type& other) const { checkSameArray(other); return base_type::operator<=(other); }
+		bool operator>=(const this_type& other) const { checkSameArray(other); return base_type::operator>=(other); }
+
+		void checkDerefenceable(size_type index) const {
+			if(NODECPP_UNLIKELY(!base_type::mpArray))
+				ThrowNullException();
+
+#ifdef SAFEMEMORY_DEZOMBIEFY_ITERATORS
+			checkNotZombie(base_type::mpArray);
+#endif
+			if(NODECPP_UNLIKELY(index >= base_type::mpArray->size()))
+				ThrowRangeException();
+		}
+
+		void checkSameArray(const this_type& other) const {
+			if(NODECPP_UNLIKELY(base_type::mpArray != other.mpArray))
+				ThrowInvalidArgumentException();
+		}
+
+		// mb: null is a valid base iterator, begin and end of an empty container
+		const base_type& toBase() const { return *this; }
+
+		static this_type fromBase(const base_type& b) { return this_type(b); }
+	}; // circular_buffer_stack_only_iterator
+
+
+	/**
+	 * \brief Iterator for \c circular_buffer heap safe iterators
+	 * 
+	 * Keeps a \c soft_ptr to the array, so it will throw instead of touching
+	 * an array that was deallocated when the container grew.
+	 */
+	template <typename BaseIt, typename BaseNonConstIt, typename Allocator>
+	class circular_buffer_heap_safe_iterator : protected BaseIt
+	{
+	public:
+		typedef BaseIt                                                   base_type;
+		typedef Allocator                                                allocator_type;
+		typedef circular_buffer_heap_safe_iterator<BaseIt, BaseNonConstIt, Allocator>          this_type;
+		typedef circular_buffer_heap_safe_iterator<BaseNonConstIt, BaseNonConstIt, Allocator>  this_type_non_const;
+
+		typedef typename base_type::value_type                           value_type;
+		typedef typename base_type::pointer                              pointer;
+		typedef typename base_type::reference                            reference;
+		typedef typename base_type::size_type                            size_type;
+		typedef typename base_type::difference_type                      difference_type;
+		typedef typename base_type::iterator_category                    iterator_category;
+		typedef typename base_type::array_type                           array_type;
+
+	    static constexpr memory_safety is_safe = allocator_type::is_safe;
+
+	    static constexpr bool is_const = !std::is_same_v<this_type, this_type_non_const>;
+
+		template <typename, typename, typename>
+		friend class circular_buffer_heap_safe_iterator;
+
+		template<typename TT>
+		static constexpr bool sfinae = is_const && std::is_same_v<TT, this_type_non_const>;
+
+		typedef typename allocator_type::template array_pointer<value_type>           zero_array_ptr;
+        typedef typename allocator_type::template soft_pointer<array_type>            soft_array_ptr;
+
+		soft_array_ptr    mpSoftArray;
+
+		[[noreturn]] static void ThrowRangeException() { throw nodecpp::error::out_of_range; }
+		[[noreturn]] static void ThrowNullException() { throw nodecpp::error::zero_pointer_access; }
+		[[noreturn]] static void ThrowInvalidArgumentException() { throw nodecpp::error::out_of_range; }
+
+		circular_buffer_heap_safe_iterator(const BaseIt& it, const soft_array_ptr& arr)
+			: base_type(it), mpSoftArray(arr) { }
+
+    public:
+
+		/// \c arr must be the pointer to \c it array, as stored in the container
+        static this_type makeIt(const BaseIt& it, const zero_array_ptr& arr) {
+			NODECPP_ASSERT(module_id, nodecpp::assert::AssertLevel::regular, it.get_array() == arr.get_raw_ptr());
+			return { it, allocator_type::to_soft(arr) };
+        }
+
+		circular_buffer_heap_safe_iterator() :base_type() { }
+
+		circular_buffer_heap_safe_iterator(const this_type&) = default;
+		circular_buffer_heap_safe_iterator& operator=(const circular_buffer_heap_safe_iterator& ri) = default;
+
+		circular_buffer_heap_safe_iterator(circular_buffer_heap_safe_iterator&& ri) = default; 
+		circular_buffer_heap_safe_iterator& operator=(circular_buffer_heap_safe_iterator&& ri) = default;
+
+		~circular_buffer_heap_safe_iterator() = default;
+
+		template<typename Other, std::enable_if_t<sfinae<Other>, bool> = true>
+		circular_buffer_heap_safe_iterator(const Other& other)
+			: base_type(other), mpSoftArray(other.mpSoftArray) { }
+
+		template<typename Other, std::enable_if_t<sfinae<Other>, bool> = true>
+		circular_buffer_heap_safe_iterator& operator=(const Other& other) {
+			base_type::operator=(static_cast<const typename Other::base_type&>(other));
+			this->mpSoftArray = other.mpSoftArray;
+			return *this;
+		}
+
+		reference operator*() const {
+			checkDerefenceable(base_type::mIndex);
+			return base_type::operator*();
+		}
+
+		pointer operator->() const {
+			checkDerefenceable(base_type::mIndex);
+			return base_type::operator->();
+		}
+
+		reference operator[](difference_type n) const {
+			checkDerefenceable(base_type::mIndex + n);
+			return base_type::operator[](n);
+		}
+
+		this_type& operator++() { base_type::operator++(); return *this; }
+		this_type operator++(int) { this_type temp(*this); base_type::operator++(); return temp; }
+
+		this_type& operator--() { base_type::operator--(); return *this; }
+		this_type operator--(int) { this_type temp(*this); base_type::operator--(); return temp; }
+
+		this_type& operator+=(difference_type n) { base_type::operator+=(n); return *this; }
+		this_type& operator-=(difference_type n) { base_type::operator-=(n); return *this; }
+
+		this_type operator+(difference_type n) const { return this_type(base_type::operator+(n), mpSoftArray); }
+		this_type operator-(difference_type n) const { return this_type(base_type::operator-(n), mpSoftArray); }
+
+		difference_type operator-(const this_type& other) const {
+			checkSameArray(other);
+			return base_type::operator-(other);
+		}
+
+		bool operator==(const this_type& other) const { return base_type::operator==(other); }
+		bool operator!=(const this_type& other) const { return base_type::operator!=(other); }
+
+		bool operator<(const this_type& other) const { checkSameArray(other); return base_type::operator<(other); }
+		bool operator>(const this_type& other) const { checkSameArray(other); return base_type::operator>(other); }
+		bool operator<=(const this_type& other) const { checkSameArray(other); return base_type::operator<=(other); }
+		bool operator>=(const this_type& other) const { checkSameArray(other); return base_type::operator>=(other); }
+
+		void checkDerefenceable(size_type index) const {
+			if(NODECPP_UNLIKELY(!base_type::mpArray))
+				ThrowNullException();
+
+			checkNotInvalidated(mpSoftArray);
+
+			if(NODECPP_UNLIKELY(index >= base_type::mpArray->size()))
+				ThrowRangeException();
+		}
+
+		void checkSameArray(const this_type& other) const {
+			if(NODECPP_UNLIKELY(base_type::mpArray != other.mpArray))
+				ThrowInvalidArgumentException();
+		}
+
+		// mb: null is a valid base iterator, begin and end of an empty container
+		const base_type& toBase() const {
+			if(base_type::mpArray)
+				checkNotInvalidated(mpSoftArray);
+			
+			return *this;
+		}
+	}; // circular_buffer_heap_safe_iterator
+
+	template <typename BaseIt, typename BaseNonConstIt, typename Allocator>
+	inline circular_buffer_stack_only_iterator<BaseIt, BaseNonConstIt, Allocator>
+	operator+(eastl_ssize_t n, const circular_buffer_stack_only_iterator<BaseIt, BaseNonConstIt, Allocator>& it) {
+		return it + n;
+	}
+
+	template <typename BaseIt, typename BaseNonConstIt, typename Allocator>
+	inline circular_buffer_heap_safe_iterator<BaseIt, BaseNonConstIt, Allocator>
+	operator+(eastl_ssize_t n, const circular_buffer_heap_safe_iterator<BaseIt, BaseNonConstIt, Allocator>& it) {
+		return it + n;
+	}
+
+} // namespace safememory::detail 
+
+#endif // SAFE_MEMORY_DETAIL_CIRCULAR_BUFFER_ITERATOR_H
@@ -28,8 +28,11 @@
 #ifndef SAFE_MEMORY_DETAIL_FLEXIBLE_ARRAY_H
 #define SAFE_MEMORY_DETAIL_FLEXIBLE_ARRAY_H
 
+#include <cstddef>
 #include <initializer_list>
+#include <limits>
 #include <EASTL/internal/config.h> // for eastl_size_t
+#include <safe_memory_error.h>
 
 namespace safememory::detail {
 
@@ -74,11 +77,41 @@ public:
 	constexpr T* data() noexcept { return reinterpret_cast<T*>(&_begin); }
 	constexpr const T* data() const noexcept { return reinterpret_cast<const T*>(&_begin); }
 
+	/// offset of the first element. The header goes first, as the block is already aligned for both,
+	/// so the only padding is between \c sz and the first element, and only for \c T aligned above \c size_type.
+	/// We don't use \c sizeof(this_type) as it also counts the tail padding after \c _begin
+	static constexpr std::size_t data_offset = (sizeof(size_type) + alignof(T) - 1) / alignof(T) * alignof(T);
+
+	// largest count that won't overflow std::size_t, leaving room for the allocator headers
+	static constexpr std::size_t max_count = (std::numeric_limits<std::size_t>::max() / 2 - data_offset) / sizeof(T);
+
 	// we use 'eastl_size_t' for number of elements and std::size_t for actual memory size 
 	static std::size_t calculateSize(size_type count) {
-		// TODO calculated size is slightly bigger than actually needed, maybe fine tune
-		// TODO also must check that we are not overflowing the size_t
-		return sizeof(this_type) + (sizeof(T) * count);
+		static_assert(offsetof(this_type, _begin) == data_offset, "flexible_array layout mismatch");
+
+		// mb: with 32 bits eastl_size_t on a 64 bits platform this can't overflow
+		if constexpr (std::numeric_limits<size_type>::max() > max_count) {
+			if(NODECPP_UNLIKELY(count > max_count))
+				throw nodecpp::error::out_of_range;
+		}
+
+		std::size_t bytes = data_offset + (sizeof(T) * static_cast<std::size_t>(count));
+		// mb: we construct the header object in the block, for few small elements
+		// the elements end before its tail padding does
+		return bytes < sizeof(this_type) ? sizeof(this_type) : bytes;
+	}
+
+	/// inverse of \c calculateSize, number of elements that fit in a block of \c bytes.
+	/// Used to turn the real usable size of an allocation into extra capacity.
+	static constexpr size_type calculateCapacity(std::size_t bytes) noexcept {
+		if(bytes < sizeof(this_type))
+			return 0;
+
+		constexpr std::size_t limit = max_count < std::numeric_limits<size_type>::max() ?
+			max_count : std::numeric_limits<size_type>::max();
+
+		std::size_t count = (bytes - data_offset) / sizeof(T);
+		return static_cast<size_type>(count < limit ? count : limit);
 	}
 };
 
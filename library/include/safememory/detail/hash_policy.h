@@ -0,0 +1,216 @@
+/* -------------------------------------------------------------------------------
+* Copyright (c) 2020, OLogN Technologies AG
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of the OLogN Technologies AG nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL OLogN Technologies AG BE LIABLE FOR ANY
+* DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* -------------------------------------------------------------------------------*/
+
+
+#ifndef SAFEMEMORY_DETAIL_HASH_POLICY_H
+#define SAFEMEMORY_DETAIL_HASH_POLICY_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+namespace safememory::detail {
+
+/** \brief Finalizer from splitmix64.
+ * 
+ * It is a bijection on 64 bits, so it never adds collisions to integer keys,
+ * but every input bit affects every output bit. Sequential ids and keys
+ * that are multiples of a power of two spread evenly over power-of-two
+ * and prime bucket counts alike.
+ */
+constexpr std::uint64_t hash_mix64(std::uint64_t x) noexcept {
+	x ^= x >> 30;
+	x *= UINT64_C(0xbf58476d1ce4e5b9);
+	x ^= x >> 27;
+	x *= UINT64_C(0x94d049bb133111eb);
+	x ^= x >> 31;
+	return x;
+}
+
+/** \brief Full 64x64->128 multiply, low half goes to \a a, high half to \a b. */
+inline void hash_mum128(std::uint64_t& a, std::uint64_t& b) noexcept {
+#if defined(__SIZEOF_INT128__)
+	__uint128_t r = a;
+	r *= b;
+	a = static_cast<std::uint64_t>(r);
+	b = static_cast<std::uint64_t>(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+	a = _umul128(a, b, &b);
+#else
+	std::uint64_t ha = a >> 32, hb = b >> 32, la = static_cast<std::uint32_t>(a), lb = static_cast<std::uint32_t>(b);
+	std::uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+	std::uint64_t t = rl + (rm0 << 32);
+	std::uint64_t c = t < rl;
+	std::uint64_t lo = t + (rm1 << 32);
+	c += lo < t;
+	a = lo;
+	b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+/** \brief 128 bit product folded back to 64 bits with xor. */
+inline std::uint64_t hash_mum(std::uint64_t a, std::uint64_t b) noexcept {
+	hash_mum128(a, b);
+	return a ^ b;
+}
+
+// mb: memcpy is the only portable unaligned read, compilers turn it into a plain load
+inline std::uint64_t hash_read8(const unsigned char* p) noexcept { std::uint64_t v; std::memcpy(&v, p, 8); return v; }
+inline std::uint64_t hash_read4(const unsigned char* p) noexcept { std::uint32_t v; std::memcpy(&v, p, 4); return v; }
+inline std::uint64_t hash_read3(const unsigned char* p, std::size_t k) noexcept {
+	return (static_cast<std::uint64_t>(p[0]) << 16) | (static_cast<std::uint64_t>(p[k >> 1]) << 8) | p[k - 1];
+}
+
+/** \brief wyhash (final3 secrets) over a byte range.
+ * 
+ * Reads 8 bytes at a time with three independent lanes for long inputs,
+ * and at most two overlapping loads for keys up to 16 bytes, which
+ * covers most identifiers and short strings without a loop.
+ * Result depends on platform endianness, which is fine for in-memory tables.
+ */
+inline std::uint64_t wyhash_bytes(const void* key, std::size_t len, std::uint64_t seed = 0) noexcept {
+	constexpr std::uint64_t s0 = UINT64_C(0xa0761d6478bd642f);
+	constexpr std::uint64_t s1 = UINT64_C(0xe7037ed1a0b428db);
+	constexpr std::uint64_t s2 = UINT64_C(0x8ebc6af09c88c6e3);
+	constexpr std::uint64_t s3 = UINT64_C(0x589965cc75374cc3);
+
+	const unsigned char* p = static_cast<const unsigned char*>(key);
+	seed ^= hash_mum(seed ^ s0, s1);
+	std::uint64_t a, b;
+	if(len <= 16) {
+		if(len >= 4) {
+			a = (hash_read4(p) << 32) | hash_read4(p + ((len >> 3) << 2));
+			b = (hash_read4(p + len - 4) << 32) | hash_read4(p + len - 4 - ((len >> 3) << 2));
+		}
+		else if(len > 0) {
+			a = hash_read3(p, len);
+			b = 0;
+		}
+		else
+			a = b = 0;
+	}
+	else {
+		std::size_t i = len;
+		if(i > 48) {
+			std::uint64_t see1 = seed, see2 = seed;
+			do {
+				seed = hash_mum(hash_read8(p) ^ s1, hash_read8(p + 8) ^ seed);
+				see1 = hash_mum(hash_read8(p + 16) ^ s2, hash_read8(p + 24) ^ see1);
+				see2 = hash_mum(hash_read8(p + 32) ^ s3, hash_read8(p + 40) ^ see2);
+				p += 48;
+				i -= 48;
+			} while(i > 48);
+			seed ^= see1 ^ see2;
+		}
+		while(i > 16) {
+			seed = hash_mum(hash_read8(p) ^ s1, hash_read8(p + 8) ^ seed);
+			i -= 16;
+			p += 16;
+		}
+		a = hash_read8(p + i - 16);
+		b = hash_read8(p + i - 8);
+	}
+	a ^= s1;
+	b ^= seed;
+	hash_mum128(a, b);
+	return hash_mum(a ^ s0 ^ len, b ^ s1);
+}
+
+/** \brief FNV-1 over characters, exactly what \c eastl::hash does for strings. */
+template<class T>
+std::size_t fnv1_chars(const T* p, std::size_t n) noexcept {
+	unsigned int result = 2166136261U;
+	for(std::size_t i = 0; i != n; ++i)
+		result = (result * 16777619) ^ static_cast<unsigned int>(p[i]);
+	return static_cast<std::size_t>(result);
+}
+
+/** \brief FNV-1a over characters on 32 bits, \c constexpr so literals can be hashed at compile time. */
+template<class T>
+constexpr std::uint32_t fnv1a_32(const T* p, std::size_t n) noexcept {
+	std::uint32_t result = 2166136261U;
+	for(std::size_t i = 0; i != n; ++i)
+		result = (result ^ static_cast<std::uint32_t>(p[i])) * 16777619U;
+	return result;
+}
+
+/** \brief 32 bits finalizer, from 'hash prospector'. */
+constexpr std::uint32_t hash_mix32(std::uint32_t x) noexcept {
+	x ^= x >> 16;
+	x *= 0x7feb352dU;
+	x ^= x >> 15;
+	x *= 0x846ca68bU;
+	x ^= x >> 16;
+	return x;
+}
+
+} // namespace safememory::detail
+
+namespace safememory {
+
+struct pow2_rehash_policy;
+
+/** \brief Hashing policy that reproduces previous behaviour.
+ * 
+ * Integers hash to themselves and strings use FNV-1, same as \c eastl::hash.
+ * Use it when a table layout must not change, or keys are already
+ * well distributed. Tables keep prime bucket counts with this policy.
+ */
+struct identity_hash_policy {
+	static constexpr std::size_t integer(std::uint64_t v) noexcept { return static_cast<std::size_t>(v); }
+
+	template<class T>
+	static std::size_t chars(const T* p, std::size_t n) noexcept { return detail::fnv1_chars(p, n); }
+};
+
+/** \brief Default hashing policy.
+ * 
+ * Integers go through \c detail::hash_mix64, strings through \c detail::wyhash_bytes.
+ * Low bits are as good as high ones, so tables use power-of-two bucket
+ * counts and pick a bucket with a mask, see \c pow2_rehash_policy.
+ */
+struct mixing_hash_policy {
+	typedef pow2_rehash_policy rehash_policy;
+
+	static constexpr std::size_t integer(std::uint64_t v) noexcept { return static_cast<std::size_t>(detail::hash_mix64(v)); }
+
+	template<class T>
+	static std::size_t chars(const T* p, std::size_t n) noexcept { return static_cast<std::size_t>(detail::wyhash_bytes(p, n * sizeof(T))); }
+};
+
+#ifdef SAFEMEMORY_HASH_POLICY
+using default_hash_policy = SAFEMEMORY_HASH_POLICY;
+#else
+using default_hash_policy = mixing_hash_policy;
+#endif
+
+} // namespace safememory
+
+#endif // SAFEMEMORY_DETAIL_HASH_POLICY_H
@@ -120,10 +120,12 @@ namespace safememory::detail {
 		}
 
 		void checkDerefenceable() const {
-			if(NODECPP_UNLIKELY(!base_type::mpNode))
-				ThrowNullException();
-			else if(NODECPP_UNLIKELY(allocator_type::is_hashtable_sentinel(base_type::mpNode)))
-				ThrowRangeException();
+			if(NODECPP_UNLIKELY(allocator_type::is_null_or_hashtable_sentinel(base_type::mpNode))) {
+				if(!base_type::mpNode)
+					ThrowNullException();
+				else
+					ThrowRangeException();
+			}
 
 #ifdef SAFEMEMORY_DEZOMBIEFY_ITERATORS
 			// hashtable local iterators don't have a bucket
@@ -301,10 +303,12 @@ namespace safememory::detail {
 		}
 
 		void checkDerefenceable() const {
-			if(NODECPP_UNLIKELY(!base_type::mpNode))
-				ThrowNullException();
-			else if(NODECPP_UNLIKELY(allocator_type::is_hashtable_sentinel(base_type::mpNode)))
-				ThrowRangeException();
+			if(NODECPP_UNLIKELY(allocator_type::is_null_or_hashtable_sentinel(base_type::mpNode))) {
+				if(!base_type::mpNode)
+					ThrowNullException();
+				else
+					ThrowRangeException();
+			}
 			
 			checkNotInvalidated(mpSoftBucketArr);
 			checkNotInvalidated(mpSoftNode);
@@ -327,6 +331,57 @@ namespace safememory::detail {
 			return *this;
 		}
 	}; // hashtable_heap_safe_iterator
+
+
+	inline
+	void hashtable_prefetch(const void* p) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+		__builtin_prefetch(p);
+#endif
+	}
+
+	/**
+	 * \brief Walks all nodes of a hashtable, calling \p f with the value of each one.
+	 * 
+	 * Used by \c for_each of unordered containers, caller must check the bucket array is not null.
+	 * Nodes and buckets are walked directly, so there is no null nor sentinel check per element,
+	 * and first nodes of buckets ahead are prefetched while \p f runs.
+	 * 
+	 * \p f must not insert or erase elements. When safe, we check the bucket array and the
+	 * allocator count of node changes (\p modifications ) are unchanged after each call, and
+	 * throw if not. Only then the next node is read, as \p f may have released it.
+	 */
+	template <typename Allocator, typename Value, typename BucketArray, typename SizeT, typename F>
+	void hashtable_for_each(const BucketArray& buckets, const SizeT& bucketCount, const eastl_size_t& modifications, F& f) {
+
+		auto* const pBuckets = Allocator::to_raw(buckets);
+		const SizeT n = bucketCount;
+		const eastl_size_t mods = modifications;
+
+		for(SizeT i = 0; i != n; ++i) {
+			// mb: nodes are visited in hash order, not in allocation order, so we
+			// need to prefetch a few buckets ahead to hide the cache misses
+			if(i + 16 < n)
+				hashtable_prefetch(Allocator::to_raw(pBuckets[i + 16]));
+
+			auto* node = Allocator::to_raw(pBuckets[i]);
+			while(node) {
+				// mb: only a hint, prefetch doesn't fault if f releases it
+				hashtable_prefetch(Allocator::to_raw(node->mpNext));
+
+				f(static_cast<Value&>(node->mValue));
+
+				if constexpr (Allocator::is_safe == memory_safety::safe) {
+					if(NODECPP_UNLIKELY(Allocator::to_raw(buckets) != pBuckets || modifications != mods))
+						throw nodecpp::error::out_of_range;
+				}
+#ifdef SAFEMEMORY_DEZOMBIEFY_ITERATORS
+				checkNotZombie(node);
+#endif
+				node = Allocator::to_raw(node->mpNext);
+			}
+		}
+	}
 } // namespace safememory::detail 
 
 #endif // SAFE_MEMORY_DETAIL_HASHTABLE_ITERATOR
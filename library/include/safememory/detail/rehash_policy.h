@@ -0,0 +1,175 @@
+/* -------------------------------------------------------------------------------
+* Copyright (c) 2020, OLogN Technologies AG
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of the OLogN Technologies AG nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL OLogN Technologies AG BE LIABLE FOR ANY
+* DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* -------------------------------------------------------------------------------*/
+
+#ifndef SAFEMEMORY_DETAIL_REHASH_POLICY_H
+#define SAFEMEMORY_DETAIL_REHASH_POLICY_H
+
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+#include <EASTL/internal/hashtable.h>
+#include <safememory/functional.h>
+
+namespace safememory {
+
+/** \brief Maps a hash code to one of \a n buckets with a mask, \a n must be a power of two. */
+struct mask_range_hashing {
+	std::uint32_t operator()(std::size_t r, std::uint32_t n) const noexcept { return static_cast<std::uint32_t>(r) & (n - 1); }
+};
+
+/** \brief Rehash policy with power-of-two bucket counts.
+ * 
+ * Same interface and members as \c eastl::prime_rehash_policy, so it plugs
+ * into \c eastl::hashtable as is. Bucket is picked with a single \c and
+ * instead of a division, which only works with hashes that have good low
+ * bits, like the ones from \c mixing_hash_policy.
+ * 
+ * \c mfGrowthFactor is how much the table grows at once. Larger values
+ * mean fewer, but bigger, rehash pauses. When the final size is known
+ * \c reserve avoids them all.
+ */
+struct pow2_rehash_policy {
+	typedef mask_range_hashing range_hashing;
+
+	float                 mfMaxLoadFactor;
+	float                 mfGrowthFactor;
+	mutable std::uint32_t mnNextResize;
+
+	pow2_rehash_policy(float fMaxLoadFactor = 1.f, float fGrowthFactor = 2.f)
+		: mfMaxLoadFactor(fMaxLoadFactor), mfGrowthFactor(fGrowthFactor), mnNextResize(0) {}
+
+	float GetMaxLoadFactor() const { return mfMaxLoadFactor; }
+
+	static std::uint32_t GetPrevBucketCountOnly(std::uint32_t nBucketCountHint) {
+		return nBucketCountHint < 2 ? 2 : std::bit_floor(nBucketCountHint);
+	}
+
+	std::uint32_t GetPrevBucketCount(std::uint32_t nBucketCountHint) const {
+		std::uint32_t n = GetPrevBucketCountOnly(nBucketCountHint);
+		mnNextResize = nextResize(n);
+		return n;
+	}
+
+	std::uint32_t GetNextBucketCount(std::uint32_t nBucketCountHint) const {
+		std::uint32_t n = roundUp(nBucketCountHint);
+		mnNextResize = nextResize(n);
+		return n;
+	}
+
+	std::uint32_t GetBucketCount(std::uint32_t nElementCount) const {
+		std::uint32_t n = roundUp(nElementCount / mfMaxLoadFactor);
+		mnNextResize = nextResize(n);
+		return n;
+	}
+
+	eastl::pair<bool, std::uint32_t>
+	GetRehashRequired(std::uint32_t nBucketCount, std::uint32_t nElementCount, std::uint32_t nElementAdd) const {
+		// mb: same logic as eastl::prime_rehash_policy, see hashtable.cpp
+		if((nElementCount + nElementAdd) > mnNextResize) {
+			if(nBucketCount == 1) // eastl empty bucket array
+				nBucketCount = 0;
+
+			float fMinBucketCount = (nElementCount + nElementAdd) / mfMaxLoadFactor;
+			if(fMinBucketCount > static_cast<float>(nBucketCount)) {
+				std::uint32_t n = roundUp(eastl::max_alt(fMinBucketCount, mfGrowthFactor * nBucketCount));
+				mnNextResize = nextResize(n);
+				return eastl::pair<bool, std::uint32_t>(true, n);
+			}
+			else {
+				mnNextResize = nextResize(nBucketCount);
+				return eastl::pair<bool, std::uint32_t>(false, 0);
+			}
+		}
+
+		return eastl::pair<bool, std::uint32_t>(false, 0);
+	}
+
+private:
+	static constexpr std::uint32_t maxBucketCount = std::uint32_t(1) << 31;
+
+	static std::uint32_t roundUp(float n) {
+		return n >= static_cast<float>(maxBucketCount) ? maxBucketCount : roundUp(static_cast<std::uint32_t>(n));
+	}
+
+	static std::uint32_t roundUp(std::uint32_t n) {
+		return n <= 2 ? 2 : n > maxBucketCount ? maxBucketCount : std::bit_ceil(n);
+	}
+
+	std::uint32_t nextResize(std::uint32_t nBucketCount) const {
+		float f = std::ceil(nBucketCount * mfMaxLoadFactor);
+		return f >= 4294967295.f ? UINT32_MAX : static_cast<std::uint32_t>(f);
+	}
+};
+
+} // namespace safememory
+
+namespace safememory::detail {
+
+/** \brief Rehash policy of a hashtable using \c Hash.
+ * 
+ * A hash functor may name its policy with a nested \c rehash_policy type,
+ * \c safememory::hash takes the one of its hashing policy. Anything else
+ * gets prime bucket counts, the safe choice for unknown hash quality.
+ */
+template<class Hash, class = void>
+struct rehash_policy_of { typedef eastl::prime_rehash_policy type; };
+
+template<class Hash>
+struct rehash_policy_of<Hash, std::void_t<typename Hash::rehash_policy>> { typedef typename Hash::rehash_policy type; };
+
+template<class T, class Policy>
+struct rehash_policy_of<hash<T, Policy>, void> : rehash_policy_of<Policy> {};
+
+template<class Hash>
+using rehash_policy_of_t = typename rehash_policy_of<Hash>::type;
+
+} // namespace safememory::detail
+
+namespace eastl {
+
+// mb: give hashtable get_max_load_factor and set_max_load_factor, as eastl does for prime_rehash_policy
+template <typename Hashtable>
+struct rehash_base<safememory::pow2_rehash_policy, Hashtable>
+{
+	float get_max_load_factor() const
+	{
+		const Hashtable* const pThis = static_cast<const Hashtable*>(this);
+		return pThis->rehash_policy().GetMaxLoadFactor();
+	}
+
+	void set_max_load_factor(float fMaxLoadFactor)
+	{
+		Hashtable* const pThis = static_cast<Hashtable*>(this);
+		safememory::pow2_rehash_policy policy(fMaxLoadFactor, pThis->rehash_policy().mfGrowthFactor);
+		pThis->rehash_policy(policy);
+	}
+};
+
+} // namespace eastl
+
+#endif // SAFEMEMORY_DETAIL_REHASH_POLICY_H
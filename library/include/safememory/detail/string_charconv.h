@@ -0,0 +1,93 @@
+/* -------------------------------------------------------------------------------
+* Copyright (c) 2020, OLogN Technologies AG
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of the OLogN Technologies AG nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL OLogN Technologies AG BE LIABLE FOR ANY
+* DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* -------------------------------------------------------------------------------*/
+
+#ifndef SAFE_MEMORY_DETAIL_STRING_CHARCONV_H
+#define SAFE_MEMORY_DETAIL_STRING_CHARCONV_H
+
+#include <type_traits>
+
+namespace safememory::detail {
+
+/**
+ * \brief Helpers for \c basic_string::append_number on integers.
+ * 
+ * Digits are written from the end, two at a time using a table, so the
+ * number of digits is calculated first and the string buffer is resized
+ * only once, to the exact size.
+ */
+
+inline constexpr char digits_table[] =
+	"00010203040506070809"
+	"10111213141516171819"
+	"20212223242526272829"
+	"30313233343536373839"
+	"40414243444546474849"
+	"50515253545556575859"
+	"60616263646566676869"
+	"70717273747576777879"
+	"80818283848586878889"
+	"90919293949596979899";
+
+template<class U>
+unsigned count_digits(U value) noexcept {
+	static_assert(std::is_unsigned_v<U>);
+
+	unsigned n = 1;
+	while(true) {
+		if(value < 10u) return n;
+		if(value < 100u) return n + 1;
+		if(value < 1000u) return n + 2;
+		if(value < 10000u) return n + 3;
+		value /= 10000u;
+		n += 4;
+	}
+}
+
+/// writes \p value backwards, ending just before \p end, must have room for \c count_digits(value)
+template<class CharT, class U>
+void write_digits(CharT* end, U value) noexcept {
+	static_assert(std::is_unsigned_v<U>);
+
+	while(value >= 100u) {
+		auto ix = static_cast<unsigned>(value % 100u) * 2;
+		value /= 100u;
+		*--end = static_cast<CharT>(digits_table[ix + 1]);
+		*--end = static_cast<CharT>(digits_table[ix]);
+	}
+
+	if(value >= 10u) {
+		auto ix = static_cast<unsigned>(value) * 2;
+		*--end = static_cast<CharT>(digits_table[ix + 1]);
+		*--end = static_cast<CharT>(digits_table[ix]);
+	}
+	else
+		*--end = static_cast<CharT>('0' + value);
+}
+
+} // namespace safememory::detail
+
+#endif // SAFE_MEMORY_DETAIL_STRING_CHARCONV_H
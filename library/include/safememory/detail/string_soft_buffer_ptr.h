@@ -0,0 +1,108 @@
+/* -------------------------------------------------------------------------------
+* Copyright (c) 2020, OLogN Technologies AG
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of the OLogN Technologies AG nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL OLogN Technologies AG BE LIABLE FOR ANY
+* DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* -------------------------------------------------------------------------------*/
+
+
+#ifndef SAFE_MEMORY_DETAIL_STRING_SOFT_BUFFER_PTR_H
+#define SAFE_MEMORY_DETAIL_STRING_SOFT_BUFFER_PTR_H
+
+#include <cstddef>
+#include <safememory/detail/instrument.h>
+
+namespace safememory::detail {
+
+/**
+ * \brief Array pointer used by \c string heap safe iterators.
+ * 
+ * A \c soft_ptr can't point to the SSO buffer inside a \c string body, unless the
+ * \c string itself is part of an object on the heap. In such case we use \c soft_this_ptr2
+ * to get a \c soft_ptr to the string anchored on the owner control block, and we avoid
+ * moving the buffer to the heap just to create an iterator.
+ * 
+ * So this class holds either a \c soft_ptr to the heap buffer (same as a \c vector iterator),
+ * or a \c soft_ptr to the string. In the second case \c data() is resolved each time,
+ * as the string may have moved its buffer to the heap after the iterator was created.
+ * Iterator size was taken from \c capacity() while on SSO, and \c eastl::basic_string
+ * never goes below SSO capacity, so the index is always inside the current buffer.
+ * 
+ * It has the minimal interface used by \c array_heap_safe_iterator on \p ArrPtr.
+ */
+template<typename T, typename SoftArrPtr, typename SoftStrPtr>
+class string_soft_buffer_ptr
+{
+	SoftArrPtr arr;
+	SoftStrPtr str;
+
+public:
+	typedef std::size_t size_type;
+
+	string_soft_buffer_ptr() {}
+	string_soft_buffer_ptr(std::nullptr_t) {}
+	string_soft_buffer_ptr(const SoftArrPtr& arr) : arr(arr) {}
+	string_soft_buffer_ptr(const SoftStrPtr& str) : str(str) {}
+
+	string_soft_buffer_ptr(const string_soft_buffer_ptr&) = default;
+	string_soft_buffer_ptr& operator=(const string_soft_buffer_ptr&) = default;
+	string_soft_buffer_ptr(string_soft_buffer_ptr&&) = default;
+	string_soft_buffer_ptr& operator=(string_soft_buffer_ptr&&) = default;
+
+	explicit operator bool() const noexcept { return arr || str; }
+
+	bool operator==(const string_soft_buffer_ptr& other) const noexcept {
+		return arr == other.arr && str == other.str;
+	}
+
+	bool operator!=(const string_soft_buffer_ptr& other) const noexcept {
+		return !operator==(other);
+	}
+
+	const string_soft_buffer_ptr* operator->() const noexcept { return this; }
+
+	T* data() const {
+		if(arr)
+			return arr->data();
+		else
+			return str->data();
+	}
+
+	size_type size() const {
+		if(arr)
+			return arr->size();
+		else
+			return str->capacity();
+	}
+
+	friend void checkNotInvalidated(const string_soft_buffer_ptr& p) {
+		if(p.arr)
+			checkNotInvalidated(p.arr);
+		else
+			checkNotInvalidated(p.str);
+	}
+};
+
+} // namespace safememory::detail
+
+#endif // SAFE_MEMORY_DETAIL_STRING_SOFT_BUFFER_PTR_H
@@ -29,7 +29,9 @@
 #define SAFEMEMORY_FUNCTIONAL_H
 
 #include <safememory/detail/checker_attributes.h>
+#include <safememory/detail/hash_policy.h>
 #include <typeindex>
+#include <type_traits>
 
 namespace SAFEMEMORY_CHECK_AS_USER_CODE safememory
 {
@@ -39,6 +41,13 @@ namespace SAFEMEMORY_CHECK_AS_USER_CODE safememory
 			return lhs == rhs;
 		}
 	};
+
+	template<class T = void>
+	struct SAFEMEMORY_DEEP_CONST less {
+		SAFEMEMORY_NO_SIDE_EFFECT constexpr bool operator()(const T &lhs, const T &rhs) const {
+			return lhs < rhs;
+		}
+	};
 }
 
 	//mb: this has issues with [[no_side_effect]] analysis
@@ -54,74 +63,88 @@ namespace SAFEMEMORY_CHECK_AS_USER_CODE safememory
 namespace safememory
 {
 	
-	template <typename T> struct hash;
-
-	template <typename T>
-	struct SAFEMEMORY_DEEP_CONST hash : std::enable_if_t<std::is_enum_v<T>> {
-		SAFEMEMORY_NO_SIDE_EFFECT std::size_t operator()(T p) const { return std::size_t(p); }
+	/// hash
+	///
+	/// Integral, enum, pointer and floating point keys go through \c Policy::integer,
+	/// see \c mixing_hash_policy and \c identity_hash_policy in detail/hash_policy.h.
+	/// Build with \c SAFEMEMORY_HASH_POLICY=safememory::identity_hash_policy to get
+	/// previous identity hashing back, or pass a policy to a single container
+	/// as \c hash<Key,Policy>.
+	template <typename T, typename Policy = default_hash_policy> struct hash;
+
+	namespace detail {
+		struct enum_hash_base {};
+	}
+
+	template <typename T, typename Policy>
+	struct SAFEMEMORY_DEEP_CONST hash : std::enable_if_t<std::is_enum_v<T>, detail::enum_hash_base> {
+		SAFEMEMORY_NO_SIDE_EFFECT std::size_t operator()(T p) const { return Policy::integer(static_cast<std::uint64_t>(static_cast<std::underlying_type_t<T>>(p))); }
 	};
 
-	template <>
-	struct SAFEMEMORY_DEEP_CONST hash<std::type_index> {
+	template <typename Policy>
+	struct SAFEMEMORY_DEEP_CONST hash<std::type_index, Policy> {
 		SAFEMEMORY_NO_SIDE_EFFECT std::size_t operator()(const std::type_index& p) const { return p.hash_code(); }
 	};
 
-	template <typename T> struct SAFEMEMORY_DEEP_CONST hash<T*> // Note that we use the pointer as-is and don't divide by sizeof(T*). This is because the table is of a prime size and this division doesn't benefit distribution.
-		{ SAFEMEMORY_NO_SIDE_EFFECT std::size_t operator()(T* p) const { return reinterpret_cast<std::size_t>(p); } };
+	// mb: with identity policy pointer is used as-is, we don't divide by sizeof(T*) as the table is of a prime size and this division doesn't benefit distribution.
+	template <typename T, typename Policy> struct SAFEMEMORY_DEEP_CONST hash<T*, Policy>
+		{ SAFEMEMORY_NO_SIDE_EFFECT std::size_t operator()(T* p) const { return Policy::integer(reinterpret_cast<std::uintptr_t>(p)); } };
 
-	template <> struct SAFEMEMORY_DEEP_CONST hash<bool>
-		{ SAFEMEMORY_NO_SIDE_EFFECT std::size_t operator()(bool val) const { return static_cast<std::size_t>(val); } };
+	template <typename Policy> struct SAFEMEMORY_DEEP_CONST hash<bool, Policy>
+		{ SAFEMEMORY_NO_SIDE_EFFECT std::size_t operator()(bool val) const { return Policy::integer(static_cast<std::uint64_t>(val)); } };
 
-	template <> struct SAFEMEMORY_DEEP_CONST hash<char>
-		{ SAFEMEMORY_NO_SIDE_EFFECT std::size_t operator()(char val) const { return static_cast<std::size_t>(val); } };
+	template <typename Policy> struct SAFEMEMORY_DEEP_CONST hash<char, Policy>
+		{ SAFEMEMORY_NO_SIDE_EFFECT std::size_t operator()(char val) const { return Policy::integer(static_cast<std::uint64_t>(val)); } };
 
-	template <> struct SAFEMEMORY_DEEP_CONST hash<signed char>
-		{ SAFEMEMORY_NO_SIDE_EFFECT std::size_t operator()(signed char val) const { return static_cast<std::size_t>(val); } };
+	template <typename Policy> struct SAFEMEMORY_DEEP_CONST hash<signed char, Policy>
+		{ SAFEMEMORY_NO_SIDE_EFFECT std::size_t operator()(signed char val) const { return Policy::integer(static_cast<std::uint64_t>(val)); } };
 
-	template <> struct SAFEMEMORY_DEEP_CONST hash<unsigned char>
-		{ SAFEMEMORY_NO_SIDE_EFFECT std::size_t operator()(unsigned char val) const { return static_cast<std::size_t>(val); } };
+	template <typename Policy> struct SAFEMEMORY_DEEP_CONST hash<unsigned char, Policy>
+		{ SAFEMEMORY_NO_SIDE_EFFECT std::size_t operator()(unsigned char val) const { return Policy::integer(static_cast<std::uint64_t>(val)); } };
 
-	template <> struct hash<char16_t>
-		{ SAFEMEMORY_NO_SIDE_EFFECT std::size_t operator()(char16_t val) const { return static_cast<std::size_t>(val); } };
+	template <typename Policy> struct SAFEMEMORY_DEEP_CONST hash<char16_t, Policy>
+		{ SAFEMEMORY_NO_SIDE_EFFECT std::size_t operator()(char16_t val) const { return Policy::integer(static_cast<std::uint64_t>(val)); } };
 
-	template <> struct hash<char32_t>
-		{ SAFEMEMORY_NO_SIDE_EFFECT std::size_t operator()(char32_t val) const { return static_cast<std::size_t>(val); } };
+	template <typename Policy> struct SAFEMEMORY_DEEP_CONST hash<char32_t, Policy>
+		{ SAFEMEMORY_NO_SIDE_EFFECT std::size_t operator()(char32_t val) const { return Policy::integer(static_cast<std::uint64_t>(val)); } };
 
-	template <> struct SAFEMEMORY_DEEP_CONST hash<wchar_t>
-		{ SAFEMEMORY_NO_SIDE_EFFECT std::size_t operator()(wchar_t val) const { return static_cast<std::size_t>(val); } };
+	template <typename Policy> struct SAFEMEMORY_DEEP_CONST hash<wchar_t, Policy>
+		{ SAFEMEMORY_NO_SIDE_EFFECT std::size_t operator()(wchar_t val) const { return Policy::integer(static_cast<std::uint64_t>(val)); } };
 
-	template <> struct SAFEMEMORY_DEEP_CONST hash<signed short>
-		{ SAFEMEMORY_NO_SIDE_EFFECT std::size_t operator()(signed short val) const { return static_cast<std::size_t>(val); } };
+	template <typename Policy> struct SAFEMEMORY_DEEP_CONST hash<signed short, Policy>
+		{ SAFEMEMORY_NO_SIDE_EFFECT std::size_t operator()(signed short val) const { return Policy::integer(static_cast<std::uint64_t>(val)); } };
 
-	template <> struct SAFEMEMORY_DEEP_CONST hash<unsigned short>
-		{ SAFEMEMORY_NO_SIDE_EFFECT std::size_t operator()(unsigned short val) const { return static_cast<std::size_t>(val); } };
+	template <typename Policy> struct SAFEMEMORY_DEEP_CONST hash<unsigned short, Policy>
+		{ SAFEMEMORY_NO_SIDE_EFFECT std::size_t operator()(unsigned short val) const { return Policy::integer(static_cast<std::uint64_t>(val)); } };
 
-	template <> struct SAFEMEMORY_DEEP_CONST hash<signed int>
-		{ SAFEMEMORY_NO_SIDE_EFFECT std::size_t operator()(signed int val) const { return static_cast<std::size_t>(val); } };
+	template <typename Policy> struct SAFEMEMORY_DEEP_CONST hash<signed int, Policy>
+		{ SAFEMEMORY_NO_SIDE_EFFECT std::size_t operator()(signed int val) const { return Policy::integer(static_cast<std::uint64_t>(val)); } };
 
-	template <> struct SAFEMEMORY_DEEP_CONST hash<unsigned int>
-		{ SAFEMEMORY_NO_SIDE_EFFECT std::size_t operator()(unsigned int val) const { return static_cast<std::size_t>(val); } };
+	template <typename Policy> struct SAFEMEMORY_DEEP_CONST hash<unsigned int, Policy>
+		{ SAFEMEMORY_NO_SIDE_EFFECT std::size_t operator()(unsigned int val) const { return Policy::integer(static_cast<std::uint64_t>(val)); } };
 
-	template <> struct SAFEMEMORY_DEEP_CONST hash<signed long>
-		{ SAFEMEMORY_NO_SIDE_EFFECT std::size_t operator()(signed long val) const { return static_cast<std::size_t>(val); } };
+	template <typename Policy> struct SAFEMEMORY_DEEP_CONST hash<signed long, Policy>
+		{ SAFEMEMORY_NO_SIDE_EFFECT std::size_t operator()(signed long val) const { return Policy::integer(static_cast<std::uint64_t>(val)); } };
 
-	template <> struct SAFEMEMORY_DEEP_CONST hash<unsigned long>
-		{ SAFEMEMORY_NO_SIDE_EFFECT std::size_t operator()(unsigned long val) const { return static_cast<std::size_t>(val); } };
+	template <typename Policy> struct SAFEMEMORY_DEEP_CONST hash<unsigned long, Policy>
+		{ SAFEMEMORY_NO_SIDE_EFFECT std::size_t operator()(unsigned long val) const { return Policy::integer(static_cast<std::uint64_t>(val)); } };
 
-	template <> struct SAFEMEMORY_DEEP_CONST hash<signed long long>
-		{ SAFEMEMORY_NO_SIDE_EFFECT std::size_t operator()(signed long long val) const { return static_cast<std::size_t>(val); } };
+	template <typename Policy> struct SAFEMEMORY_DEEP_CONST hash<signed long long, Policy>
+		{ SAFEMEMORY_NO_SIDE_EFFECT std::size_t operator()(signed long long val) const { return Policy::integer(static_cast<std::uint64_t>(val)); } };
 
-	template <> struct SAFEMEMORY_DEEP_CONST hash<unsigned long long>
-		{ SAFEMEMORY_NO_SIDE_EFFECT std::size_t operator()(unsigned long long val) const { return static_cast<std::size_t>(val); } };
+	template <typename Policy> struct SAFEMEMORY_DEEP_CONST hash<unsigned long long, Policy>
+		{ SAFEMEMORY_NO_SIDE_EFFECT std::size_t operator()(unsigned long long val) const { return Policy::integer(static_cast<std::uint64_t>(val)); } };
 
-	template <> struct SAFEMEMORY_DEEP_CONST hash<float>
-		{ SAFEMEMORY_NO_SIDE_EFFECT std::size_t operator()(float val) const { return static_cast<std::size_t>(val); } };
+	// mb: floats are hashed by bit pattern, +0.0 and -0.0 compare equal so must hash equal
+	template <typename Policy> struct SAFEMEMORY_DEEP_CONST hash<float, Policy>
+		{ SAFEMEMORY_NO_SIDE_EFFECT std::size_t operator()(float val) const { std::uint32_t b = 0; if(val != 0) std::memcpy(&b, &val, sizeof(b)); return Policy::integer(b); } };
 
-	template <> struct SAFEMEMORY_DEEP_CONST hash<double>
-		{ SAFEMEMORY_NO_SIDE_EFFECT std::size_t operator()(double val) const { return static_cast<std::size_t>(val); } };
+	template <typename Policy> struct SAFEMEMORY_DEEP_CONST hash<double, Policy>
+		{ SAFEMEMORY_NO_SIDE_EFFECT std::size_t operator()(double val) const { std::uint64_t b = 0; if(val != 0) std::memcpy(&b, &val, sizeof(b)); return Policy::integer(b); } };
 
-	template <> struct SAFEMEMORY_DEEP_CONST hash<long double>
-		{ SAFEMEMORY_NO_SIDE_EFFECT std::size_t operator()(long double val) const { return static_cast<std::size_t>(val); } };
+	// mb: long double has padding bytes with unspecified content, go through double
+	template <typename Policy> struct SAFEMEMORY_DEEP_CONST hash<long double, Policy>
+		{ SAFEMEMORY_NO_SIDE_EFFECT std::size_t operator()(long double val) const { return hash<double, Policy>()(static_cast<double>(val)); } };
 
 } //namespace safememory
 
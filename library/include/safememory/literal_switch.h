@@ -0,0 +1,203 @@
+/* -------------------------------------------------------------------------------
+* Copyright (c) 2020, OLogN Technologies AG
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of the OLogN Technologies AG nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL OLogN Technologies AG BE LIABLE FOR ANY
+* DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* -------------------------------------------------------------------------------*/
+
+#ifndef SAFE_MEMORY_LITERAL_SWITCH_H
+#define SAFE_MEMORY_LITERAL_SWITCH_H
+
+#include <safememory/memory_safety.h>
+#include <safememory/string_literal.h>
+#include <safememory/detail/hash_policy.h>
+#include <EASTL/string_view.h>
+#include <cstdint>
+#include <type_traits>
+
+namespace safememory
+{
+	namespace detail {
+		constexpr std::size_t literal_switch_pow2(std::size_t n) {
+			std::size_t r = 1;
+			while(r < n)
+				r <<= 1;
+			return r;
+		}
+	}
+
+	/**
+	 * \brief Maps a string to the index of an equal literal in a fixed set, with a perfect hash.
+	 * 
+	 * The table is built at compile time (hash and displace), lookup is a hash of the string,
+	 * a single slot and a single comparison, whatever the number of literals. The index can be
+	 * used in a \c switch , \c index_of gives \c case labels and \c npos means not found.
+	 * 
+	 *     constexpr auto headers = make_literal_switch("host"_lit, "accept"_lit);
+	 *     switch(headers.find(name)) {
+	 *         case headers.index_of("host"_lit): ...
+	 *         case headers.npos: ...
+	 *     }
+	 * 
+	 * Only literals are stored, so the instance can live anywhere.
+	 */
+	template<typename T, std::size_t N, memory_safety Safety = safeness_declarator<T>::is_safe>
+	class SAFEMEMORY_DEEP_CONST SAFEMEMORY_NO_SIDE_EFFECT_WHEN_CONST basic_literal_switch
+	{
+	public:
+		typedef basic_string_literal<T, Safety> literal_type;
+		typedef std::size_t                     size_type;
+
+		static constexpr size_type npos = N;
+
+	private:
+		static_assert(N > 0);
+
+		static constexpr size_type table_size = detail::literal_switch_pow2(N * 2);
+		static constexpr size_type bucket_count = detail::literal_switch_pow2((N + 1) / 2);
+
+		literal_type keys[N];
+		std::uint32_t displacement[bucket_count] = {};
+		// index + 1, zero is empty
+		std::uint32_t slots[table_size] = {};
+
+		static constexpr size_type bucketOf(std::uint32_t h) noexcept {
+			return detail::hash_mix32(h) & (bucket_count - 1);
+		}
+
+		static constexpr size_type slotOf(std::uint32_t h, std::uint32_t d) noexcept {
+			return detail::hash_mix32(h ^ (d * 0x9e3779b9U)) & (table_size - 1);
+		}
+
+		static constexpr bool sameChars(const literal_type& a, const literal_type& b) {
+			if(a.size() != b.size())
+				return false;
+			for(size_type i = 0; i != a.size(); ++i) {
+				if(a[i] != b[i])
+					return false;
+			}
+			return true;
+		}
+
+		[[noreturn]] static void ThrowDuplicated() { throw nodecpp::error::out_of_range; }
+		[[noreturn]] static void ThrowNotFound() { throw nodecpp::error::out_of_range; }
+
+		//mb: larger buckets are placed first, each one looking for a displacement
+		// that sends all its keys to free slots
+		constexpr void build() {
+			//mb: keys with the same hash can't be placed apart, that also catches duplicated ones
+			for(size_type i = 0; i != N; ++i) {
+				for(size_type j = i + 1; j != N; ++j) {
+					if(keys[i].hash() == keys[j].hash())
+						ThrowDuplicated();
+				}
+			}
+
+			size_type count[bucket_count] = {};
+			for(size_type i = 0; i != N; ++i)
+				++count[bucketOf(keys[i].hash())];
+
+			for(size_type sz = N; sz != 0; --sz) {
+				for(size_type b = 0; b != bucket_count; ++b) {
+					if(count[b] != sz)
+						continue;
+
+					for(std::uint32_t d = 0; ; ++d) {
+						size_type taken[N] = {};
+						size_type n = 0;
+						bool ok = true;
+						for(size_type i = 0; i != N && ok; ++i) {
+							if(bucketOf(keys[i].hash()) != b)
+								continue;
+							size_type s = slotOf(keys[i].hash(), d);
+							ok = slots[s] == 0;
+							for(size_type k = 0; k != n && ok; ++k)
+								ok = taken[k] != s;
+							taken[n++] = s;
+						}
+
+						if(ok) {
+							n = 0;
+							for(size_type i = 0; i != N; ++i) {
+								if(bucketOf(keys[i].hash()) == b)
+									slots[taken[n++]] = static_cast<std::uint32_t>(i + 1);
+							}
+							displacement[b] = d;
+							break;
+						}
+					}
+				}
+			}
+		}
+
+		size_type findImpl(std::uint32_t h, eastl::basic_string_view<T> v) const noexcept {
+			std::uint32_t ix = slots[slotOf(h, displacement[bucketOf(h)])];
+			if(ix == 0)
+				return npos;
+
+			const literal_type& k = keys[ix - 1];
+			if(k.hash() == h && k.size() == v.size() && eastl::Compare(k.data(), v.data(), v.size()) == 0)
+				return ix - 1;
+			else
+				return npos;
+		}
+
+	public:
+		template<class... L>
+		constexpr basic_literal_switch(const L&... lits) : keys{lits...} {
+			static_assert(sizeof...(L) == N);
+			build();
+		}
+
+		constexpr size_type size() const noexcept { return N; }
+		constexpr const literal_type& operator[](size_type i) const { return keys[i]; }
+
+		/// index of \p lit , for \c case labels. A literal not in the set doesn't compile
+		constexpr size_type index_of(const literal_type& lit) const {
+			for(size_type i = 0; i != N; ++i) {
+				if(sameChars(keys[i], lit))
+					return i;
+			}
+			ThrowNotFound();
+		}
+
+		/// index of the literal equal to \p str , or \c npos
+		/// \p str may be a \c basic_string , \c basic_string_view or \c basic_string_literal
+		template<class Str>
+		size_type find(const Str& str) const noexcept {
+			auto v = str.to_string_view_unsafe();
+			if constexpr (std::is_base_of_v<literal_type, Str>)
+				return findImpl(str.hash(), v);
+			else
+				return findImpl(detail::fnv1a_32(v.data(), v.size()), v);
+		}
+	};
+
+	template<class T, memory_safety S, class... L>
+	constexpr basic_literal_switch<T, sizeof...(L) + 1, S> make_literal_switch(const basic_string_literal<T, S>& first, const L&... rest) {
+		return basic_literal_switch<T, sizeof...(L) + 1, S>(first, rest...);
+	}
+
+} //namespace safememory
+
+#endif //SAFE_MEMORY_LITERAL_SWITCH_H
@@ -0,0 +1,275 @@
+/* -------------------------------------------------------------------------------
+* Copyright (c) 2020, OLogN Technologies AG
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of the OLogN Technologies AG nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL OLogN Technologies AG BE LIABLE FOR ANY
+* DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* -------------------------------------------------------------------------------*/
+
+
+
+#ifndef SAFE_MEMORY_RING_BUFFER_H
+#define SAFE_MEMORY_RING_BUFFER_H
+
+#include <utility>
+#include <initializer_list>
+#include <EASTL/iterator.h>
+#include <EASTL/algorithm.h>
+#include <safememory/detail/allocator_to_eastl.h>
+#include <safememory/detail/circular_buffer.h>
+#include <safememory/detail/circular_buffer_iterator.h>
+#include <safe_memory_error.h>
+
+namespace safememory
+{
+	/**
+	 * \brief Fixed capacity circular queue (see detail/circular_buffer.h)
+	 * 
+	 * Same as \c eastl::ring_buffer, when the buffer is full \c push_back overwrites the
+	 * front element and \c push_front overwrites the back one. Only \c set_capacity and
+	 * \c reserve reallocate, any other change keeps iterators pointing inside the same array.
+	 * A ring buffer with zero capacity (i.e. a zeroed or destructed one) discards any push.
+	 */
+	template <typename T, memory_safety Safety = safeness_declarator<T>::is_safe>
+	class SAFEMEMORY_DEEP_CONST_WHEN_PARAMS ring_buffer
+		: protected detail::circular_buffer<T, detail::allocator_to_eastl_deque<Safety>>
+	{
+	public:
+		typedef detail::circular_buffer<T, detail::allocator_to_eastl_deque<Safety>>  base_type;
+		typedef ring_buffer<T, Safety>                                            this_type;
+
+		typedef typename base_type::value_type                                    value_type;
+		typedef typename base_type::size_type                                     size_type;
+		typedef typename base_type::difference_type                               difference_type;
+		typedef typename base_type::reference                                     reference;
+		typedef typename base_type::const_reference                               const_reference;
+		typedef value_type*                                                       pointer;
+		typedef const value_type*                                                 const_pointer;
+		typedef typename base_type::allocator_type                                allocator_type;
+		typedef typename base_type::iterator                                      iterator_base;
+		typedef typename base_type::const_iterator                                const_iterator_base;
+
+		typedef typename detail::circular_buffer_stack_only_iterator<iterator_base, iterator_base, allocator_type>       stack_only_iterator;
+		typedef typename detail::circular_buffer_stack_only_iterator<const_iterator_base, iterator_base, allocator_type>  const_stack_only_iterator;
+		typedef typename detail::circular_buffer_heap_safe_iterator<iterator_base, iterator_base, allocator_type>        heap_safe_iterator;
+		typedef typename detail::circular_buffer_heap_safe_iterator<const_iterator_base, iterator_base, allocator_type>   const_heap_safe_iterator;
+
+	    static constexpr memory_safety is_safe = allocator_type::is_safe;
+		static constexpr bool use_base_iterator = (is_safe == memory_safety::none);
+		
+		typedef std::conditional_t<use_base_iterator, iterator_base, stack_only_iterator>               iterator;
+		typedef std::conditional_t<use_base_iterator, const_iterator_base, const_stack_only_iterator>   const_iterator;
+		typedef eastl::reverse_iterator<iterator>                                                       reverse_iterator;
+		typedef eastl::reverse_iterator<const_iterator>                                                 const_reverse_iterator;
+
+		typedef heap_safe_iterator                                                    iterator_safe;
+		typedef const_heap_safe_iterator                                              const_iterator_safe;
+		typedef eastl::reverse_iterator<iterator_safe>                                reverse_iterator_safe;
+		typedef eastl::reverse_iterator<const_iterator_safe>                          const_reverse_iterator_safe;
+
+	public:
+		ring_buffer() {}
+		explicit ring_buffer(size_type capacity) { base_type::reallocate(capacity); }
+		ring_buffer(const this_type& x) = default;
+		ring_buffer(this_type&& x) = default;
+		/// capacity is the size of \c ilist
+		ring_buffer(std::initializer_list<value_type> ilist) {
+			base_type::reallocate(ilist.size());
+			for(const auto& each : ilist)
+				base_type::emplace_back_unchecked(each);
+		}
+
+		~ring_buffer() = default;
+
+		this_type& operator=(const this_type& x) = default;
+		this_type& operator=(this_type&& x) = default;
+
+		void swap(this_type& x) noexcept { base_type::swap(x); }
+
+		iterator       begin() noexcept { return makeIt(base_type::begin()); }
+		const_iterator begin() const noexcept { return makeIt(base_type::begin()); }
+		const_iterator cbegin() const noexcept { return makeIt(base_type::cbegin()); }
+
+		iterator       end() noexcept { return makeIt(base_type::end()); }
+		const_iterator end() const noexcept { return makeIt(base_type::end()); }
+		const_iterator cend() const noexcept { return makeIt(base_type::cend()); }
+
+		reverse_iterator       rbegin() noexcept { return reverse_iterator(end()); }
+		const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+
+		reverse_iterator       rend() noexcept { return reverse_iterator(begin()); }
+		const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+		iterator_safe       begin_safe() { return makeSafeIt(base_type::begin()); }
+		const_iterator_safe begin_safe() const { return makeSafeIt(base_type::begin()); }
+		const_iterator_safe cbegin_safe() const { return makeSafeIt(base_type::cbegin()); }
+
+		iterator_safe       end_safe() { return makeSafeIt(base_type::end()); }
+		const_iterator_safe end_safe() const { return makeSafeIt(base_type::end()); }
+		const_iterator_safe cend_safe() const { return makeSafeIt(base_type::cend()); }
+
+		reverse_iterator_safe       rbegin_safe() { return reverse_iterator_safe(end_safe()); }
+		const_reverse_iterator_safe rbegin_safe() const { return const_reverse_iterator_safe(end_safe()); }
+
+		reverse_iterator_safe       rend_safe() { return reverse_iterator_safe(begin_safe()); }
+		const_reverse_iterator_safe rend_safe() const { return const_reverse_iterator_safe(begin_safe()); }
+
+		using base_type::empty;
+		using base_type::size;
+		using base_type::capacity;
+		using base_type::full;
+		using base_type::clear;
+
+		/// changes capacity, when lower than \c size() the oldest (front) elements are dropped
+		void set_capacity(size_type n) {
+			if(n != capacity()) {
+				base_type::truncate_front(n);
+				base_type::reallocate(n);
+			}
+		}
+
+		/// only grows capacity, for compatibility with other containers
+		void reserve(size_type n) {
+			if(n > capacity())
+				base_type::reallocate(n);
+		}
+
+		reference       operator[](size_type n) { checkIndex(n); return base_type::at_unchecked(n); }
+		const_reference operator[](size_type n) const { checkIndex(n); return base_type::at_unchecked(n); }
+
+		reference at(size_type n) {
+			if(NODECPP_UNLIKELY(n >= size()))
+				ThrowRangeException();
+			return base_type::at_unchecked(n);
+		}
+
+		const_reference at(size_type n) const {
+			if(NODECPP_UNLIKELY(n >= size()))
+				ThrowRangeException();
+			return base_type::at_unchecked(n);
+		}
+
+		reference       front() { checkNotEmpty(); return base_type::at_unchecked(0); }
+		const_reference front() const { checkNotEmpty(); return base_type::at_unchecked(0); }
+
+		reference       back() { checkNotEmpty(); return base_type::at_unchecked(size() - 1); }
+		const_reference back() const { checkNotEmpty(); return base_type::at_unchecked(size() - 1); }
+
+		void push_back(const value_type& value) { emplace_back(value); }
+		void push_back(value_type&& value) { emplace_back(std::move(value)); }
+
+		void push_front(const value_type& value) { emplace_front(value); }
+		void push_front(value_type&& value) { emplace_front(std::move(value)); }
+
+		template <class... Args>
+		void emplace_back(Args&&... args) {
+			if(NODECPP_UNLIKELY(base_type::full())) {
+				if(capacity() != 0)
+					base_type::emplace_back_overwrite(std::forward<Args>(args)...);
+			}
+			else
+				base_type::emplace_back_unchecked(std::forward<Args>(args)...);
+		}
+
+		template <class... Args>
+		void emplace_front(Args&&... args) {
+			if(NODECPP_UNLIKELY(base_type::full())) {
+				if(capacity() != 0)
+					base_type::emplace_front_overwrite(std::forward<Args>(args)...);
+			}
+			else
+				base_type::emplace_front_unchecked(std::forward<Args>(args)...);
+		}
+
+		void pop_back() { checkNotEmpty(); base_type::pop_back(); }
+		void pop_front() { checkNotEmpty(); base_type::pop_front(); }
+
+		bool operator==(const this_type& other) const {
+			return size() == other.size() && eastl::equal(base_type::begin(), base_type::end(), other.base_type::begin());
+		}
+		bool operator!=(const this_type& other) const {
+			return !operator==(other);
+		}
+
+		iterator_safe make_safe(const iterator& it) { return makeSafeIt(toBase(it)); }
+		const_iterator_safe make_safe(const const_iterator& it) const { return makeSafeIt(toBase(it)); }
+
+	protected:
+		[[noreturn]] static void ThrowRangeException() { throw nodecpp::error::out_of_range; }
+
+		void checkIndex(size_type n) const {
+			if constexpr(is_safe == memory_safety::safe) {
+				if(NODECPP_UNLIKELY(n >= size()))
+					ThrowRangeException();
+			}
+		}
+
+		void checkNotEmpty() const {
+			if constexpr(is_safe == memory_safety::safe) {
+				if(NODECPP_UNLIKELY(empty()))
+					ThrowRangeException();
+			}
+		}
+
+		const iterator_base& toBase(const iterator_base& it) const { return it; }
+		const const_iterator_base& toBase(const const_iterator_base& it) const { return it; }
+		const iterator_base& toBase(const stack_only_iterator& it) const { return it.toBase(); }
+		const const_iterator_base& toBase(const const_stack_only_iterator& it) const { return it.toBase(); }
+
+		iterator makeIt(const iterator_base& it) const {
+			if constexpr(use_base_iterator)
+				return it;
+			else
+				return iterator::fromBase(it);
+		}
+
+		const_iterator makeIt(const const_iterator_base& it) const {
+			if constexpr(use_base_iterator)
+				return it;
+			else
+				return const_iterator::fromBase(it);
+		}
+
+		iterator_safe makeSafeIt(const iterator_base& it) const {
+			return iterator_safe::makeIt(it, base_type::array_ptr());
+		}
+
+		const_iterator_safe makeSafeIt(const const_iterator_base& it) const {
+			return const_iterator_safe::makeIt(it, base_type::array_ptr());
+		}
+	}; // ring_buffer
+
+
+	///////////////////////////////////////////////////////////////////////
+	// global operators
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename T, memory_safety Safety>
+	inline void swap(ring_buffer<T, Safety>& a, ring_buffer<T, Safety>& b) 
+	{
+		a.swap(b);
+	}
+
+} // namespace safememory
+
+
+#endif //SAFE_MEMORY_RING_BUFFER_H
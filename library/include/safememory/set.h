@@ -0,0 +1,364 @@
+/* -------------------------------------------------------------------------------
+* Copyright (c) 2020, OLogN Technologies AG
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of the OLogN Technologies AG nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL OLogN Technologies AG BE LIABLE FOR ANY
+* DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* -------------------------------------------------------------------------------*/
+
+
+#ifndef SAFE_MEMORY_SET_H
+#define SAFE_MEMORY_SET_H
+
+#include <utility>
+#include <initializer_list>
+#include <EASTL/utility.h>
+#include <safememory/functional.h>
+#include <safememory/detail/allocator_to_eastl.h>
+#include <safememory/detail/btree.h>
+#include <safememory/detail/btree_iterator.h>
+
+
+namespace safememory
+{
+	/**
+	 * \brief Ordered set, implemented as a B-tree (see detail/btree.h)
+	 * 
+	 * Same as \c map, a zeroed or destructed instance is a valid empty set.
+	 * Values can't be modified throught iterators, so \c iterator and \c const_iterator are the same.
+	 */
+	template <typename Key, typename Compare = less<Key>, 
+			  memory_safety Safety = safeness_declarator<Key>::is_safe>
+	class SAFEMEMORY_DEEP_CONST_WHEN_PARAMS set
+		: protected detail::btree<Key, Key, Compare,
+			detail::allocator_to_eastl_btree<Safety>, eastl::use_self<Key>>
+	{
+	public:
+		typedef detail::btree<Key, Key, Compare,
+			detail::allocator_to_eastl_btree<Safety>, eastl::use_self<Key>>   base_type;
+		typedef set<Key, Compare, Safety>                                         this_type;
+
+		// everything below this line is similar to map, but:
+		// remove at and operator[]
+		// remove try_emplace and insert_or_assign
+		// only const iterators
+
+		typedef typename base_type::size_type                                     size_type;
+		typedef typename base_type::key_type                                      key_type;
+		typedef typename base_type::value_type                                    value_type;
+		typedef typename base_type::key_compare                                   key_compare;
+		typedef typename base_type::allocator_type                                allocator_type;
+		typedef typename base_type::node_type                                     node_type;
+		typedef typename base_type::iterator                                      iterator_base;
+		typedef typename base_type::const_iterator                                const_iterator_base;
+		typedef typename base_type::insert_return_type                            insert_return_type_base;
+
+		typedef typename detail::btree_stack_only_iterator<const_iterator_base, iterator_base, allocator_type>  const_stack_only_iterator;
+		typedef typename detail::btree_heap_safe_iterator<const_iterator_base, iterator_base, allocator_type>   const_heap_safe_iterator;
+
+	    static constexpr memory_safety is_safe = allocator_type::is_safe;
+		static constexpr bool use_base_iterator = (is_safe == memory_safety::none);
+		
+		typedef std::conditional_t<use_base_iterator, const_iterator_base, const_stack_only_iterator>   const_iterator;
+		typedef const_iterator                                                                          iterator;
+		typedef eastl::pair<iterator, bool>                                                             insert_return_type;
+
+		typedef const_heap_safe_iterator                                              const_iterator_safe;
+		typedef const_iterator_safe                                                   iterator_safe;
+		typedef eastl::pair<iterator_safe, bool>                                      insert_return_type_safe;
+
+	public:
+		set() {}
+		explicit set(const key_compare& compare) : base_type(compare) {}
+		set(const this_type& x) = default;
+		set(this_type&& x) = default;
+		set(std::initializer_list<value_type> ilist, const key_compare& compare = key_compare())
+			: base_type(compare) {
+			insert(ilist);
+		}
+
+		~set() = default;
+
+		this_type& operator=(const this_type& x) = default;
+		this_type& operator=(this_type&& x) = default;
+		this_type& operator=(std::initializer_list<value_type> ilist) {
+			base_type::clear();
+			insert(ilist);
+			return *this;
+		}
+
+		void swap(this_type& x) noexcept { base_type::swap(x); }
+
+		const_iterator begin() const { return makeIt(base_type::begin()); }
+		const_iterator cbegin() const { return makeIt(base_type::cbegin()); }
+
+		const_iterator end() const { return makeIt(base_type::end()); }
+		const_iterator cend() const { return makeIt(base_type::cend()); }
+
+		const_iterator_safe begin_safe() const { return makeSafeIt(base_type::begin()); }
+		const_iterator_safe cbegin_safe() const { return makeSafeIt(base_type::cbegin()); }
+
+		const_iterator_safe end_safe() const { return makeSafeIt(base_type::end()); }
+		const_iterator_safe cend_safe() const { return makeSafeIt(base_type::cend()); }
+
+		using base_type::empty;
+		using base_type::size;
+		using base_type::key_comp;
+
+		template <class... Args>
+		insert_return_type emplace(Args&&... args) {
+			return makeIt(base_type::emplace_unique(std::forward<Args>(args)...));
+		}
+
+		template <class... Args>
+		insert_return_type_safe emplace_safe(Args&&... args) {
+			return makeSafeIt(base_type::emplace_unique(std::forward<Args>(args)...));
+		}
+
+		// mb: hint is ignored, ascending inserts are already fast on the underlying btree
+		template <class... Args>
+		iterator emplace_hint(const const_iterator&, Args&&... args) {
+			return makeIt(base_type::emplace_unique(std::forward<Args>(args)...).first);
+		}
+
+		template <class... Args>
+		iterator_safe emplace_hint_safe(const const_iterator_safe&, Args&&... args) {
+			return makeSafeIt(base_type::emplace_unique(std::forward<Args>(args)...).first);
+		}
+
+		insert_return_type insert(const value_type& value) {
+			return makeIt(base_type::insert_unique(value));
+		}
+
+		insert_return_type_safe insert_safe(const value_type& value) {
+			return makeSafeIt(base_type::insert_unique(value));
+		}
+
+		insert_return_type insert(value_type&& value) {
+			return makeIt(base_type::insert_unique(std::move(value)));
+		}
+
+		insert_return_type_safe insert_safe(value_type&& value) {
+			return makeSafeIt(base_type::insert_unique(std::move(value)));
+		}
+
+		void insert(std::initializer_list<value_type> ilist) {
+			for(const auto& each : ilist)
+				base_type::insert_unique(each);
+		}
+
+		template <typename InputIterator>
+		void insert_unsafe(InputIterator first, InputIterator last) {
+			for(; first != last; ++first)
+				base_type::insert_unique(*first);
+		}
+
+		iterator erase(const const_iterator& position) {
+			return makeIt(base_type::erase(toDerefBase(position)));
+		}
+
+		iterator_safe erase_safe(const const_iterator_safe& position) {
+			return makeSafeIt(base_type::erase(toDerefBase(position)));
+		}
+
+		iterator erase(const const_iterator& first, const const_iterator& last) {
+			return makeIt(eraseRange(toBase(first), toBase(last)));
+		}
+
+		iterator_safe erase_safe(const const_iterator_safe& first, const const_iterator_safe& last) {
+			return makeSafeIt(eraseRange(toBase(first), toBase(last)));
+		}
+
+		size_type erase(const key_type& k) {
+			return base_type::erase_key(k);
+		}
+
+		void clear() { base_type::clear(); }
+
+		const_iterator find(const key_type& key) const { return makeIt(base_type::find(key)); }
+		const_iterator_safe find_safe(const key_type& key) const { return makeSafeIt(base_type::find(key)); }
+
+		size_type count(const key_type& k) const { return base_type::count(k); }
+		bool contains(const key_type& k) const { return base_type::count(k) != 0; }
+
+		const_iterator lower_bound(const key_type& key) const { return makeIt(base_type::lower_bound(key)); }
+		const_iterator_safe lower_bound_safe(const key_type& key) const { return makeSafeIt(base_type::lower_bound(key)); }
+
+		const_iterator upper_bound(const key_type& key) const { return makeIt(base_type::upper_bound(key)); }
+		const_iterator_safe upper_bound_safe(const key_type& key) const { return makeSafeIt(base_type::upper_bound(key)); }
+
+		eastl::pair<const_iterator, const_iterator> equal_range(const key_type& k) const {
+			auto p = base_type::equal_range(k);
+			return { makeIt(p.first), makeIt(p.second) };
+		}
+
+		eastl::pair<const_iterator_safe, const_iterator_safe> equal_range_safe(const key_type& k) const {
+			auto p = base_type::equal_range(k);
+			return { makeSafeIt(p.first), makeSafeIt(p.second) };
+		}
+
+		using base_type::validate;
+		int validate_iterator(const_iterator_base it) const noexcept { return base_type::validate_iterator(it); }
+		int validate_iterator(const const_stack_only_iterator& it) const noexcept { return base_type::validate_iterator(it.toBase()); }
+		int validate_iterator(const const_heap_safe_iterator& it) const noexcept { return base_type::validate_iterator(it.toBase()); }
+
+		bool operator==(const this_type& other) const {
+			return size() == other.size() && eastl::equal(base_type::begin(), base_type::end(), other.base_type::begin());
+		}
+		bool operator!=(const this_type& other) const {
+			return !operator==(other);
+		}
+
+		const_iterator_safe make_safe(const const_iterator& it) const {	return makeSafeIt(toBase(it)); }
+
+	protected:
+		[[noreturn]] static void ThrowRangeException() { throw nodecpp::error::out_of_range; }
+
+		iterator_base eraseRange(const const_iterator_base& first, const const_iterator_base& last) {
+			size_type n = base_type::distance(first, last);
+			if constexpr (is_safe == memory_safety::safe) {
+				if(n == base_type::npos)
+					ThrowRangeException();
+			}
+			return base_type::erase(first, n);
+		}
+
+		// position to erase must be dereferenceable, base erase doesn't check it
+		const_iterator_base toDerefBase(const const_iterator_base& it) const { return it; }
+		const_iterator_base toDerefBase(const const_stack_only_iterator& it) const { it.checkDerefenceable(); return it.toBase(); }
+		const_iterator_base toDerefBase(const const_heap_safe_iterator& it) const { it.checkDerefenceable(); return it.toBase(); }
+
+		const const_iterator_base& toBase(const const_iterator_base& it) const { return it; }
+		const const_iterator_base& toBase(const const_stack_only_iterator& it) const { return it.toBase(); }
+		const const_iterator_base& toBase(const const_heap_safe_iterator& it) const { return it.toBase(); }
+
+		const_iterator makeIt(const const_iterator_base& it) const {
+			if constexpr(use_base_iterator)
+				return it;
+			else
+				return const_iterator::fromBase(it);
+		}
+
+		insert_return_type makeIt(const insert_return_type_base& r) const {
+			return { makeIt(const_iterator_base(r.first)), r.second };
+		}
+
+		const_iterator_safe makeSafeIt(const const_iterator_base& it) const {
+			return const_iterator_safe::makeIt(it, base_type::node_pointer(it.get_node()));
+		}
+
+		insert_return_type_safe makeSafeIt(const insert_return_type_base& r) const {
+			return { makeSafeIt(const_iterator_base(r.first)), r.second };
+		}
+	}; // set
+
+
+	// set_safe is kind of wrapper that forwards calls to their 'safe' counterpart.
+	// i.e. 'begin' -> 'begin_safe', 'end' -> 'end_safe' and so and so.
+	// this is useful for benchmarks and for tests
+	template <typename Key, typename Compare = less<Key>, 
+			  memory_safety Safety = safeness_declarator<Key>::is_safe>
+	class SAFEMEMORY_DEEP_CONST_WHEN_PARAMS set_safe
+		: public set<Key, Compare, Safety>
+	{
+	public:
+		typedef set<Key, Compare, Safety>                                         base_type;
+		typedef set_safe<Key, Compare, Safety>                                    this_type;
+
+		using typename base_type::size_type;
+		using typename base_type::key_type;
+		using typename base_type::value_type;
+		using typename base_type::key_compare;
+
+		typedef typename base_type::const_iterator_safe                           iterator;
+		typedef typename base_type::const_iterator_safe                           const_iterator;
+		typedef typename base_type::insert_return_type_safe                       insert_return_type;
+
+	public:
+		set_safe(): base_type() {}
+		explicit set_safe(const key_compare& compare) : base_type(compare) {}
+		set_safe(const this_type& x) = default;
+		set_safe(this_type&& x) = default;
+		set_safe(std::initializer_list<value_type> ilist, const key_compare& compare = key_compare())
+			: base_type(ilist, compare) {}
+
+		~set_safe() = default;
+
+		this_type& operator=(const this_type& x) = default;
+		this_type& operator=(this_type&& x) = default;
+		this_type& operator=(std::initializer_list<value_type> ilist) { 
+			base_type::operator=(ilist);
+			return *this;
+		}
+
+		const_iterator begin() const { return base_type::begin_safe(); }
+		const_iterator cbegin() const { return base_type::cbegin_safe(); }
+
+		const_iterator end() const { return base_type::end_safe(); }
+		const_iterator cend() const { return base_type::cend_safe(); }
+
+		template <class... Args>
+		insert_return_type emplace(Args&&... args) {
+			return base_type::emplace_safe(std::forward<Args>(args)...);
+		}
+
+		template <class... Args>
+		iterator emplace_hint(const_iterator hint, Args&&... args) {
+			return base_type::emplace_hint_safe(hint, std::forward<Args>(args)...);
+		}
+
+		insert_return_type insert(const value_type& value) {
+			return base_type::insert_safe(value);
+		}
+
+		insert_return_type insert(value_type&& value) {
+			return base_type::insert_safe(std::move(value));
+		}
+
+		void insert(std::initializer_list<value_type> ilist) { base_type::insert(ilist); }
+
+		iterator erase(const_iterator position) { return base_type::erase_safe(position); }
+		iterator erase(const_iterator first, const_iterator last) { return base_type::erase_safe(first, last); }
+		size_type erase(const key_type& k) { return base_type::erase(k); }
+
+		const_iterator find(const key_type& key) const { return base_type::find_safe(key); }
+		const_iterator lower_bound(const key_type& key) const { return base_type::lower_bound_safe(key); }
+		const_iterator upper_bound(const key_type& key) const { return base_type::upper_bound_safe(key); }
+
+		eastl::pair<const_iterator, const_iterator> equal_range(const key_type& k) const { return base_type::equal_range_safe(k); }
+	}; // set_safe
+
+
+	///////////////////////////////////////////////////////////////////////
+	// global operators
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename K, typename C, memory_safety S>
+	inline void swap(set<K, C, S>& a, set<K, C, S>& b)
+	{
+		a.swap(b);
+	}
+
+} // namespace safememory
+
+
+#endif //SAFE_MEMORY_SET_H
@@ -38,7 +38,10 @@
 #include <safememory/vector.h>
 #include <safememory/array.h>
 #include <safememory/unordered_map.h>
+#include <safememory/map.h>
+#include <safememory/deque.h>
 #include <safememory/string.h>
+#include <safememory/string_view.h>
 #include <safememory/string_format.h>
 #include <EASTL/utility.h>
 
@@ -56,12 +59,20 @@ namespace sm
 	template<class Key, class T, class Hash = safememory::hash<Key>, class Predicate = safememory::equal_to<Key>>
 	using unordered_map = safememory::unordered_map<Key, T, Hash, Predicate>;
 
+	template<class Key, class T, class Compare = safememory::less<Key>>
+	using map = safememory::map<Key, T, Compare>;
+
+	template<class T>
+	using deque = safememory::deque<T>;
+
 	template<class CharT>
 	using basic_string = safememory::basic_string<CharT>;
 
 	typedef basic_string<char>    string;
 	typedef basic_string<wchar_t> wstring;
 
+	using safememory::string_view;
+
 	using safememory::to_string;
 	using safememory::to_wstring;
 
@@ -77,8 +88,11 @@ namespace sm
 //std containers with iibmalloc allocator
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_map>
+#include <map>
+#include <deque>
 #include <array>
 #include <utility>
 #include <safememory/detail/safe_ptr_common.h>
@@ -99,12 +113,20 @@ namespace sm
 	template<class Key, class T, class Hash = std::hash<Key>, class Predicate = std::equal_to<Key>>
 	using unordered_map = std::unordered_map<Key, T, Hash, Predicate, iiballocator<std::pair<const Key,T>>>;
 
+	template<class Key, class T, class Compare = std::less<Key>>
+	using map = std::map<Key, T, Compare, iiballocator<std::pair<const Key,T>>>;
+
+	template<class T>
+	using deque = std::deque<T, iiballocator<T>>;
+
 	template<class CharT>
 	using basic_string = std::basic_string<CharT, std::char_traits<CharT>, iiballocator<CharT>>;
 
 	typedef basic_string<char>    string;
 	typedef basic_string<wchar_t> wstring;
 
+	using std::string_view;
+
 	// TODO must add functions for to_string
 	// using std::to_string;
 	// using std::to_wstring;
@@ -119,8 +141,11 @@ namespace sm
 //just use std containers with std allocator
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_map>
+#include <map>
+#include <deque>
 #include <array>
 #include <utility>
 
@@ -138,12 +163,20 @@ namespace sm
 	template<class Key, class T, class Hash = std::hash<Key>, class Predicate = std::equal_to<Key>>
 	using unordered_map = std::unordered_map<Key, T, Hash, Predicate>;
 
+	template<class Key, class T, class Compare = std::less<Key>>
+	using map = std::map<Key, T, Compare>;
+
+	template<class T>
+	using deque = std::deque<T>;
+
 	template<class T>
 	using basic_string = std::basic_string<char>;
 
 	typedef basic_string<char>    string;
 	typedef basic_string<wchar_t> wstring;
 
+	using std::string_view;
+
 	using std::to_string;
 	using std::to_wstring;
 
@@ -0,0 +1,429 @@
+/* -------------------------------------------------------------------------------
+* Copyright (c) 2020, OLogN Technologies AG
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of the OLogN Technologies AG nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL OLogN Technologies AG BE LIABLE FOR ANY
+* DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* -------------------------------------------------------------------------------*/
+
+
+
+#ifndef SAFE_MEMORY_STABLE_VECTOR_H
+#define SAFE_MEMORY_STABLE_VECTOR_H
+
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <type_traits>
+#include <EASTL/iterator.h>
+#include <EASTL/vector.h>
+#include <safememory/detail/allocator_to_eastl.h>
+#include <safe_memory_error.h>
+
+/** \file
+ * \brief Slot map with generation checked handles.
+ * 
+ * Elements are constructed in place in fixed size chunks, allocated through \c allocator_to_eastl
+ * as \c vector does, and never move while the container is alive. Adding a chunk only grows the
+ * small table of chunk pointers, the same for the generation of each slot and the list of free slots.
+ * 
+ * A \c stable_vector_handle is the slot index and the generation of the slot when the element
+ * was inserted. Erase bumps the generation, so any copy of the handle fails the O(1) check from
+ * then on, and the slot is reused by a later insert. A handle is plain data, it can be stored
+ * anywhere and outlive both the element and the container without becoming a dangling reference.
+ * 
+ * This is the alternative to \c vector<owning_ptr<T>> when long lived references to elements of
+ * a growing collection are needed, with one allocation per chunk instead of one per element, and
+ * elements contiguous inside each chunk for iteration.
+ */
+
+namespace safememory
+{
+	/// Reference to an element of a \c stable_vector. Generation is odd while the slot is occupied,
+	/// so a default constructed handle is never valid.
+	struct stable_vector_handle
+	{
+		uint32_t index = 0;
+		uint32_t generation = 0;
+
+		bool operator==(const stable_vector_handle& other) const noexcept {
+			return index == other.index && generation == other.generation;
+		}
+		bool operator!=(const stable_vector_handle& other) const noexcept {
+			return !operator==(other);
+		}
+	};
+
+	namespace detail {
+
+	/**
+	 * \brief Forward iterator over the occupied slots of a \c stable_vector
+	 * 
+	 * It is the container and a slot index, so it is not invalidated by inserts.
+	 * Like \c vector regular iterators it is a stack only object, long lived references
+	 * should use \c get_handle instead.
+	 */
+	template <typename Owner, typename Pointer, typename Reference>
+	class stable_vector_iterator
+	{
+	public:
+		typedef stable_vector_iterator<Owner, Pointer, Reference>                        this_type;
+		typedef stable_vector_iterator<Owner, typename Owner::pointer, typename Owner::reference>  this_type_non_const;
+		typedef typename Owner::value_type                                               value_type;
+		typedef Pointer                                                                  pointer;
+		typedef Reference                                                                reference;
+		typedef eastl_ssize_t                                                            difference_type;
+		typedef EASTL_ITC_NS::forward_iterator_tag                                       iterator_category;
+
+		static constexpr memory_safety is_safe = Owner::is_safe;
+
+		template <typename, typename, typename>
+		friend class stable_vector_iterator;
+		friend Owner;
+
+	protected:
+		const Owner* mpOwner = nullptr;
+		uint32_t     mIndex = 0;
+
+		stable_vector_iterator(const Owner* owner, uint32_t index) : mpOwner(owner), mIndex(index) {}
+
+		[[noreturn]] static void ThrowNullException() { throw nodecpp::error::zero_pointer_access; }
+
+	public:
+		stable_vector_iterator() {}
+		stable_vector_iterator(const this_type&) = default;
+		stable_vector_iterator& operator=(const this_type&) = default;
+
+		template <typename It, std::enable_if_t<std::is_same_v<It, this_type_non_const> && !std::is_same_v<It, this_type>, bool> = true>
+		stable_vector_iterator(const It& it) : mpOwner(it.mpOwner), mIndex(it.mIndex) {}
+
+		reference operator*() const { return *get_ptr(); }
+		pointer operator->() const { return get_ptr(); }
+
+		this_type& operator++() { checkOwner(); mIndex = mpOwner->next_occupied(mIndex + 1); return *this; }
+		this_type operator++(int) { this_type temp(*this); operator++(); return temp; }
+
+		bool operator==(const this_type& other) const { return mpOwner == other.mpOwner && mIndex == other.mIndex; }
+		bool operator!=(const this_type& other) const { return !operator==(other); }
+
+		/// handle of the element, same as the one returned when it was inserted
+		stable_vector_handle get_handle() const { get_ptr(); return mpOwner->handle_of(mIndex); }
+
+	protected:
+		void checkOwner() const {
+			if constexpr(is_safe == memory_safety::safe) {
+				if(NODECPP_UNLIKELY(mpOwner == nullptr))
+					ThrowNullException();
+			}
+		}
+
+		pointer get_ptr() const {
+			checkOwner();
+			return mpOwner->checked_slot(mIndex);
+		}
+	};
+
+	} // namespace detail
+
+
+	/**
+	 * \brief Container of elements that never move, accessed by \c stable_vector_handle (see file description)
+	 * 
+	 * Insert returns the handle, \c at and (on \c safe ) \c operator[] throw when the handle was erased,
+	 * and \c find and \c contains test it without throwing. A handle is only an index and a generation,
+	 * it doesn't know its container, so a handle from another container is not detected when that
+	 * slot and generation are also live here, it just names another element.
+	 * Iteration visits occupied slots in index order, which is not insertion order once slots are reused.
+	 * 
+	 * A copy keeps the same handles valid, clear keeps chunks but invalidates all handles.
+	 * A slot whose generation would wrap around is retired and never reused.
+	 */
+	template <typename T, memory_safety Safety = safeness_declarator<T>::is_safe>
+	class SAFEMEMORY_DEEP_CONST_WHEN_PARAMS stable_vector
+	{
+	public:
+		typedef stable_vector<T, Safety>                                          this_type;
+		typedef T                                                                 value_type;
+		typedef eastl_size_t                                                      size_type;
+		typedef eastl_ssize_t                                                     difference_type;
+		typedef value_type&                                                       reference;
+		typedef const value_type&                                                 const_reference;
+		typedef value_type*                                                       pointer;
+		typedef const value_type*                                                 const_pointer;
+		typedef detail::allocator_to_eastl_vector<Safety>                         allocator_type;
+		typedef typename allocator_type::template array_pointer<T>                chunk_pointer;
+		typedef stable_vector_handle                                              handle;
+
+		typedef detail::stable_vector_iterator<this_type, pointer, reference>              iterator;
+		typedef detail::stable_vector_iterator<this_type, const_pointer, const_reference>  const_iterator;
+
+		static constexpr memory_safety is_safe = Safety;
+
+		/// chunks of about 4KiB, at least 16 elements
+		static constexpr uint32_t kChunkShift = [] {
+			uint32_t s = 4;
+			while(s < 16 && (sizeof(T) << (s + 1)) <= 4096)
+				++s;
+			return s;
+		}();
+		static constexpr size_type kChunkSize = size_type(1) << kChunkShift;
+		static constexpr size_type kMaxSlots = size_type(UINT32_MAX) >> kChunkShift << kChunkShift;
+		static constexpr uint32_t  kRetiredGeneration = UINT32_MAX - 1; // even, so not occupied
+
+		template <typename, typename, typename>
+		friend class detail::stable_vector_iterator;
+
+	protected:
+		eastl::vector<chunk_pointer, allocator_type> mChunks;
+		eastl::vector<uint32_t, allocator_type>      mGenerations; // one per slot ever used, odd when occupied
+		eastl::vector<uint32_t, allocator_type>      mFreeSlots;   // capacity always kept at capacity()
+		size_type                                    mSize = 0;
+		allocator_type                               mAllocator;
+
+	public:
+		stable_vector() : mChunks(allocator_type()), mGenerations(allocator_type()), mFreeSlots(allocator_type()) {}
+		// delegating, so destructor takes care of a copy that throws half way
+		stable_vector(const this_type& x) : stable_vector() { copy_from(x); }
+		stable_vector(this_type&& x) noexcept : stable_vector() { swap(x); }
+
+		~stable_vector() { free_chunks(); }
+
+		this_type& operator=(const this_type& x) {
+			if(this != &x) {
+				this_type temp(x);
+				swap(temp);
+			}
+			return *this;
+		}
+
+		this_type& operator=(this_type&& x) noexcept {
+			if(this != &x) {
+				free_chunks();
+				swap(x);
+			}
+			return *this;
+		}
+
+		void swap(this_type& x) noexcept {
+			mChunks.swap(x.mChunks);
+			mGenerations.swap(x.mGenerations);
+			mFreeSlots.swap(x.mFreeSlots);
+			eastl::swap(mSize, x.mSize);
+		}
+
+		iterator       begin() noexcept { return {this, next_occupied(0)}; }
+		const_iterator begin() const noexcept { return {this, next_occupied(0)}; }
+		const_iterator cbegin() const noexcept { return begin(); }
+
+		iterator       end() noexcept { return {this, end_index()}; }
+		const_iterator end() const noexcept { return {this, end_index()}; }
+		const_iterator cend() const noexcept { return end(); }
+
+		bool      empty() const noexcept { return mSize == 0; }
+		size_type size() const noexcept { return mSize; }
+		size_type capacity() const noexcept { return mChunks.size() << kChunkShift; }
+
+		void reserve(size_type n) {
+			while(capacity() < n)
+				add_chunk();
+		}
+
+		template <typename... Args>
+		handle emplace(Args&&... args) {
+			if(mFreeSlots.empty())
+				new_slot();
+
+			// slot stays free if the constructor throws
+			uint32_t index = mFreeSlots.back();
+			::new(static_cast<void*>(slot(index))) value_type(std::forward<Args>(args)...);
+			mFreeSlots.pop_back();
+			++mSize;
+			return {index, ++mGenerations[index]};
+		}
+
+		handle insert(const value_type& value) { return emplace(value); }
+		handle insert(value_type&& value) { return emplace(std::move(value)); }
+
+		/// number of elements erased, zero when the handle is no longer valid
+		size_type erase(handle h) {
+			if(!contains(h))
+				return 0;
+			release(h.index);
+			return 1;
+		}
+
+		iterator erase(const_iterator it) {
+			if(NODECPP_UNLIKELY(it.mpOwner != this || it.mIndex >= end_index() || !is_occupied(it.mIndex)))
+				ThrowRangeException();
+			release(it.mIndex);
+			return {this, next_occupied(it.mIndex + 1)};
+		}
+
+		/// destroys all elements, chunks are kept
+		void clear() noexcept {
+			for(uint32_t i = 0, iEnd = end_index(); i != iEnd; ++i) {
+				if(is_occupied(i))
+					release(i);
+			}
+		}
+
+		bool contains(handle h) const noexcept {
+			return h.index < mGenerations.size() && mGenerations[h.index] == h.generation && (h.generation & 1) != 0;
+		}
+
+		iterator       find(handle h) noexcept { return {this, contains(h) ? h.index : end_index()}; }
+		const_iterator find(handle h) const noexcept { return {this, contains(h) ? h.index : end_index()}; }
+
+		reference       operator[](handle h) { checkHandle(h); return *slot(h.index); }
+		const_reference operator[](handle h) const { checkHandle(h); return *slot(h.index); }
+
+		reference at(handle h) {
+			if(NODECPP_UNLIKELY(!contains(h)))
+				ThrowRangeException();
+			return *slot(h.index);
+		}
+
+		const_reference at(handle h) const {
+			if(NODECPP_UNLIKELY(!contains(h)))
+				ThrowRangeException();
+			return *slot(h.index);
+		}
+
+	protected:
+		[[noreturn]] static void ThrowRangeException() { throw nodecpp::error::out_of_range; }
+
+		void checkHandle(handle h) const {
+			if constexpr(is_safe == memory_safety::safe) {
+				if(NODECPP_UNLIKELY(!contains(h)))
+					ThrowRangeException();
+			}
+			else
+				NODECPP_ASSERT(module_id, nodecpp::assert::AssertLevel::regular, contains(h));
+		}
+
+		uint32_t end_index() const noexcept { return static_cast<uint32_t>(mGenerations.size()); }
+
+		bool is_occupied(uint32_t index) const noexcept { return (mGenerations[index] & 1) != 0; }
+
+		uint32_t next_occupied(uint32_t index) const noexcept {
+			const uint32_t iEnd = end_index();
+			while(index < iEnd && !is_occupied(index))
+				++index;
+			return index;
+		}
+
+		handle handle_of(uint32_t index) const noexcept { return {index, mGenerations[index]}; }
+
+		value_type* slot(uint32_t index) const noexcept {
+			return allocator_type::to_raw(mChunks[index >> kChunkShift]) + (index & (kChunkSize - 1));
+		}
+
+		value_type* checked_slot(uint32_t index) const {
+			if constexpr(is_safe == memory_safety::safe) {
+				if(NODECPP_UNLIKELY(index >= end_index() || !is_occupied(index)))
+					ThrowRangeException();
+			}
+			return slot(index);
+		}
+
+		void add_chunk() {
+			if(NODECPP_UNLIKELY(capacity() >= kMaxSlots))
+				ThrowRangeException();
+
+			// reserved up front, so new_slot and release never reallocate
+			const size_type cap = capacity() + kChunkSize;
+			reserve_geometric(mGenerations, cap);
+			reserve_geometric(mFreeSlots, cap);
+
+			chunk_pointer p = mAllocator.template allocate_array<T>(kChunkSize);
+			try {
+				mChunks.push_back(p);
+			}
+			catch(...) {
+				mAllocator.deallocate_array(p, kChunkSize);
+				throw;
+			}
+		}
+
+		static void reserve_geometric(eastl::vector<uint32_t, allocator_type>& v, size_type n) {
+			if(v.capacity() < n)
+				v.reserve(eastl::max(n, v.capacity() * 2));
+		}
+
+		void new_slot() {
+			if(mGenerations.size() == capacity())
+				add_chunk();
+
+			mFreeSlots.push_back(end_index());
+			mGenerations.push_back(0);
+		}
+
+		void release(uint32_t index) noexcept {
+			slot(index)->~value_type();
+			--mSize;
+			if(++mGenerations[index] != kRetiredGeneration)
+				mFreeSlots.push_back(index);
+		}
+
+		void copy_from(const this_type& x) {
+			reserve(x.mGenerations.size());
+
+			// each slot is added as free before its element is copied
+			for(uint32_t i = 0, iEnd = x.end_index(); i != iEnd; ++i) {
+				const uint32_t gen = x.mGenerations[i];
+				mGenerations.push_back(gen & ~uint32_t(1));
+				if(x.is_occupied(i)) {
+					::new(static_cast<void*>(slot(i))) value_type(*x.slot(i));
+					mGenerations[i] = gen;
+					++mSize;
+				}
+				else if(gen != kRetiredGeneration)
+					mFreeSlots.push_back(i);
+			}
+		}
+
+		void free_chunks() noexcept {
+			clear();
+			for(const chunk_pointer& each : mChunks)
+				mAllocator.deallocate_array(each, kChunkSize);
+
+			mChunks.clear();
+			mGenerations.clear();
+			mFreeSlots.clear();
+		}
+	}; // stable_vector
+
+
+	///////////////////////////////////////////////////////////////////////
+	// global operators
+	///////////////////////////////////////////////////////////////////////
+
+	template <typename T, memory_safety Safety>
+	inline void swap(stable_vector<T, Safety>& a, stable_vector<T, Safety>& b) 
+	{
+		a.swap(b);
+	}
+
+} // namespace safememory
+
+
+#endif //SAFE_MEMORY_STABLE_VECTOR_H
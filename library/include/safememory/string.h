@@ -31,15 +31,19 @@
 #include <EASTL/string.h>
 #include <safememory/detail/allocator_to_eastl.h>
 #include <safememory/detail/array_iterator.h>
+#include <safememory/detail/string_soft_buffer_ptr.h>
+#include <safememory/detail/string_charconv.h>
 #include <safememory/string_literal.h>
 #include <safememory/functional.h> //for hash
 #include <safe_memory_error.h>
+#include <charconv>
 
 namespace safememory
 {
 
 	template <typename T, memory_safety Safety = safeness_declarator<T>::is_safe>
-	class SAFEMEMORY_DEEP_CONST_WHEN_PARAMS basic_string : protected eastl::basic_string<T, detail::allocator_to_eastl_string<Safety>>
+	class SAFEMEMORY_DEEP_CONST_WHEN_PARAMS basic_string : protected eastl::basic_string<T, detail::allocator_to_eastl_string<Safety>>,
+		protected soft_this_ptr2<Safety>
 	SAFEMEMORY_DEZOMBIEFY_ITERATORS_REGISTRY
 	{
 	public:
@@ -69,7 +73,10 @@ namespace safememory
 		static constexpr bool dz_it = false;
 #endif
 
-		typedef typename allocator_type::template soft_array_pointer<T>                   soft_ptr_type;
+		typedef soft_this_ptr2<Safety>                                                    soft_this_ptr_type;
+		typedef typename allocator_type::template soft_array_pointer<T>                   soft_array_ptr_type;
+		typedef typename allocator_type::template soft_pointer<base_type>                 soft_base_ptr_type;
+		typedef detail::string_soft_buffer_ptr<T, soft_array_ptr_type, soft_base_ptr_type> soft_ptr_type;
 		typedef typename detail::array_stack_only_iterator<T, false, T*, dz_it>           stack_only_iterator;
 		typedef typename detail::array_stack_only_iterator<T, true, T*, dz_it>            const_stack_only_iterator;
 		typedef typename detail::array_heap_safe_iterator<T, false, soft_ptr_type, dz_it> heap_safe_iterator;
@@ -93,9 +100,11 @@ namespace safememory
 		typedef eastl::reverse_iterator<const_iterator_safe>                       const_reverse_iterator_safe;
 
 
-		template<typename>
+		template<typename, typename>
 		friend struct hash;
 
+		friend struct eastl::relocation_fixup<this_type>;
+
         using base_type::npos;
 		static constexpr memory_safety is_safe = Safety;
 
@@ -275,6 +284,21 @@ namespace safememory
         using base_type::force_size; //TODO: review
         using base_type::shrink_to_fit;
 
+		/// Like C++23 \c resize_and_overwrite , capacity grows to \p n without initializing
+		/// new characters and \c op(begin(),n) writes them through a stack only iterator.
+		/// \p op returns the final size, that can't be greater than \p n , and only
+		/// characters up to that size become part of the string.
+		template<class Operation>
+		void resize_and_overwrite(size_type n, Operation op) {
+			doResizeAndOverwrite(n, [&op, this](size_type sz) { return op(begin(), sz); });
+		}
+
+		/// Same as above, but \p op gets a raw pointer, as needed to call the OS.
+		template<class Operation>
+		void resize_and_overwrite_unsafe(size_type n, Operation op) {
+			doResizeAndOverwrite(n, [&op, this](size_type sz) { return op(base_type::data(), sz); });
+		}
+
 		// Raw access
         using base_type::data;
         using base_type::c_str;
@@ -327,6 +351,52 @@ namespace safememory
 
 			return *this;
 		}
+
+		/// append_number
+		///
+		/// Appends the decimal representation of an integer, or the shortest representation
+		/// of a floating point value that round-trips with \c from_chars .
+		/// Characters are written directly at the string buffer, without sprintf,
+		/// and a string on SSO stays on SSO when the result fits.
+		template<class V>
+		std::enable_if_t<std::is_integral_v<V> && !std::is_same_v<V, bool>, this_type&> append_number(V value) {
+			typedef std::make_unsigned_t<V> U;
+
+			U u = static_cast<U>(value);
+			size_type neg = 0;
+			if constexpr (std::is_signed_v<V>) {
+				if(value < 0) {
+					u = static_cast<U>(U(0) - u);
+					neg = 1;
+				}
+			}
+
+			size_type sz = base_type::size();
+			size_type n = neg + static_cast<size_type>(detail::count_digits(u));
+			base_type::resize(sz + n);
+
+			value_type* p = base_type::data() + sz;
+			detail::write_digits(p + n, u);
+			if(neg)
+				*p = '-';
+
+			return *this;
+		}
+
+		template<class V>
+		std::enable_if_t<std::is_floating_point_v<V>, this_type&> append_number(V value) {
+			return appendChars([value](char* b, char* e) { return std::to_chars(b, e, value); });
+		}
+
+		template<class V>
+		std::enable_if_t<std::is_floating_point_v<V>, this_type&> append_number(V value, std::chars_format fmt) {
+			return appendChars([value, fmt](char* b, char* e) { return std::to_chars(b, e, value, fmt); });
+		}
+
+		template<class V>
+		std::enable_if_t<std::is_floating_point_v<V>, this_type&> append_number(V value, std::chars_format fmt, int precision) {
+			return appendChars([value, fmt, precision](char* b, char* e) { return std::to_chars(b, e, value, fmt, precision); });
+		}
  
 		template <typename OtherCharType>
 		this_type& append_convert_unsafe(const OtherCharType* p) {
@@ -649,6 +719,46 @@ namespace safememory
 
     protected:
 		[[noreturn]] static void ThrowRangeException() { throw nodecpp::error::out_of_range; }
+		//mb: on SSO first try at the free capacity, then grow until it fits.
+		// 32 is enough for shortest double, but length of fixed format
+		// is not bounded by anything reasonable (i.e. 1e300)
+		template<class F>
+		this_type& appendChars(F conv) {
+			static_assert(std::is_same_v<value_type, char>, "std::to_chars is only available for char");
+
+			size_type sz = base_type::size();
+			size_type room = base_type::internalLayout().IsSSO() ? base_type::capacity() - sz : 0;
+			if(room == 0)
+				room = 32;
+
+			while(true) {
+				base_type::resize(sz + room);
+				char* p = base_type::data() + sz;
+				std::to_chars_result r = conv(p, p + room);
+				if(r.ec == std::errc()) {
+					base_type::resize(sz + static_cast<size_type>(r.ptr - p));
+					return *this;
+				}
+				room = room < 32 ? 32 : room * 4;
+			}
+		}
+
+		template<class F>
+		void doResizeAndOverwrite(size_type n, F f) {
+			if(n > base_type::capacity())
+				base_type::reserve(n);
+
+			// mb: op may also change this string (i.e. clear, shrink_to_fit or push_back),
+			// so the result is checked against the buffer we have now, not the one we gave
+			const_pointer p = base_type::data();
+			size_type r = static_cast<size_type>(f(n));
+			if(NODECPP_UNLIKELY(r > n || p != base_type::data() || r > base_type::capacity()))
+				ThrowRangeException();
+
+			base_type::force_size(r);
+			*(base_type::data() + r) = value_type(0);
+		}
+
 		[[noreturn]] static void ThrowInvalidArgumentException() { throw nodecpp::error::out_of_range; }
 
         const base_type& toBase() const noexcept { return *this; }
@@ -723,34 +833,39 @@ namespace safememory
 				return const_reverse_iterator(makeIt(it.base()));
 		}
 
-		//mb: in case string is usign SSO, we make a 'reserve' to force switch to heap
-		iterator_safe makeSafeIt(iterator_base it) {
-			// first calculate index of 'it', in case we move to heap
-			auto ix = static_cast<size_type>(it - base_type::data());
+		//mb: SSO buffer is inside the string body, so when the string is part of an object
+		// on the heap we anchor a soft_ptr to it on the owner control block.
+		// Otherwise we make a 'reserve' to force switch to heap
+		soft_ptr_type makeSoftBuffer() const {
 
 			if(base_type::internalLayout().IsSSO()) {
+				// soft_this_ptr2 is only set when the string is inside the owner,
+				// a temporary on the stack while the owner is constructed never is
+				const soft_this_ptr_type& this_ptr = *this;
+				if(this_ptr) {
+					auto p = const_cast<base_type*>(static_cast<const base_type*>(this));
+					return soft_ptr_type(this_ptr.getSoftPtr(p));
+				}
+
 				// its on the stack, move it to heap
-				base_type::reserve(base_type::SSOLayout::SSO_CAPACITY + 1);
+				const_cast<this_type*>(this)->base_type::reserve(base_type::SSOLayout::SSO_CAPACITY + 1);
 			}
-			
+
 			//mb: now the buffer should be on the heap
 			NODECPP_ASSERT(safememory::module_id, nodecpp::assert::AssertLevel::regular, base_type::internalLayout().IsHeap());
-			return iterator_safe::makeIx(allocator_type::to_soft(base_type::internalLayout().GetHeapBeginPtr()), ix, this);
+			return soft_ptr_type(allocator_type::to_soft(base_type::internalLayout().GetHeapBeginPtr()));
 		}
 
-		//mb: in case string is usign SSO, we make a 'reserve' to force switch to heap
-		const_iterator_safe makeSafeIt(const_iterator_base it) const {
+		iterator_safe makeSafeIt(iterator_base it) {
 			// first calculate index of 'it', in case we move to heap
 			auto ix = static_cast<size_type>(it - base_type::data());
-			
-			if(base_type::internalLayout().IsSSO()) {
-				// its on the stack, move it to heap
-				const_cast<this_type*>(this)->base_type::reserve(base_type::SSOLayout::SSO_CAPACITY + 1);
-			}
+			return iterator_safe::makeIx(makeSoftBuffer(), ix, this);
+		}
 
-			//mb: now the buffer should be on the heap
-			NODECPP_ASSERT(safememory::module_id, nodecpp::assert::AssertLevel::regular, base_type::internalLayout().IsHeap());
-			return const_iterator_safe::makeIx(allocator_type::to_soft(base_type::internalLayout().GetHeapBeginPtr()), ix, const_cast<this_type*>(this));
+		const_iterator_safe makeSafeIt(const_iterator_base it) const {
+			// first calculate index of 'it', in case we move to heap
+			auto ix = static_cast<size_type>(it - base_type::data());
+			return const_iterator_safe::makeIx(makeSoftBuffer(), ix, const_cast<this_type*>(this));
 		}
 
 		reverse_iterator_safe makeSafeIt(const reverse_iterator_base& it) {
@@ -941,23 +1056,23 @@ namespace safememory
 	typedef basic_string<char32_t> u32string;
 
 
-	template<typename T>
-	struct SAFEMEMORY_DEEP_CONST hash<basic_string<T, memory_safety::none>> : eastl::hash<typename safememory::basic_string<T, safememory::memory_safety::none>::base_type>
+	template<typename T, typename Policy>
+	struct SAFEMEMORY_DEEP_CONST hash<basic_string<T, memory_safety::none>, Policy>
 	{
-		typedef eastl::hash<typename safememory::basic_string<T, safememory::memory_safety::none>::base_type> base_type;
 		SAFEMEMORY_NO_SIDE_EFFECT std::size_t operator()(const basic_string<T, memory_safety::none>& x) const
 		{
-			return base_type::operator()(x.to_base_unsafe());
+			const auto& b = x.to_base_unsafe();
+			return Policy::chars(b.data(), b.size());
 		}
 	};
 
-	template<typename T>
-	struct SAFEMEMORY_DEEP_CONST hash<basic_string<T, memory_safety::safe>> : eastl::hash<typename safememory::basic_string<T, safememory::memory_safety::safe>::base_type>
+	template<typename T, typename Policy>
+	struct SAFEMEMORY_DEEP_CONST hash<basic_string<T, memory_safety::safe>, Policy>
 	{
-		typedef eastl::hash<typename safememory::basic_string<T, safememory::memory_safety::safe>::base_type> base_type;
 		SAFEMEMORY_NO_SIDE_EFFECT std::size_t operator()(const basic_string<T, memory_safety::safe>& x) const
 		{
-			return base_type::operator()(x.to_base_unsafe());
+			const auto& b = x.to_base_unsafe();
+			return Policy::chars(b.data(), b.size());
 		}
 	};
 
@@ -970,24 +1085,25 @@ namespace safememory
 	///
 	/// http://en.cppreference.com/w/cpp/string/basic_string/to_string
 	///
+	//mb: implemented with append_number, floating point uses fixed format with 6 decimals, same as "%f"
 	inline string to_string(int value)
-		{ return string::make_sprintf_unsafe("%d", value); }
+		{ string s; s.append_number(value); return s; }
 	inline string to_string(long value)
-		{ return string::make_sprintf_unsafe("%ld", value); }
+		{ string s; s.append_number(value); return s; }
 	inline string to_string(long long value)
-		{ return string::make_sprintf_unsafe("%lld", value); }
+		{ string s; s.append_number(value); return s; }
 	inline string to_string(unsigned value)
-		{ return string::make_sprintf_unsafe("%u", value); }
+		{ string s; s.append_number(value); return s; }
 	inline string to_string(unsigned long value)
-		{ return string::make_sprintf_unsafe("%lu", value); }
+		{ string s; s.append_number(value); return s; }
 	inline string to_string(unsigned long long value)
-		{ return string::make_sprintf_unsafe("%llu", value); }
+		{ string s; s.append_number(value); return s; }
 	inline string to_string(float value)
-		{ return string::make_sprintf_unsafe("%f", value); }
+		{ string s; s.append_number(value, std::chars_format::fixed, 6); return s; }
 	inline string to_string(double value)
-		{ return string::make_sprintf_unsafe("%f", value); }
+		{ string s; s.append_number(value, std::chars_format::fixed, 6); return s; }
 	inline string to_string(long double value)
-		{ return string::make_sprintf_unsafe("%Lf", value); }
+		{ string s; s.append_number(value, std::chars_format::fixed, 6); return s; }
 
 
 	/// to_wstring
@@ -1202,5 +1318,27 @@ namespace safememory
 
 } // namespace safememory
 
+namespace eastl
+{
+	// Only soft_this_ptr2 is bound to the address of the string, the character data
+	// is either inline (SSO) or on the heap. The iterator registry is not relocatable.
+#ifndef SAFEMEMORY_DEZOMBIEFY_ITERATORS
+	template <typename T, safememory::memory_safety Safety>
+	struct is_trivially_relocatable<safememory::basic_string<T, Safety>> : public true_type {};
+
+	template <typename T, safememory::memory_safety Safety>
+	struct relocation_fixup<safememory::basic_string<T, Safety>>
+	{
+		static void relocated(safememory::basic_string<T, Safety>* p, size_t n) EA_NOEXCEPT
+		{
+			typedef typename safememory::basic_string<T, Safety>::soft_this_ptr_type soft_this_ptr_type;
+
+			for(size_t i = 0; i != n; ++i)
+				static_cast<soft_this_ptr_type&>(p[i]).relocated();
+		}
+	};
+#endif
+} // namespace eastl
+
 
 #endif //SAFE_MEMORY_STRING_H
\ No newline at end of file
@@ -32,6 +32,7 @@
 #include <safememory/string_literal.h>
 #include <fmt/format.h>
 #include <iostream>
+#include <iterator>
 
 
 template <class T>
@@ -67,4 +68,112 @@ std::basic_ostream<T>& operator<<(std::basic_ostream<T>& os, const safememory::b
   return os << sview;
 }
 
+namespace safememory {
+
+	namespace detail {
+
+		/**
+		 * \brief \c fmt buffer that writes directly at the free capacity of a \c basic_string .
+		 * 
+		 * \c fmt sees the whole string capacity, when it needs more, the string size is updated
+		 * to what was written so far and capacity is at least doubled. Size is set once more
+		 * at \c commit . A formatting error (exception) leaves the string with its previous size,
+		 * as the destructor drops anything not committed.
+		 */
+		template<class S>
+		class string_fmt_buffer final : public fmt::detail::buffer<char> {
+			typedef typename S::size_type size_type;
+			S& str;
+			size_type prevSize;
+			bool committed = false;
+
+			void growImpl(size_t capacity) {
+				str.force_size(static_cast<size_type>(this->size()));
+				size_t cap = static_cast<size_t>(str.capacity()) * 2;
+				str.reserve(static_cast<size_type>(capacity > cap ? capacity : cap));
+				this->set(str.data(), str.capacity());
+			}
+
+#if FMT_VERSION >= 110000
+			static void grow(fmt::detail::buffer<char>& buf, size_t capacity) {
+				static_cast<string_fmt_buffer&>(buf).growImpl(capacity);
+			}
+		public:
+			explicit string_fmt_buffer(S& s) : fmt::detail::buffer<char>(grow, s.data(), s.size(), s.capacity()), str(s), prevSize(s.size()) {}
+#else
+		protected:
+			void grow(size_t capacity) override { growImpl(capacity); }
+		public:
+			explicit string_fmt_buffer(S& s) : fmt::detail::buffer<char>(s.data(), s.size(), s.capacity()), str(s), prevSize(s.size()) {}
+#endif
+			string_fmt_buffer(const string_fmt_buffer&) = delete;
+			string_fmt_buffer& operator=(const string_fmt_buffer&) = delete;
+
+			~string_fmt_buffer() {
+				// mb: growImpl already made partial output part of the string
+				if(!committed) {
+					str.force_size(prevSize);
+					str.data()[prevSize] = '\0';
+				}
+			}
+
+			void commit() {
+				str.force_size(static_cast<size_type>(this->size()));
+				str.data()[this->size()] = '\0';
+				committed = true;
+			}
+		};
+
+#if FMT_VERSION >= 80000
+		template<class... Args>
+		using format_string = fmt::format_string<Args...>;
+		typedef fmt::appender format_appender;
+#else
+		template<class... Args>
+		using format_string = fmt::string_view;
+		typedef std::back_insert_iterator<fmt::detail::buffer<char>> format_appender;
+#endif
+
+		template<class S, class A>
+		bool is_same_string(const S& str, const A& arg) {
+			if constexpr (std::is_base_of_v<S, A>)
+				return &str == static_cast<const S*>(&arg);
+			else
+				return false;
+		}
+	}
+
+	/// format_to
+	///
+	/// Appends formatted output at the end of \p str, without an intermediate buffer or copy.
+	template<memory_safety Safety, class... Args>
+	basic_string<char, Safety>& format_to(basic_string<char, Safety>& str, detail::format_string<Args...> f, Args&&... args) {
+
+		//mb: when \p str is also an argument, it would be read while its buffer grows
+		if((detail::is_same_string(str, args) || ...)) {
+			fmt::memory_buffer buff;
+			fmt::format_to(std::back_inserter(buff), f, std::forward<Args>(args)...);
+			return str.append_unsafe(buff.data(), buff.data() + buff.size());
+		}
+
+		detail::string_fmt_buffer<basic_string<char, Safety>> buff(str);
+		fmt::format_to(detail::format_appender(buff), f, std::forward<Args>(args)...);
+		buff.commit();
+		return str;
+	}
+
+	/// format
+	///
+	/// Same as \c fmt::format but returns a \c safememory::string , a short result stays on SSO.
+	template<class... Args>
+	string format(detail::format_string<Args...> f, Args&&... args) {
+		string str;
+		detail::string_fmt_buffer<string> buff(str);
+		fmt::format_to(detail::format_appender(buff), f, std::forward<Args>(args)...);
+		buff.commit();
+		return str;
+	}
+
+} // namespace safememory
+
 #endif //SAFE_MEMORY_STRING_FORMAT_H
@@ -31,6 +31,7 @@
 #include <safememory/memory_safety.h>
 #include <safememory/detail/checker_attributes.h>
 #include <safememory/detail/array_iterator.h>
+#include <safememory/detail/hash_policy.h>
 #include <safe_memory_error.h>
 #include <EASTL/iterator.h>
 #include <EASTL/string_view.h>
@@ -55,14 +56,17 @@ namespace safememory
 	private:
 		const value_type* str = nullptr;
 		size_type sz = 0;
+		//mb: fits in padding after sz, so size of the class doesn't change
+		std::uint32_t hsh = detail::fnv1a_32(str, 0);
 
 		[[noreturn]] static void ThrowRangeException() { throw nodecpp::error::out_of_range; }
 
 	public:
-		basic_string_literal() {}
+		constexpr basic_string_literal() {}
 		
+		// hash is calculated here, declare literals as 'constexpr' to do it at compile time
 		template<size_type N>
-		basic_string_literal(const value_type (&ptr)[N]) : str(ptr), sz(N - 1) {
+		constexpr basic_string_literal(const value_type (&ptr)[N]) : str(ptr), sz(N - 1), hsh(detail::fnv1a_32(ptr, N - 1)) {
 			static_assert(N >= 1);
 			static_assert(N < std::numeric_limits<size_type>::max());
 		}
@@ -123,9 +127,22 @@ namespace safememory
 			return str[size() - 1];
 		}
 
+		/// FNV-1a of the characters, the same for equal literals
+		constexpr std::uint32_t hash() const noexcept { return hsh; }
+
 		eastl::basic_string_view<T> to_string_view_unsafe() const {
 			return eastl::basic_string_view<T>(data(), size());
 		}
+
+		//mb: interned literals share the pointer, otherwise hash almost always tells them apart
+		static bool equal(const basic_string_literal& a, const basic_string_literal& b) noexcept {
+			if(a.str == b.str)
+				return a.sz == b.sz;
+			else if(a.hsh != b.hsh || a.sz != b.sz)
+				return false;
+			else
+				return eastl::Compare(a.str, b.str, a.sz) == 0;
+		}
 	};
 
 	typedef basic_string_literal<char>    string_literal;
@@ -139,12 +156,12 @@ namespace safememory
 
 	template<class T, memory_safety S>
 	bool operator==( const basic_string_literal<T, S>& a, const basic_string_literal<T, S>& b ) {
-		return eastl::operator==(a.to_string_view_unsafe(), b.to_string_view_unsafe());
+		return basic_string_literal<T, S>::equal(a, b);
 	}
 
 	template<class T, memory_safety S>
 	bool operator!=( const basic_string_literal<T, S>& a, const basic_string_literal<T, S>& b ) {
-		return eastl::operator!=(a.to_string_view_unsafe(), b.to_string_view_unsafe());
+		return !basic_string_literal<T, S>::equal(a, b);
 	}
 
 	template<class T, memory_safety S>
@@ -167,6 +184,37 @@ namespace safememory
 		return eastl::operator>=(a.to_string_view_unsafe(), b.to_string_view_unsafe());
 	}
 
+#if defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201911L
+
+	namespace detail {
+		template<class T, std::size_t N>
+		struct fixed_string {
+			typedef T value_type;
+			T chars[N] = {};
+
+			constexpr fixed_string(const T (&s)[N]) {
+				for(std::size_t i = 0; i != N; ++i)
+					chars[i] = s[i];
+			}
+		};
+	}
+
+	namespace literals {
+
+		/// "text"_lit
+		///
+		/// An interned literal, all "text"_lit in the program point to the same characters,
+		/// so they compare equal by pointer.
+		/// Characters are held by the template parameter object, that has static storage
+		/// duration and is unique for each value, so lifetime is also infinite.
+		template<detail::fixed_string Str>
+		constexpr auto operator""_lit() {
+			return basic_string_literal<typename decltype(Str)::value_type>(Str.chars);
+		}
+	}
+
+#endif
+
 } //namespace safememory
 
 #endif //SAFE_MEMORY_STRING_LITERAL_H
\ No newline at end of file
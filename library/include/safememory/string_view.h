@@ -0,0 +1,408 @@
+/* -------------------------------------------------------------------------------
+* Copyright (c) 2020, OLogN Technologies AG
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*     * Neither the name of the OLogN Technologies AG nor the
+*       names of its contributors may be used to endorse or promote products
+*       derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL OLogN Technologies AG BE LIABLE FOR ANY
+* DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* -------------------------------------------------------------------------------*/
+
+
+#ifndef SAFE_MEMORY_STRING_VIEW_H
+#define SAFE_MEMORY_STRING_VIEW_H
+
+#include <safememory/memory_safety.h>
+#include <safememory/detail/checker_attributes.h>
+#include <safememory/detail/array_iterator.h>
+#include <safememory/string.h>
+#include <safememory/string_literal.h>
+#include <safe_memory_error.h>
+#include <EASTL/iterator.h>
+#include <EASTL/string_view.h>
+#include <charconv>
+
+namespace safememory
+{
+	/**
+	 * \brief Read only view of a \c basic_string or \c basic_string_literal for hot loops.
+	 * 
+	 * The view holds a raw pointer to the viewed characters (that may be the SSO buffer
+	 * inside the string itself), so this is a \a stack_only type, and static checker will
+	 * enforce on it the same scope rules of raw pointers and \a stack_only iterators.
+	 * Creating the view doesn't move an SSO string to the heap as \c begin_safe() does.
+	 * 
+	 * Arguments are validated once per call, and searching methods (\c find, \c find_if,
+	 * \c find_first_of, etc) scan the characters without any further check, so a parser
+	 * can skip whitespace or take a token with a single checked call.
+	 * 
+	 * Any non-const use of the viewed string while the view is alive may invalidate it,
+	 * as with any other \a stack_only iterator.
+	 * 
+	 * With \c SAFEMEMORY_DEZOMBIEFY_ITERATORS the view pins the viewed string with a
+	 * registered iterator, and accessors, searching methods and iterators of the view
+	 * check it before reading, so a moved, destroyed or shrunk string is detected.
+	 * The view is also the iterator registry for its own iterators.
+	 */
+	template<typename T, memory_safety Safety = safeness_declarator<T>::is_safe>
+	class SAFEMEMORY_DEEP_CONST SAFEMEMORY_NO_SIDE_EFFECT_WHEN_CONST basic_string_view
+#ifdef SAFEMEMORY_DEZOMBIEFY_ITERATORS
+		: public detail::iterator_registry
+#endif
+	{
+	public:
+		typedef basic_string_view<T, Safety>                              this_type;
+		typedef eastl::basic_string_view<T>                               base_view_type;
+		typedef T                                                         value_type;
+		typedef const T*                                                  const_pointer;
+		typedef const T&                                                  const_reference;
+		typedef typename base_view_type::size_type                        size_type;
+		typedef typename base_view_type::difference_type                  difference_type;
+		typedef basic_string_literal<T>                                   literal_type;
+
+#ifdef SAFEMEMORY_DEZOMBIEFY_ITERATORS
+		static constexpr bool dz_it = true;
+#else
+		static constexpr bool dz_it = false;
+#endif
+
+		// mb: dezombiefy checks need a non const pointer, same as string iterators
+		typedef std::conditional_t<dz_it, T*, const T*>                  array_pointer;
+		typedef detail::array_stack_only_iterator<T, true, array_pointer, dz_it>  const_stack_only_iterator;
+
+		static constexpr bool use_base_iterator = Safety == memory_safety::none;
+
+		typedef std::conditional_t<use_base_iterator, const T*, const_stack_only_iterator> const_iterator;
+		typedef const_iterator                                            iterator;
+		typedef eastl::reverse_iterator<const_iterator>                   const_reverse_iterator;
+		typedef const_reverse_iterator                                    reverse_iterator;
+
+		static constexpr size_type npos = base_view_type::npos;
+		static constexpr memory_safety is_safe = Safety;
+
+	private:
+		const value_type* str = nullptr;
+		size_type sz = 0;
+
+#ifdef SAFEMEMORY_DEZOMBIEFY_ITERATORS
+		typedef detail::array_stack_only_iterator<T, true, T*, true>      pin_type;
+
+		// mb: begin of the viewed string, registered on it, and where the view starts from there
+		pin_type pin;
+		size_type pinOffset = 0;
+		bool pinned = false;
+
+		constexpr basic_string_view(const basic_string_view& other, size_type pos, size_type n)
+			: str(other.str + pos), sz(n), pin(other.pin), pinOffset(other.pinOffset + pos), pinned(other.pinned) {}
+#else
+		constexpr basic_string_view(const basic_string_view& other, size_type pos, size_type n) : str(other.str + pos), sz(n) {}
+#endif
+
+		[[noreturn]] static void ThrowRangeException() { throw nodecpp::error::out_of_range; }
+
+		/// on dezombiefy, the view must still be inside the string it was taken from
+		constexpr void checkPin() const {
+#ifdef SAFEMEMORY_DEZOMBIEFY_ITERATORS
+			if constexpr(is_safe == memory_safety::safe) {
+				if(pinned && sz != 0)
+					(void)pin[pinOffset + sz - 1];
+			}
+#endif
+		}
+
+		constexpr eastl::basic_string_view<T> checkedView() const {
+			checkPin();
+			return to_string_view_unsafe();
+		}
+
+		constexpr void checkPos(size_type pos) const {
+			if constexpr(is_safe == memory_safety::safe) {
+				if(NODECPP_UNLIKELY(pos > size()))
+					ThrowRangeException();
+			}
+		}
+
+		constexpr const_iterator makeIt(size_type ix) const {
+			if constexpr (use_base_iterator)
+				return str + ix;
+			else if constexpr (dz_it)
+				return const_iterator::makeIx(const_cast<T*>(str), ix, const_cast<this_type*>(this));
+			else
+				return const_iterator::makeIx(str, ix, size());
+		}
+
+	public:
+		constexpr basic_string_view() {}
+
+#ifdef SAFEMEMORY_DEZOMBIEFY_ITERATORS
+		template<memory_safety S>
+		basic_string_view(const basic_string<T, S>& s) : str(s.data()), sz(s.size()),
+			pin(pin_type::makeIx(const_cast<T*>(s.data()), 0, const_cast<basic_string<T, S>*>(&s))), pinned(true) {}
+#else
+		template<memory_safety S>
+		basic_string_view(const basic_string<T, S>& s) : str(s.data()), sz(s.size()) {}
+#endif
+
+		// mb: a view of a temporary string would dangle at the end of the full-expression
+		template<memory_safety S>
+		basic_string_view(basic_string<T, S>&& s) = delete;
+
+		template<memory_safety S>
+		constexpr basic_string_view(const basic_string_literal<T, S>& lit) : str(lit.data()), sz(lit.size()) {}
+
+		basic_string_view(const basic_string_view& other) = default;
+		basic_string_view& operator=(const basic_string_view& other) = default;
+		basic_string_view(basic_string_view&& other) = default;
+		basic_string_view& operator=(basic_string_view&& other) = default;
+
+		~basic_string_view() {
+			str = nullptr;
+			sz = 0;
+			forcePreviousChangesToThisInDtor(this);
+		}
+
+		constexpr const_iterator begin() const noexcept { return makeIt(0); }
+		constexpr const_iterator cbegin() const noexcept { return makeIt(0); }
+
+		constexpr const_iterator end() const noexcept { return makeIt(size()); }
+		constexpr const_iterator cend() const noexcept { return makeIt(size()); }
+
+		constexpr const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(cend()); }
+		constexpr const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(cend()); }
+
+		constexpr const_reverse_iterator rend() const noexcept { return const_reverse_iterator(cbegin()); }
+		constexpr const_reverse_iterator crend() const noexcept { return const_reverse_iterator(cbegin()); }
+
+		constexpr bool empty() const noexcept { return sz == 0; }
+		// mb: on dezombiefy our iterators call size() before each access, so it checks the pin
+		constexpr size_type size() const noexcept(!dz_it) { checkPin(); return sz; }
+		constexpr size_type length() const noexcept(!dz_it) { return size(); }
+
+		constexpr const_reference operator[](size_type i) const {
+			if constexpr(is_safe == memory_safety::safe) {
+				if(NODECPP_UNLIKELY(i >= size()))
+					ThrowRangeException();
+			}
+
+			return str[i];
+		}
+
+		constexpr const_reference at(size_type i) const {
+			if(NODECPP_UNLIKELY(i >= size()))
+				ThrowRangeException();
+
+			return str[i];
+		}
+
+		constexpr const_reference front() const {
+			if constexpr(is_safe == memory_safety::safe) {
+				if(NODECPP_UNLIKELY(empty()))
+					ThrowRangeException();
+				checkPin();
+			}
+
+			return str[0];
+		}
+
+		constexpr const_reference back() const {
+			if constexpr(is_safe == memory_safety::safe) {
+				if(NODECPP_UNLIKELY(empty()))
+					ThrowRangeException();
+			}
+
+			return str[size() - 1];
+		}
+
+		constexpr void remove_prefix(size_type n) {
+			checkPos(n);
+			str += n;
+			sz -= n;
+#ifdef SAFEMEMORY_DEZOMBIEFY_ITERATORS
+			pinOffset += n;
+#endif
+		}
+
+		constexpr void remove_suffix(size_type n) {
+			checkPos(n);
+			sz -= n;
+		}
+
+		constexpr void swap(basic_string_view& other) noexcept {
+			eastl::swap(str, other.str);
+			eastl::swap(sz, other.sz);
+#ifdef SAFEMEMORY_DEZOMBIEFY_ITERATORS
+			eastl::swap(pin, other.pin);
+			eastl::swap(pinOffset, other.pinOffset);
+			eastl::swap(pinned, other.pinned);
+#endif
+		}
+
+		constexpr basic_string_view substr(size_type pos = 0, size_type n = npos) const {
+			checkPos(pos);
+			return basic_string_view(*this, pos, eastl::min(n, size() - pos));
+		}
+
+		// mb: searching methods never read outside the view, whatever the arguments,
+		// so we forward them to eastl::basic_string_view without any check (but the dezombiefy pin)
+		size_type find(basic_string_view v, size_type pos = 0) const noexcept(!dz_it) { return checkedView().find(v.checkedView(), pos); }
+		size_type find(T c, size_type pos = 0) const noexcept(!dz_it) { return checkedView().find(c, pos); }
+		size_type rfind(basic_string_view v, size_type pos = npos) const noexcept(!dz_it) { return checkedView().rfind(v.checkedView(), pos); }
+		size_type rfind(T c, size_type pos = npos) const noexcept(!dz_it) { return checkedView().rfind(c, pos); }
+
+		size_type find_first_of(basic_string_view v, size_type pos = 0) const noexcept(!dz_it) { return checkedView().find_first_of(v.checkedView(), pos); }
+		size_type find_first_of(T c, size_type pos = 0) const noexcept(!dz_it) { return checkedView().find_first_of(c, pos); }
+		size_type find_last_of(basic_string_view v, size_type pos = npos) const noexcept(!dz_it) { return checkedView().find_last_of(v.checkedView(), pos); }
+		size_type find_last_of(T c, size_type pos = npos) const noexcept(!dz_it) { return checkedView().find_last_of(c, pos); }
+		size_type find_first_not_of(basic_string_view v, size_type pos = 0) const noexcept(!dz_it) { return checkedView().find_first_not_of(v.checkedView(), pos); }
+		size_type find_first_not_of(T c, size_type pos = 0) const noexcept(!dz_it) { return checkedView().find_first_not_of(c, pos); }
+		size_type find_last_not_of(basic_string_view v, size_type pos = npos) const noexcept(!dz_it) { return checkedView().find_last_not_of(v.checkedView(), pos); }
+		size_type find_last_not_of(T c, size_type pos = npos) const noexcept(!dz_it) { return checkedView().find_last_not_of(c, pos); }
+
+		/// index of first character at or after \p pos where \p pred is \c true, or \c npos
+		template<class Predicate>
+		size_type find_if(Predicate pred, size_type pos = 0) const {
+			checkPin();
+			for(size_type i = pos; i < sz; ++i) {
+				if(pred(str[i]))
+					return i;
+			}
+			return npos;
+		}
+
+		/// index of first character at or after \p pos where \p pred is \c false, or \c npos
+		template<class Predicate>
+		size_type find_if_not(Predicate pred, size_type pos = 0) const {
+			checkPin();
+			for(size_type i = pos; i < sz; ++i) {
+				if(!pred(str[i]))
+					return i;
+			}
+			return npos;
+		}
+
+		bool starts_with(basic_string_view v) const noexcept(!dz_it) { return checkedView().starts_with(v.checkedView()); }
+		bool starts_with(T c) const noexcept(!dz_it) { return !empty() && front() == c; }
+		bool starts_with(const literal_type& lit) const noexcept(!dz_it) { return starts_with(basic_string_view(lit)); }
+		bool ends_with(basic_string_view v) const noexcept(!dz_it) { return checkedView().ends_with(v.checkedView()); }
+		bool ends_with(T c) const noexcept(!dz_it) { return !empty() && back() == c; }
+		bool ends_with(const literal_type& lit) const noexcept(!dz_it) { return ends_with(basic_string_view(lit)); }
+
+		int compare(basic_string_view v) const noexcept(!dz_it) { return checkedView().compare(v.checkedView()); }
+
+		constexpr eastl::basic_string_view<T> to_string_view_unsafe() const noexcept {
+			return eastl::basic_string_view<T>(str, sz);
+		}
+	};
+
+	typedef basic_string_view<char>    string_view;
+	typedef basic_string_view<wchar_t> wstring_view;
+
+	typedef basic_string_view<char8_t>  u8string_view;
+	typedef basic_string_view<char16_t> u16string_view;
+	typedef basic_string_view<char32_t> u32string_view;
+
+
+	template<class T, memory_safety S>
+	bool operator==( const basic_string_view<T, S>& a, const basic_string_view<T, S>& b ) {
+		return a.size() == b.size() && a.compare(b) == 0;
+	}
+
+	template<class T, memory_safety S>
+	bool operator==( const basic_string_view<T, S>& a, const basic_string_literal<T>& lit ) {
+		return a == basic_string_view<T, S>(lit);
+	}
+
+	template<class T, memory_safety S>
+	bool operator!=( const basic_string_view<T, S>& a, const basic_string_view<T, S>& b ) {
+		return !(a == b);
+	}
+
+	template<class T, memory_safety S>
+	bool operator!=( const basic_string_view<T, S>& a, const basic_string_literal<T>& lit ) {
+		return !(a == basic_string_view<T, S>(lit));
+	}
+
+	template<class T, memory_safety S>
+	bool operator<( const basic_string_view<T, S>& a, const basic_string_view<T, S>& b ) {
+		return a.compare(b) < 0;
+	}
+
+	template<class T, memory_safety S>
+	bool operator<=( const basic_string_view<T, S>& a, const basic_string_view<T, S>& b ) {
+		return a.compare(b) <= 0;
+	}
+
+	template<class T, memory_safety S>
+	bool operator>( const basic_string_view<T, S>& a, const basic_string_view<T, S>& b ) {
+		return a.compare(b) > 0;
+	}
+
+	template<class T, memory_safety S>
+	bool operator>=( const basic_string_view<T, S>& a, const basic_string_view<T, S>& b ) {
+		return a.compare(b) >= 0;
+	}
+
+
+	/// from_chars
+	///
+	/// Parses a number at the beginning of the view, the same as \c std::from_chars .
+	/// Instead of a pointer, the result has the count of characters used, to be passed
+	/// to \c remove_prefix . On error \p value is not modified and \c count is zero.
+	struct from_chars_result {
+		std::size_t count;
+		std::errc ec;
+	};
+
+	namespace detail {
+		// mb: size() is taken from the safememory view, as on dezombiefy it checks the pin
+		template<class F>
+		from_chars_result from_chars_view(const char* data, std::size_t sz, F conv) {
+			std::from_chars_result r = conv(data, data + sz);
+			return { r.ec == std::errc() ? static_cast<std::size_t>(r.ptr - data) : 0, r.ec };
+		}
+	}
+
+	template<class V, memory_safety S>
+	std::enable_if_t<std::is_integral_v<V> && !std::is_same_v<V, bool>, from_chars_result>
+	from_chars(const basic_string_view<char, S>& v, V& value, int base = 10) {
+		return detail::from_chars_view(v.to_string_view_unsafe().data(), v.size(),
+			[&value, base](const char* b, const char* e) { return std::from_chars(b, e, value, base); });
+	}
+
+	template<class V, memory_safety S>
+	std::enable_if_t<std::is_floating_point_v<V>, from_chars_result>
+	from_chars(const basic_string_view<char, S>& v, V& value, std::chars_format fmt = std::chars_format::general) {
+		return detail::from_chars_view(v.to_string_view_unsafe().data(), v.size(),
+			[&value, fmt](const char* b, const char* e) { return std::from_chars(b, e, value, fmt); });
+	}
+
+	template<class V, memory_safety S, class... Args>
+	from_chars_result from_chars(const basic_string<char, S>& str, V& value, Args... args) {
+		return from_chars(basic_string_view<char, S>(str), value, args...);
+	}
+
+	template<class V, memory_safety S, class... Args>
+	from_chars_result from_chars(const basic_string_literal<char, S>& lit, V& value, Args... args) {
+		return from_chars(basic_string_view<char, S>(lit), value, args...);
+	}
+
+} //namespace safememory
+
+#endif //SAFE_MEMORY_STRING_VIEW_H
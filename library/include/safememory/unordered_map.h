@@ -36,6 +36,7 @@
 #include <safememory/functional.h>
 #include <safememory/detail/allocator_to_eastl.h>
 #include <safememory/detail/hashtable_iterator.h>
+#include <safememory/detail/rehash_policy.h>
 
 
 namespace safememory
@@ -43,11 +44,12 @@ namespace safememory
 	template <typename Key, typename T, typename Hash = hash<Key>, typename Predicate = equal_to<Key>, 
 			  memory_safety Safety = safeness_declarator<Key>::is_safe>
 	class SAFEMEMORY_DEEP_CONST_WHEN_PARAMS unordered_map
-		: protected eastl::unordered_map<Key, T, Hash, Predicate, detail::allocator_to_eastl_hashtable<Safety>>
+		: protected eastl::unordered_map<Key, T, Hash, Predicate, detail::allocator_to_eastl_hashtable<Safety>, false, detail::rehash_policy_of_t<Hash>>
 	{
 	public:
 		typedef eastl::unordered_map<Key, T, Hash, Predicate,
-			detail::allocator_to_eastl_hashtable<Safety>>                         base_type;
+			detail::allocator_to_eastl_hashtable<Safety>, false,
+			detail::rehash_policy_of_t<Hash>>                                    base_type;
 		typedef unordered_map<Key, T, Hash, Predicate, Safety>                    this_type;
 
 		typedef typename base_type::size_type                                     size_type;
@@ -55,6 +57,7 @@ namespace safememory
 		typedef typename base_type::mapped_type                                   mapped_type;
 		typedef typename base_type::value_type                                    value_type;
 		typedef typename base_type::allocator_type                                allocator_type;
+		typedef typename base_type::rehash_policy_type                            rehash_policy_type;
 		typedef typename base_type::node_type                                     node_type;
 		typedef typename base_type::iterator                                      iterator_base;
 		typedef typename base_type::const_iterator                                const_iterator_base;
@@ -156,6 +159,11 @@ namespace safememory
 		float load_factor() const { checkNotNull(); return base_type::load_factor(); }
 		float get_max_load_factor() const { checkNotNull(); return base_type::get_max_load_factor(); }
 		void set_max_load_factor(float fMaxLoadFactor) { checkNotNull(); base_type::set_max_load_factor(fMaxLoadFactor); }
+		const rehash_policy_type& rehash_policy() const { checkNotNull(); return base_type::rehash_policy(); }
+		void rehash_policy(const rehash_policy_type& rehashPolicy) { checkNotNull(); base_type::rehash_policy(rehashPolicy); }
+		size_type node_pool_size() const { checkNotNull(); return base_type::get_allocator().node_pool_size(); }
+		size_type node_pool_capacity() const { checkNotNull(); return base_type::get_allocator().node_pool_capacity(); }
+		void node_pool_capacity(size_type n) { checkNotNull(); base_type::get_allocator().node_pool_capacity(n); }
 
 		template <class... Args>
 		insert_return_type emplace(Args&&... args) {
@@ -354,7 +362,7 @@ namespace safememory
 		}
 
         void clear() { checkNotNull(); base_type::clear(); }
-        void rehash(size_type nBucketCount) { checkNotNull(); base_type::rehash(nBucketCount); }
+        void rehash(size_type nBucketCount) { checkNotNull(); base_type::rehash(base_type::rehash_policy().GetNextBucketCount(static_cast<uint32_t>(nBucketCount))); }
         void reserve(size_type nElementCount) { checkNotNull(); base_type::reserve(nElementCount); }
 
 		iterator       find(const key_type& key) { checkNotNull(); return makeIt(base_type::find(key)); }
@@ -389,6 +397,20 @@ namespace safememory
             return { makeSafeIt(p.first), makeSafeIt(p.second) };
         }
 
+		// mb: walks buckets and nodes without the per step checks of iterators,
+		// 'f' must not insert or erase elements
+		template <typename F>
+		void for_each(F f) {
+			checkNotNull();
+			detail::hashtable_for_each<allocator_type, value_type>(base_type::mpBucketArray, base_type::mnBucketCount, base_type::mAllocator.node_modifications(), f);
+		}
+
+		template <typename F>
+		void for_each(F f) const {
+			checkNotNull();
+			detail::hashtable_for_each<allocator_type, const value_type>(base_type::mpBucketArray, base_type::mnBucketCount, base_type::mAllocator.node_modifications(), f);
+		}
+
 		using base_type::validate;
 		int validate_iterator(const_iterator_base it) const noexcept { return base_type::validate_iterator(it); }
 		//TODO: custom validation for safe iterators
@@ -509,6 +531,8 @@ namespace safememory
 		using typename base_type::local_iterator;
 		using typename base_type::const_local_iterator;
 		typedef typename base_type::insert_return_type_safe                       insert_return_type;
+		typedef typename base_type::iterator                                      iterator_stack_only;
+		typedef typename base_type::insert_return_type                            insert_return_type_stack_only;
 
 
 	public:
@@ -569,7 +593,7 @@ namespace safememory
 		}
 
 		template <class... Args>
-		iterator emplace_hint(const_iterator hint, Args&&... args) {
+		iterator emplace_hint(const const_iterator& hint, Args&&... args) {
             return base_type::emplace_hint_safe(hint, std::forward<Args>(args)...);
         }
 
@@ -584,12 +608,12 @@ namespace safememory
         }
 
 		template <class... Args> 
-        iterator try_emplace(const_iterator hint, const key_type& k, Args&&... args) {
+        iterator try_emplace(const const_iterator& hint, const key_type& k, Args&&... args) {
             return base_type::try_emplace_safe(hint, k, std::forward<Args>(args)...);
         }
 
 		template <class... Args>
-        iterator try_emplace(const_iterator hint, key_type&& k, Args&&... args) {
+        iterator try_emplace(const const_iterator& hint, key_type&& k, Args&&... args) {
             return base_type::try_emplace_safe(hint, std::move(k), std::forward<Args>(args)...);
         }
 
@@ -601,11 +625,11 @@ namespace safememory
             return base_type::insert_safe(std::move(value));
         }
 
-		iterator insert(const_iterator hint, const value_type& value) {
+		iterator insert(const const_iterator& hint, const value_type& value) {
             return base_type::insert_safe(hint, value);
         }
 
-		iterator insert(const_iterator hint, value_type&& value) {
+		iterator insert(const const_iterator& hint, value_type&& value) {
             return base_type::insert_safe(hint, std::move(value));
         }
 
@@ -627,17 +651,52 @@ namespace safememory
         }
 
 		template <class M>
-        iterator insert_or_assign(const_iterator hint, const key_type& k, M&& obj) {
+        iterator insert_or_assign(const const_iterator& hint, const key_type& k, M&& obj) {
             return base_type::insert_or_assign_safe(hint, k, std::forward<M>(obj));
         }
 
 		template <class M>
-        iterator insert_or_assign(const_iterator hint, key_type&& k, M&& obj) {
+        iterator insert_or_assign(const const_iterator& hint, key_type&& k, M&& obj) {
             return base_type::insert_or_assign_safe(hint, std::move(k), std::forward<M>(obj));
         }
 
-		iterator erase(const_iterator position) { return base_type::erase_safe(position); }
-		iterator erase(const_iterator first, const_iterator last) { return base_type::erase_safe(first, last); }
+		// mb: '_stack_only' variants return a regular iterator, that doesn't hook a soft_ptr
+		// on the node ControlBlock. Use them when the result is discarded or only 'second' is used.
+		template <class... Args>
+		insert_return_type_stack_only emplace_stack_only(Args&&... args) {
+			return base_type::emplace(std::forward<Args>(args)...);
+		}
+
+		template <class... Args>
+		insert_return_type_stack_only try_emplace_stack_only(const key_type& k, Args&&... args) {
+			return base_type::try_emplace(k, std::forward<Args>(args)...);
+		}
+
+		template <class... Args>
+		insert_return_type_stack_only try_emplace_stack_only(key_type&& k, Args&&... args) {
+			return base_type::try_emplace(std::move(k), std::forward<Args>(args)...);
+		}
+
+		insert_return_type_stack_only insert_stack_only(const value_type& value) {
+			return base_type::insert(value);
+		}
+
+		insert_return_type_stack_only insert_stack_only(value_type&& value) {
+			return base_type::insert(std::move(value));
+		}
+
+		template <class M>
+		insert_return_type_stack_only insert_or_assign_stack_only(const key_type& k, M&& obj) {
+			return base_type::insert_or_assign(k, std::forward<M>(obj));
+		}
+
+		template <class M>
+		insert_return_type_stack_only insert_or_assign_stack_only(key_type&& k, M&& obj) {
+			return base_type::insert_or_assign(std::move(k), std::forward<M>(obj));
+		}
+
+		iterator erase(const const_iterator& position) { return base_type::erase_safe(position); }
+		iterator erase(const const_iterator& first, const const_iterator& last) { return base_type::erase_safe(first, last); }
 		size_type erase(const key_type& k) { return base_type::erase(k); }
 
         // using base_type::clear;
@@ -662,11 +721,12 @@ namespace safememory
 	template <typename Key, typename T, typename Hash = hash<Key>, typename Predicate = equal_to<Key>, 
 			  memory_safety Safety = safeness_declarator<Key>::is_safe>
 	class SAFEMEMORY_DEEP_CONST_WHEN_PARAMS unordered_multimap
-		: private eastl::unordered_multimap<Key, T, Hash, Predicate, detail::allocator_to_eastl_hashtable<Safety>>
+		: private eastl::unordered_multimap<Key, T, Hash, Predicate, detail::allocator_to_eastl_hashtable<Safety>, false, detail::rehash_policy_of_t<Hash>>
 	{
 	public:
 		typedef eastl::unordered_multimap<Key, T, Hash, Predicate,
-			detail::allocator_to_eastl_hashtable<Safety>>                         base_type;
+			detail::allocator_to_eastl_hashtable<Safety>, false,
+			detail::rehash_policy_of_t<Hash>>                                    base_type;
 		typedef unordered_multimap<Key, T, Hash, Predicate, Safety>               this_type;
 
 		// everything below this line is copy and paste from unordered_map, but:
@@ -682,6 +742,7 @@ namespace safememory
 		typedef typename base_type::mapped_type                                   mapped_type;
 		typedef typename base_type::value_type                                    value_type;
 		typedef typename base_type::allocator_type                                allocator_type;
+		typedef typename base_type::rehash_policy_type                            rehash_policy_type;
 		typedef typename base_type::node_type                                     node_type;
 		typedef typename base_type::iterator                                      iterator_base;
 		typedef typename base_type::const_iterator                                const_iterator_base;
@@ -783,6 +844,11 @@ namespace safememory
 		float load_factor() const { checkNotNull(); return base_type::load_factor(); }
 		float get_max_load_factor() const { checkNotNull(); return base_type::get_max_load_factor(); }
 		void set_max_load_factor(float fMaxLoadFactor) { checkNotNull(); base_type::set_max_load_factor(fMaxLoadFactor); }
+		const rehash_policy_type& rehash_policy() const { checkNotNull(); return base_type::rehash_policy(); }
+		void rehash_policy(const rehash_policy_type& rehashPolicy) { checkNotNull(); base_type::rehash_policy(rehashPolicy); }
+		size_type node_pool_size() const { checkNotNull(); return base_type::get_allocator().node_pool_size(); }
+		size_type node_pool_capacity() const { checkNotNull(); return base_type::get_allocator().node_pool_capacity(); }
+		void node_pool_capacity(size_type n) { checkNotNull(); base_type::get_allocator().node_pool_capacity(n); }
 
 		template <class... Args>
 		insert_return_type emplace(Args&&... args) {
@@ -981,7 +1047,7 @@ namespace safememory
 		}
 
         void clear() { checkNotNull(); base_type::clear(); }
-        void rehash(size_type nBucketCount) { checkNotNull(); base_type::rehash(nBucketCount); }
+        void rehash(size_type nBucketCount) { checkNotNull(); base_type::rehash(base_type::rehash_policy().GetNextBucketCount(static_cast<uint32_t>(nBucketCount))); }
         void reserve(size_type nElementCount) { checkNotNull(); base_type::reserve(nElementCount); }
 
 		iterator       find(const key_type& key) { checkNotNull(); return makeIt(base_type::find(key)); }
@@ -1016,6 +1082,20 @@ namespace safememory
             return { makeSafeIt(p.first), makeSafeIt(p.second) };
         }
 
+		// mb: walks buckets and nodes without the per step checks of iterators,
+		// 'f' must not insert or erase elements
+		template <typename F>
+		void for_each(F f) {
+			checkNotNull();
+			detail::hashtable_for_each<allocator_type, value_type>(base_type::mpBucketArray, base_type::mnBucketCount, base_type::mAllocator.node_modifications(), f);
+		}
+
+		template <typename F>
+		void for_each(F f) const {
+			checkNotNull();
+			detail::hashtable_for_each<allocator_type, const value_type>(base_type::mpBucketArray, base_type::mnBucketCount, base_type::mAllocator.node_modifications(), f);
+		}
+
 		using base_type::validate;
 		int validate_iterator(const_iterator_base it) const noexcept { return base_type::validate_iterator(it); }
 		//TODO: custom validation for safe iterators
@@ -1132,5 +1212,16 @@ namespace safememory
 
 } // namespace safememory
 
+namespace eastl
+{
+	// Buckets, nodes and the node pool are all on the heap, nothing is bound to the address
+	// of the map itself.
+	template <typename K, typename T, typename H, typename P, safememory::memory_safety S>
+	struct is_trivially_relocatable<safememory::unordered_map<K, T, H, P, S>> : public true_type {};
+
+	template <typename K, typename T, typename H, typename P, safememory::memory_safety S>
+	struct is_trivially_relocatable<safememory::unordered_multimap<K, T, H, P, S>> : public true_type {};
+} // namespace eastl
+
 
 #endif //SAFE_MEMORY_UNORDERED_MAP_H
@@ -34,6 +34,7 @@
 #include <safememory/functional.h>
 #include <safememory/detail/allocator_to_eastl.h>
 #include <safememory/detail/hashtable_iterator.h>
+#include <safememory/detail/rehash_policy.h>
 
 
 namespace safememory
@@ -41,11 +42,12 @@ namespace safememory
 	template <typename Key, typename Hash = hash<Key>, typename Predicate = equal_to<Key>, 
 			  memory_safety Safety = safeness_declarator<Key>::is_safe>
 	class SAFEMEMORY_DEEP_CONST_WHEN_PARAMS unordered_set
-		: private eastl::unordered_set<Key, Hash, Predicate, detail::allocator_to_eastl_hashtable<Safety>>
+		: private eastl::unordered_set<Key, Hash, Predicate, detail::allocator_to_eastl_hashtable<Safety>, false, detail::rehash_policy_of_t<Hash>>
 	{
 	public:
 		typedef eastl::unordered_set<Key, Hash, Predicate,
-			detail::allocator_to_eastl_hashtable<Safety>>                         base_type;
+			detail::allocator_to_eastl_hashtable<Safety>, false,
+			detail::rehash_policy_of_t<Hash>>                                    base_type;
 		typedef unordered_set<Key, Hash, Predicate, Safety>                       this_type;
 
 		// everything below this line is identical to unordered_map, but:
@@ -62,6 +64,7 @@ namespace safememory
 		typedef typename base_type::mapped_type                                   mapped_type;
 		typedef typename base_type::value_type                                    value_type;
 		typedef typename base_type::allocator_type                                allocator_type;
+		typedef typename base_type::rehash_policy_type                            rehash_policy_type;
 		typedef typename base_type::node_type                                     node_type;
 		typedef typename base_type::iterator                                      iterator_base;
 		typedef typename base_type::const_iterator                                const_iterator_base;
@@ -163,6 +166,11 @@ namespace safememory
 		float load_factor() const { checkNotNull(); return base_type::load_factor(); }
 		float get_max_load_factor() const { checkNotNull(); return base_type::get_max_load_factor(); }
 		void set_max_load_factor(float fMaxLoadFactor) { checkNotNull(); base_type::set_max_load_factor(fMaxLoadFactor); }
+		const rehash_policy_type& rehash_policy() const { checkNotNull(); return base_type::rehash_policy(); }
+		void rehash_policy(const rehash_policy_type& rehashPolicy) { checkNotNull(); base_type::rehash_policy(rehashPolicy); }
+		size_type node_pool_size() const { checkNotNull(); return base_type::get_allocator().node_pool_size(); }
+		size_type node_pool_capacity() const { checkNotNull(); return base_type::get_allocator().node_pool_capacity(); }
+		void node_pool_capacity(size_type n) { checkNotNull(); base_type::get_allocator().node_pool_capacity(n); }
 
 		template <class... Args>
 		insert_return_type emplace(Args&&... args) {
@@ -361,7 +369,7 @@ namespace safememory
 		}
 
         void clear() { checkNotNull(); base_type::clear(); }
-        void rehash(size_type nBucketCount) { checkNotNull(); base_type::rehash(nBucketCount); }
+        void rehash(size_type nBucketCount) { checkNotNull(); base_type::rehash(base_type::rehash_policy().GetNextBucketCount(static_cast<uint32_t>(nBucketCount))); }
         void reserve(size_type nElementCount) { checkNotNull(); base_type::reserve(nElementCount); }
 
 		iterator       find(const key_type& key) { checkNotNull(); return makeIt(base_type::find(key)); }
@@ -396,6 +404,14 @@ namespace safememory
             return { makeSafeIt(p.first), makeSafeIt(p.second) };
         }
 
+		// mb: walks buckets and nodes without the per step checks of iterators,
+		// 'f' must not insert or erase elements
+		template <typename F>
+		void for_each(F f) const {
+			checkNotNull();
+			detail::hashtable_for_each<allocator_type, const value_type>(base_type::mpBucketArray, base_type::mnBucketCount, base_type::mAllocator.node_modifications(), f);
+		}
+
 		using base_type::validate;
 		int validate_iterator(const_iterator_base it) const noexcept { return base_type::validate_iterator(it); }
 		//TODO: custom validation for safe iterators
@@ -506,8 +522,8 @@ namespace safememory
 		// everything below this line is identical to unordered_map_safe, but:
 		// rename ctor and dtor
 		// remove at and operator[]
-		// remove try_emplace and try_emplace_safe
-		// remove insert_or_assign and insert_or_assign_safe
+		// remove try_emplace, try_emplace_safe and try_emplace_stack_only
+		// remove insert_or_assign, insert_or_assign_safe and insert_or_assign_stack_only
 
 		using typename base_type::size_type;
 		using typename base_type::key_type;
@@ -521,6 +537,8 @@ namespace safememory
 		using typename base_type::local_iterator;
 		using typename base_type::const_local_iterator;
 		typedef typename base_type::insert_return_type_safe                       insert_return_type;
+		typedef typename base_type::iterator                                      iterator_stack_only;
+		typedef typename base_type::insert_return_type                            insert_return_type_stack_only;
 
 
 	public:
@@ -581,7 +599,7 @@ namespace safememory
 		}
 
 		template <class... Args>
-		iterator emplace_hint(const_iterator hint, Args&&... args) {
+		iterator emplace_hint(const const_iterator& hint, Args&&... args) {
             return base_type::emplace_hint_safe(hint, std::forward<Args>(args)...);
         }
 
@@ -596,12 +614,12 @@ namespace safememory
         // }
 
 		// template <class... Args> 
-        // iterator try_emplace(const_iterator hint, const key_type& k, Args&&... args) {
+        // iterator try_emplace(const const_iterator& hint, const key_type& k, Args&&... args) {
         //     return base_type::try_emplace_safe(hint, k, std::forward<Args>(args)...);
         // }
 
 		// template <class... Args>
-        // iterator try_emplace(const_iterator hint, key_type&& k, Args&&... args) {
+        // iterator try_emplace(const const_iterator& hint, key_type&& k, Args&&... args) {
         //     return base_type::try_emplace_safe(hint, std::move(k), std::forward<Args>(args)...);
         // }
 
@@ -613,11 +631,11 @@ namespace safememory
             return base_type::insert_safe(std::move(value));
         }
 
-		iterator insert(const_iterator hint, const value_type& value) {
+		iterator insert(const const_iterator& hint, const value_type& value) {
             return base_type::insert_safe(hint, value);
         }
 
-		iterator insert(const_iterator hint, value_type&& value) {
+		iterator insert(const const_iterator& hint, value_type&& value) {
             return base_type::insert_safe(hint, std::move(value));
         }
 
@@ -639,17 +657,32 @@ namespace safememory
         // }
 
 		// template <class M>
-        // iterator insert_or_assign(const_iterator hint, const key_type& k, M&& obj) {
+        // iterator insert_or_assign(const const_iterator& hint, const key_type& k, M&& obj) {
         //     return base_type::insert_or_assign_safe(hint, k, std::forward<M>(obj));
         // }
 
 		// template <class M>
-        // iterator insert_or_assign(const_iterator hint, key_type&& k, M&& obj) {
+        // iterator insert_or_assign(const const_iterator& hint, key_type&& k, M&& obj) {
         //     return base_type::insert_or_assign_safe(hint, std::move(k), std::forward<M>(obj));
         // }
 
-		iterator erase(const_iterator position) { return base_type::erase_safe(position); }
-		iterator erase(const_iterator first, const_iterator last) { return base_type::erase_safe(first, last); }
+		// mb: '_stack_only' variants return a regular iterator, that doesn't hook a soft_ptr
+		// on the node ControlBlock. Use them when the result is discarded or only 'second' is used.
+		template <class... Args>
+		insert_return_type_stack_only emplace_stack_only(Args&&... args) {
+			return base_type::emplace(std::forward<Args>(args)...);
+		}
+
+		insert_return_type_stack_only insert_stack_only(const value_type& value) {
+			return base_type::insert(value);
+		}
+
+		insert_return_type_stack_only insert_stack_only(value_type&& value) {
+			return base_type::insert(std::move(value));
+		}
+
+		iterator erase(const const_iterator& position) { return base_type::erase_safe(position); }
+		iterator erase(const const_iterator& first, const const_iterator& last) { return base_type::erase_safe(first, last); }
 		size_type erase(const key_type& k) { return base_type::erase(k); }
 
         // using base_type::clear;
@@ -674,11 +707,12 @@ namespace safememory
 	template <typename Key, typename Hash = hash<Key>, typename Predicate = equal_to<Key>, 
 			  memory_safety Safety = safeness_declarator<Key>::is_safe>
 	class SAFEMEMORY_DEEP_CONST_WHEN_PARAMS unordered_multiset
-		: private eastl::unordered_multiset<Key, Hash, Predicate, detail::allocator_to_eastl_hashtable<Safety>>
+		: private eastl::unordered_multiset<Key, Hash, Predicate, detail::allocator_to_eastl_hashtable<Safety>, false, detail::rehash_policy_of_t<Hash>>
 	{
 	public:
 		typedef eastl::unordered_multiset<Key, Hash, Predicate,
-			detail::allocator_to_eastl_hashtable<Safety>>                         base_type;
+			detail::allocator_to_eastl_hashtable<Safety>, false,
+			detail::rehash_policy_of_t<Hash>>                                    base_type;
 		typedef unordered_multiset<Key, Hash, Predicate, Safety>                  this_type;
 
 		// everything below this line is copy and paste from unordered_map, but:
@@ -697,6 +731,7 @@ namespace safememory
 		typedef typename base_type::mapped_type                                   mapped_type;
 		typedef typename base_type::value_type                                    value_type;
 		typedef typename base_type::allocator_type                                allocator_type;
+		typedef typename base_type::rehash_policy_type                            rehash_policy_type;
 		typedef typename base_type::node_type                                     node_type;
 		typedef typename base_type::iterator                                      iterator_base;
 		typedef typename base_type::const_iterator                                const_iterator_base;
@@ -798,6 +833,11 @@ namespace safememory
 		float load_factor() const { checkNotNull(); return base_type::load_factor(); }
 		float get_max_load_factor() const { checkNotNull(); return base_type::get_max_load_factor(); }
 		void set_max_load_factor(float fMaxLoadFactor) { checkNotNull(); base_type::set_max_load_factor(fMaxLoadFactor); }
+		const rehash_policy_type& rehash_policy() const { checkNotNull(); return base_type::rehash_policy(); }
+		void rehash_policy(const rehash_policy_type& rehashPolicy) { checkNotNull(); base_type::rehash_policy(rehashPolicy); }
+		size_type node_pool_size() const { checkNotNull(); return base_type::get_allocator().node_pool_size(); }
+		size_type node_pool_capacity() const { checkNotNull(); return base_type::get_allocator().node_pool_capacity(); }
+		void node_pool_capacity(size_type n) { checkNotNull(); base_type::get_allocator().node_pool_capacity(n); }
 
 		template <class... Args>
 		insert_return_type emplace(Args&&... args) {
@@ -996,7 +1036,7 @@ namespace safememory
 		}
 
         void clear() { checkNotNull(); base_type::clear(); }
-        void rehash(size_type nBucketCount) { checkNotNull(); base_type::rehash(nBucketCount); }
+        void rehash(size_type nBucketCount) { checkNotNull(); base_type::rehash(base_type::rehash_policy().GetNextBucketCount(static_cast<uint32_t>(nBucketCount))); }
         void reserve(size_type nElementCount) { checkNotNull(); base_type::reserve(nElementCount); }
 
 		iterator       find(const key_type& key) { checkNotNull(); return makeIt(base_type::find(key)); }
@@ -1031,6 +1071,14 @@ namespace safememory
             return { makeSafeIt(p.first), makeSafeIt(p.second) };
         }
 
+		// mb: walks buckets and nodes without the per step checks of iterators,
+		// 'f' must not insert or erase elements
+		template <typename F>
+		void for_each(F f) const {
+			checkNotNull();
+			detail::hashtable_for_each<allocator_type, const value_type>(base_type::mpBucketArray, base_type::mnBucketCount, base_type::mAllocator.node_modifications(), f);
+		}
+
 		using base_type::validate;
 		int validate_iterator(const_iterator_base it) const noexcept { return base_type::validate_iterator(it); }
 		//TODO: custom validation for safe iterators
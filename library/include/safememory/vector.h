@@ -212,6 +212,20 @@ namespace safememory
 		pointer       data_unsafe() noexcept { return base_type::data(); }
 		const_pointer data_unsafe() const noexcept { return base_type::data(); }
 
+		// like C++23 string::resize_and_overwrite, for trivial types only.
+		// Capacity grows to 'n' without initializing elements, 'op(begin(), n)' writes them
+		// and returns the final size, only elements up to that size become part of the vector
+		template <typename Operation>
+		void resize_and_overwrite(size_type n, Operation op) {
+			DoResizeAndOverwrite(n, [&op, this](size_type sz) { return op(begin(), sz); });
+		}
+
+		// same as above, but 'op' gets a raw pointer, as needed to call the OS
+		template <typename Operation>
+		void resize_and_overwrite_unsafe(size_type n, Operation op) {
+			DoResizeAndOverwrite(n, [&op, this](size_type sz) { return op(data_unsafe(), sz); });
+		}
+
 		reference       operator[](size_type n);
 		const_reference operator[](size_type n) const;
 
@@ -281,6 +295,23 @@ namespace safememory
 		}
 
 
+		// append at the end, both ends of a range are validated once,
+		// and trivially copyable elements are copied with a single memcpy
+		void append_unsafe(const_pointer p, size_type n) { DoAppend(p, p + n); }
+
+		void append(const_iterator_arg first, const_iterator_arg last) {
+			auto other = toBaseOther(first, last);
+			DoAppend(other.first, other.second);
+		}
+
+		void append_safe(const const_iterator_safe& first, const const_iterator_safe& last) {
+			auto other = toBaseOther(first, last);
+			DoAppend(other.first, other.second);
+		}
+
+		void append(const this_type& other) { DoAppend(other.begin_unsafe(), other.end_unsafe()); }
+
+
 		iterator_safe insert_safe(const const_iterator_safe& position, const value_type& value) {
 			return makeSafeIt(base_type::insert(toBase(position), value));
 		}
@@ -362,6 +393,24 @@ namespace safememory
 	protected:
 		[[noreturn]] static void ThrowRangeException() { throw nodecpp::error::out_of_range; }
 
+		void DoAppend(const_pointer first, const_pointer last);
+
+		template <typename F>
+		void DoResizeAndOverwrite(size_type n, F f) {
+			static_assert(std::is_trivial_v<T>, "resize_and_overwrite requires a trivial type");
+
+			if(n > capacity())
+				base_type::reserve(n);
+
+			// mb: op may also change this vector (i.e. clear, shrink_to_fit or push_back),
+			// so the result is checked against the buffer we have now, not the one we gave
+			const_pointer p = base_type::data();
+			const size_type r = static_cast<size_type>(f(n));
+			if(NODECPP_UNLIKELY(r > n || p != base_type::data() || r > capacity()))
+				ThrowRangeException();
+
+			base_type::mpEnd = begin_unsafe() + r;
+		}
 
         const base_type& toBase() const noexcept { return *this; }
 
@@ -491,6 +540,37 @@ namespace safememory
 		base_type::assign(p.first, p.second);
 	}
 
+	template <typename T, memory_safety Safety>
+	inline void vector<T, Safety>::DoAppend(const_pointer first, const_pointer last)
+	{
+		const size_type n = static_cast<size_type>(last - first);
+		if(n == 0)
+			return;
+
+		if(n > size_type(base_type::internalCapacityPtr() - base_type::mpEnd)) {
+			// mb: eastl::vector moves old elements before copying the range,
+			// so when appending our own elements, grow first and then relocate the range
+			const bool own = first >= begin_unsafe() && first < end_unsafe();
+			const difference_type offset = own ? first - begin_unsafe() : 0;
+
+			const size_type sz = size();
+			const size_type grow = base_type::GetNewCapacity(sz);
+			base_type::DoGrow(grow > sz + n ? grow : sz + n, grow > sz + n);
+
+			if(own) {
+				first = begin_unsafe() + offset;
+				last = first + n;
+			}
+		}
+
+		if constexpr (std::is_trivially_copyable_v<T>) {
+			memcpy(base_type::mpEnd, first, n * sizeof(T));
+			base_type::mpEnd += n;
+		}
+		else
+			base_type::insert(base_type::end(), first, last);
+	}
+
 	template <typename T, memory_safety Safety>
 	inline typename vector<T, Safety>::reference
 	vector<T, Safety>::operator[](size_type n)
@@ -783,6 +863,11 @@ namespace safememory
 		// pointer       data_unsafe() noexcept { return base_type::data(); }
 		// const_pointer data_unsafe() const noexcept { return base_type::data(); }
 
+		template <typename Operation>
+		void resize_and_overwrite(size_type n, Operation op) {
+			base_type::DoResizeAndOverwrite(n, [&op, this](size_type sz) { return op(begin(), sz); });
+		}
+
 		// reference       operator[](size_type n);
 		// const_reference operator[](size_type n) const;
 
@@ -850,6 +935,9 @@ namespace safememory
 			return base_type::insert_safe(position, first, last);
 		}
 
+		void append(const_iterator_arg first, const_iterator_arg last) { base_type::append_safe(first, last); }
+		void append(const this_type& other) { base_type::append(other); }
+
 
 		// iterator_safe insert_safe(const const_iterator_safe& position, const value_type& value) {
 		// 	return makeSafeIt(base_type::insert(toBase(position), value));
@@ -937,4 +1025,13 @@ namespace safememory
 
 } // namespace safememory
 
+namespace eastl
+{
+	// vector only holds pointers to its heap array. The iterator registry is not relocatable.
+#ifndef SAFEMEMORY_DEZOMBIEFY_ITERATORS
+	template <typename T, safememory::memory_safety Safety>
+	struct is_trivially_relocatable<safememory::vector<T, Safety>> : public true_type {};
+#endif
+} // namespace eastl
+
 #endif // Header include guard
@@ -40,6 +40,7 @@ thread_local std::size_t safememory::detail::CountSoftPtrBaseDtor = 0;
 #endif // NODECPP_DEBUG_COUNT_SOFT_PTR_ENABLED
 
 thread_local void* safememory::detail::thg_stackPtrForMakeOwningCall = NODECPP_SECOND_NULLPTR;
+thread_local std::size_t safememory::detail::thg_stackSizeForMakeOwningCall = 0;
 
 namespace safememory::detail {
 #if defined NODECPP_USE_NEW_DELETE_ALLOC
@@ -49,6 +49,8 @@ namespace safememory::detail
 {
 	
 extern thread_local void* thg_stackPtrForMakeOwningCall;
+// size of the object at thg_stackPtrForMakeOwningCall, so soft_this_ptr2 can tell its subobjects apart
+extern thread_local std::size_t thg_stackSizeForMakeOwningCall;
 
 template<class T>
 void checkNotNullLargeSize( T* ptr )
@@ -770,7 +772,7 @@ public:
 		{
 			if ( NODECPP_LIKELY(t.getTypedPtr()) )
 			{
-				destruct( t.getTypedPtr() );
+				::safememory::detail::destruct( t.getTypedPtr() );
 				deallocate( t.getPtr(), alignof(T), t.allocatorIdx() );
 				t.reset();
 			}
@@ -780,7 +782,7 @@ public:
 		//dbgValidateList();
 		if ( NODECPP_LIKELY(t.getTypedPtr()) )
 		{
-			destruct( t.getTypedPtr() );
+			::safememory::detail::destruct( t.getTypedPtr() );
 #ifdef NODECPP_MEMORY_SAFETY_DBG_ADD_PTR_LIFECYCLE_INFO
 			dbgSetDestructionPointInfo( DbgDestructionInfo::Destruction::dtoring );
 #endif // NODECPP_MEMORY_SAFETY_DBG_ADD_PTR_LIFECYCLE_INFO
@@ -805,7 +807,7 @@ public:
 		{
 			if ( NODECPP_LIKELY(t.getTypedPtr()) )
 			{
-				destruct( t.getTypedPtr() );
+				::safememory::detail::destruct( t.getTypedPtr() );
 				deallocate( t.getTypedPtr(), t.allocatorIdx() );
 				t.reset();
 			}
@@ -814,7 +816,7 @@ public:
 #endif
 		if ( NODECPP_LIKELY(t.getTypedPtr()) )
 		{
-			destruct( t.getTypedPtr() );
+			::safememory::detail::destruct( t.getTypedPtr() );
 #ifdef NODECPP_MEMORY_SAFETY_DBG_ADD_PTR_LIFECYCLE_INFO
 			dbgSetDestructionPointInfo( DbgDestructionInfo::Destruction::resetting );
 #endif // NODECPP_MEMORY_SAFETY_DBG_ADD_PTR_LIFECYCLE_INFO
@@ -976,7 +978,9 @@ NODISCARD owning_ptr_impl<_Ty> make_owning_impl(_Types&&... _Args)
 	uint8_t* dataForObj = data + sizeof(FirstControlBlock) - getPrefixByteCount();
 	NODECPP_ASSERT( nodecpp::foundation::module_id, nodecpp::assert::AssertLevel::pedantic, ((uintptr_t)dataForObj & (alignof(_Ty)-1)) == 0, "indeed, dataForObj = 0x{:x}, NODECPP_GUARANTEED_IIBMALLOC_ALIGNMENT = 0x{:x}", (uintptr_t)dataForObj, alignof(_Ty) );
 	void* stackTmp = thg_stackPtrForMakeOwningCall;
+	std::size_t stackSizeTmp = thg_stackSizeForMakeOwningCall;
 	thg_stackPtrForMakeOwningCall = dataForObj;
+	thg_stackSizeForMakeOwningCall = sizeof(_Ty);
 #ifdef NODECPP_MEMORY_SAFETY_ON_DEMAND
 	owning_ptr_impl<_Ty> op(make_owning_t( allocatorID ), (_Ty*)(uintptr_t)(dataForObj));
 #else
@@ -985,11 +989,13 @@ NODISCARD owning_ptr_impl<_Ty> make_owning_impl(_Types&&... _Args)
 	try { 
 		new ( dataForObj ) _Ty(::std::forward<_Types>(_Args)...);
 		thg_stackPtrForMakeOwningCall = stackTmp;
+		thg_stackSizeForMakeOwningCall = stackSizeTmp;
 		return op;
 	}
 	catch( ... ) {
 		killUnderconsructedOP( op );
 		thg_stackPtrForMakeOwningCall = stackTmp;
+		thg_stackSizeForMakeOwningCall = stackSizeTmp;
 #ifdef NODECPP_MEMORY_SAFETY_ON_DEMAND
 		zombieDeallocate(data, allocatorID);
 #else
@@ -2287,13 +2293,18 @@ class soft_this_ptr2_impl
 {
 	FirstControlBlock* cbPtr = nullptr;
 
-	static FirstControlBlock* getCbPtr() {
+	FirstControlBlock* getCbPtr() const {
 		if(thg_stackPtrForMakeOwningCall == NODECPP_SECOND_NULLPTR)
 			return nullptr;
 #ifdef NODECPP_MEMORY_SAFETY_ON_DEMAND
 		else if(thg_stackPtrForMakeOwningCall == nullptr)
 			return reinterpret_cast<FirstControlBlock*>(NODECPP_SECOND_NULLPTR);
 #endif
+		// mb: any object created while the owner is constructed sees the same pointer,
+		// (i.e. a local variable in the owner constructor), only subobjects are anchored
+		uintptr_t delta = reinterpret_cast<const uint8_t*>(this) - reinterpret_cast<const uint8_t*>(thg_stackPtrForMakeOwningCall);
+		if(delta >= thg_stackSizeForMakeOwningCall)
+			return nullptr;
 		else
 			return getControlBlock_(thg_stackPtrForMakeOwningCall);
 	}
@@ -2311,6 +2322,10 @@ public:
 
 	~soft_this_ptr2_impl() = default;
 
+	/// to be called after the owner was relocated bitwise (see \c eastl::relocation_fixup),
+	/// it picks up the control block the same way the move constructor does.
+	void relocated() { cbPtr = getCbPtr(); }
+
 	explicit operator bool() const noexcept {
 		return cbPtr != nullptr;
 	}
@@ -2353,6 +2368,8 @@ class nullable_ptr_base_impl
 	friend T1* nullable_cast_impl( nullable_ptr_impl<T2> p );
 	template<class T1>
 	friend T1* nullable_cast_impl( nullable_ptr_impl<T1> p );
+	template<class T1>
+	friend T1* proven_not_null( const nullable_ptr_impl<T1>& p );
 
 	T* t;
 
@@ -2597,6 +2614,19 @@ T* nullable_cast_impl( nullable_ptr_impl<T> p ) {
 }
 
 
+/**
+ * \brief Unchecked access to a \c nullable_ptr that \c safememory-instrument proved not null.
+ *
+ * The tool rewrites a local \c p to \c proven_not_null(p) only at dereferences dominated by
+ * a null test of the same variable, so \c operator* and \c operator-> can skip
+ * \c checkNotNull*. Not for hand written code, \c safememory-checker rejects calls to it (S1.1.1).
+ */
+template<class T>
+T* proven_not_null( const nullable_ptr_impl<T>& p ) {
+	NODECPP_ASSERT(safememory::module_id, nodecpp::assert::AssertLevel::regular, p.t != nullptr );
+	return p.t;
+}
+
 template<class T, class T1>
 nullable_ptr_impl<T1> nullable_cast_impl( T* p ) {
 	return nullable_ptr_impl<T1>( p );
@@ -723,14 +723,16 @@ public:
 
 	soft_this_ptr2_no_checks() = default;
 
-	soft_this_ptr2_no_checks(soft_this_ptr2_no_checks&) = default;
+	soft_this_ptr2_no_checks(const soft_this_ptr2_no_checks&) = default;
 	soft_this_ptr2_no_checks(soft_this_ptr2_no_checks&&) = default;
 
-	soft_this_ptr2_no_checks& operator=(soft_this_ptr2_no_checks&) = default;
+	soft_this_ptr2_no_checks& operator=(const soft_this_ptr2_no_checks&) = default;
 	soft_this_ptr2_no_checks& operator=(soft_this_ptr2_no_checks&&) = default;
 
 	~soft_this_ptr2_no_checks() = default;
 
+	void relocated() {}
+
 	explicit constexpr operator bool() const noexcept { return true; }
 
 	template<class T>
@@ -762,6 +764,8 @@ class nullable_ptr_base_no_checks
 	friend T1* nullable_cast_no_checks( nullable_ptr_no_checks<T2> p );
 	template<class T1>
 	friend T1* nullable_cast_no_checks( nullable_ptr_no_checks<T1> p );
+	template<class T1>
+	friend T1* proven_not_null( const nullable_ptr_no_checks<T1>& p );
 
 	T* t;
 
@@ -1007,6 +1011,11 @@ T* nullable_cast_no_checks( nullable_ptr_no_checks<T> p ) {
 }
 
 
+template<class T>
+T* proven_not_null( const nullable_ptr_no_checks<T>& p ) {
+	return p.t;
+}
+
 template<class T, class T1>
 nullable_ptr_no_checks<T1> nullable_cast_no_checks( T* p ) {
 	return nullable_ptr_no_checks<T1>( p );
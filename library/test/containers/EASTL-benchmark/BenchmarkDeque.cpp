@@ -0,0 +1,235 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+
+#include "EASTLBenchmark.h"
+#include "EASTLTest.h"
+#include "EAStopwatch.h"
+#include <safememory/deque.h>
+#include <safememory/ring_buffer.h>
+#include <EASTL/deque.h>
+#include <EASTL/vector.h>
+#include <EASTL/bonus/ring_buffer.h>
+
+
+
+EA_DISABLE_ALL_VC_WARNINGS()
+#include <stdio.h>
+EA_RESTORE_ALL_VC_WARNINGS()
+
+
+
+using namespace EA;
+
+
+namespace
+{
+	template <typename Container>
+	void TestPushBack(EA::StdC::Stopwatch& stopwatch, Container& c, const eastl::vector<uint32_t>& v)
+	{
+		stopwatch.Restart();
+		for(uint32_t each : v)
+			c.push_back(each);
+		stopwatch.Stop();
+		sprintf(Benchmark::gScratchBuffer, "%u", (unsigned)c.size());
+	}
+
+	template <typename Container>
+	void TestPushFront(EA::StdC::Stopwatch& stopwatch, Container& c, const eastl::vector<uint32_t>& v)
+	{
+		stopwatch.Restart();
+		for(uint32_t each : v)
+			c.push_front(each);
+		stopwatch.Stop();
+		sprintf(Benchmark::gScratchBuffer, "%u", (unsigned)c.size());
+	}
+
+	template <typename Container>
+	void TestPopFront(EA::StdC::Stopwatch& stopwatch, Container& c)
+	{
+		uint64_t temp = 0;
+		stopwatch.Restart();
+		while(!c.empty())
+		{
+			temp += c.front();
+			c.pop_front();
+		}
+		stopwatch.Stop();
+		sprintf(Benchmark::gScratchBuffer, "%u", (unsigned)temp);
+	}
+
+	// A FIFO queue in steady state, as used in network pipelines
+	template <typename Container>
+	void TestQueue(EA::StdC::Stopwatch& stopwatch, Container& c, const eastl::vector<uint32_t>& v, std::size_t depth)
+	{
+		uint64_t temp = 0;
+		stopwatch.Restart();
+		for(uint32_t each : v)
+		{
+			c.push_back(each);
+			if(c.size() > depth)
+			{
+				temp += c.front();
+				c.pop_front();
+			}
+		}
+		stopwatch.Stop();
+		sprintf(Benchmark::gScratchBuffer, "%u", (unsigned)temp);
+	}
+
+	template <typename Container>
+	void TestIteration(EA::StdC::Stopwatch& stopwatch, const Container& c)
+	{
+		uint64_t temp = 0;
+		stopwatch.Restart();
+		for(auto it = c.begin(); it != c.end(); ++it)
+			temp += *it;
+		stopwatch.Stop();
+		sprintf(Benchmark::gScratchBuffer, "%u", (unsigned)temp);
+	}
+
+	template <typename Container>
+	void TestBracket(EA::StdC::Stopwatch& stopwatch, const Container& c)
+	{
+		uint64_t temp = 0;
+		stopwatch.Restart();
+		for(std::size_t i = 0, iEnd = c.size(); i != iEnd; ++i)
+			temp += c[i];
+		stopwatch.Stop();
+		sprintf(Benchmark::gScratchBuffer, "%u", (unsigned)temp);
+	}
+
+} // namespace
+
+
+template<int IX, template<typename> typename Deque>
+void BenchmarkDequeTempl()
+{
+	EASTLTest_Rand  rng(GetRandSeed());
+	EA::StdC::Stopwatch stopwatch1(EA::StdC::Stopwatch::kUnitsCPUCycles);
+
+	eastl::vector<uint32_t> data(100000);
+	for(std::size_t i = 0; i != data.size(); ++i)
+		data[i] = rng.RandLimit(10000);
+
+	for(int i = 0; i < 2; i++)
+	{
+		Deque<uint32_t> d;
+
+		///////////////////////////////
+		// Test push_back / push_front / pop_front
+		///////////////////////////////
+
+		TestPushBack(stopwatch1, d, data);
+
+		if(i == 1)
+			Benchmark::AddResult("deque<uint32_t>/push_back", IX, stopwatch1);
+
+		TestIteration(stopwatch1, d);
+
+		if(i == 1)
+			Benchmark::AddResult("deque<uint32_t>/iteration", IX, stopwatch1);
+
+		TestBracket(stopwatch1, d);
+
+		if(i == 1)
+			Benchmark::AddResult("deque<uint32_t>/operator[]", IX, stopwatch1);
+
+		TestPopFront(stopwatch1, d);
+
+		if(i == 1)
+			Benchmark::AddResult("deque<uint32_t>/pop_front", IX, stopwatch1);
+
+		TestPushFront(stopwatch1, d, data);
+
+		if(i == 1)
+			Benchmark::AddResult("deque<uint32_t>/push_front", IX, stopwatch1);
+
+		d.clear();
+
+
+		///////////////////////////////
+		// Test queue in steady state
+		///////////////////////////////
+
+		TestQueue(stopwatch1, d, data, 64);
+
+		if(i == 1)
+			Benchmark::AddResult("deque<uint32_t>/queue depth 64", IX, stopwatch1);
+	}
+}
+
+template<int IX, typename RingBuffer>
+void BenchmarkRingBufferTempl()
+{
+	EASTLTest_Rand  rng(GetRandSeed());
+	EA::StdC::Stopwatch stopwatch1(EA::StdC::Stopwatch::kUnitsCPUCycles);
+
+	eastl::vector<uint32_t> data(100000);
+	for(std::size_t i = 0; i != data.size(); ++i)
+		data[i] = rng.RandLimit(10000);
+
+	for(int i = 0; i < 2; i++)
+	{
+		RingBuffer rb(1024);
+
+		///////////////////////////////
+		// Test push_back overwriting the front
+		///////////////////////////////
+
+		TestPushBack(stopwatch1, rb, data);
+
+		if(i == 1)
+			Benchmark::AddResult("ring_buffer<uint32_t>/push_back", IX, stopwatch1);
+
+		TestIteration(stopwatch1, rb);
+
+		if(i == 1)
+			Benchmark::AddResult("ring_buffer<uint32_t>/iteration", IX, stopwatch1);
+
+		TestBracket(stopwatch1, rb);
+
+		if(i == 1)
+			Benchmark::AddResult("ring_buffer<uint32_t>/operator[]", IX, stopwatch1);
+
+		TestPopFront(stopwatch1, rb);
+
+		if(i == 1)
+			Benchmark::AddResult("ring_buffer<uint32_t>/pop_front", IX, stopwatch1);
+
+		TestQueue(stopwatch1, rb, data, 64);
+
+		if(i == 1)
+			Benchmark::AddResult("ring_buffer<uint32_t>/queue depth 64", IX, stopwatch1);
+	}
+}
+
+template<class T>
+using EaDeque = eastl::deque<T>;
+
+template<class T>
+using UnsafeDeque = safememory::deque<T, safememory::memory_safety::none>;
+
+template<class T>
+using SafeDeque = safememory::deque<T, safememory::memory_safety::safe>;
+
+template<class T>
+using ReallySafeDeque = safememory::deque_safe<T, safememory::memory_safety::safe>;
+
+void BenchmarkDeque()
+{
+	EASTLTest_Printf("Deque\n");
+
+	BenchmarkDequeTempl<1, EaDeque>();
+	BenchmarkDequeTempl<2, UnsafeDeque>();
+	BenchmarkDequeTempl<3, SafeDeque>();
+	BenchmarkDequeTempl<4, ReallySafeDeque>();
+
+	EASTLTest_Printf("RingBuffer\n");
+
+	// there is no heap_safe wrapper of ring_buffer, only three columns
+	BenchmarkRingBufferTempl<1, eastl::ring_buffer<uint32_t>>();
+	BenchmarkRingBufferTempl<2, safememory::ring_buffer<uint32_t, safememory::memory_safety::none>>();
+	BenchmarkRingBufferTempl<3, safememory::ring_buffer<uint32_t, safememory::memory_safety::safe>>();
+}
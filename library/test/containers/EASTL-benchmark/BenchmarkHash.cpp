@@ -8,6 +8,7 @@
 #include "EAStopwatch.h"
 // #include <EASTL/vector.h>
 #include <safememory/unordered_map.h>
+#include <safememory/functional.h>
 #include <safememory/algorithm.h>
 #include <EASTL/unordered_map.h>
 #include <EASTL/vector.h>
@@ -268,6 +269,111 @@ namespace
 	}
 
 
+	template <typename Hasher, typename Key>
+	void TestHashThroughput(EA::StdC::Stopwatch& stopwatch, const Key* pArrayBegin, const Key* pArrayEnd)
+	{
+		Hasher h;
+		std::size_t temp = 0;
+		stopwatch.Restart();
+		for(int j = 0; j < 10; ++j)
+		{
+			for(const Key* p = pArrayBegin; p != pArrayEnd; ++p)
+				temp += h(*p);
+		}
+		stopwatch.Stop();
+		sprintf(Benchmark::gScratchBuffer, "%u", (unsigned)temp);
+	}
+
+
+	// Hashes keys into a power-of-two table, using the low bits as such tables do, and prints 
+	// the largest bucket and the share of empty ones. With as many keys as buckets, a uniform
+	// hash leaves about 36.8% of buckets empty and the largest one holds 7 or 8 keys.
+	template <typename Hasher, typename Key>
+	void PrintHashDistribution(const char* pName, const Key* pArrayBegin, const Key* pArrayEnd)
+	{
+		const std::size_t bucketCount = std::size_t(1) << 14;
+		eastl::vector<uint32_t> buckets(bucketCount, 0);
+
+		Hasher h;
+		for(const Key* p = pArrayBegin; p != pArrayEnd; ++p)
+			++buckets[h(*p) & (bucketCount - 1)];
+
+		uint32_t maxLoad = 0;
+		std::size_t empty = 0;
+		for(uint32_t each : buckets)
+		{
+			maxLoad = eastl::max(maxLoad, each);
+			empty += (each == 0);
+		}
+
+		EASTLTest_Printf("%-50s | max bucket %6u | empty %5.1f%%\n", pName, (unsigned)maxLoad, 100.0 * (double)empty / (double)bucketCount);
+	}
+
+
+
+	// Times each insert on its own, latencies are left sorted in pLatency.
+	// Rehash pauses are rare, so they show up in the tail and not in the total.
+	template <typename Container, typename Value>
+	void TestInsertLatency(EA::StdC::Stopwatch& stopwatch, Container& c, const Value* pArrayBegin, const Value* pArrayEnd, eastl::vector<uint64_t>& latency)
+	{
+		latency.clear();
+		latency.reserve(pArrayEnd - pArrayBegin);
+
+		stopwatch.Restart();
+		for(const Value* p = pArrayBegin; p != pArrayEnd; ++p)
+		{
+			const uint64_t nStart = EA::StdC::Stopwatch::GetStopwatchCycle();
+			c.insert(*p);
+			latency.push_back(EA::StdC::Stopwatch::GetStopwatchCycle() - nStart);
+		}
+		stopwatch.Stop();
+
+		std::sort(latency.begin(), latency.end());
+		sprintf(Benchmark::gScratchBuffer, "%u", (unsigned)c.size());
+	}
+
+	void SetLatency(EA::StdC::Stopwatch& stopwatch, const eastl::vector<uint64_t>& latency, double fPercentile)
+	{
+		const uint64_t nCycles = latency[std::size_t((latency.size() - 1) * fPercentile)];
+		stopwatch.SetElapsedTime(uint64_t(nCycles * EA::StdC::Stopwatch::GetUnitsPerStopwatchCycle((EA::StdC::Stopwatch::Units)stopwatch.GetUnits())));
+	}
+
+
+	template <typename Container, typename = void>
+	struct HasNodePool : std::false_type {};
+
+	template <typename Container>
+	struct HasNodePool<Container, std::void_t<decltype(std::declval<const Container&>().node_pool_size())>> : std::true_type {};
+
+	// Steady state churn, erases the oldest key and inserts a new one.
+	// Returns how many erased nodes went to the heap instead of the node pool.
+	template <typename Container, typename Value>
+	std::size_t TestChurn(EA::StdC::Stopwatch& stopwatch, Container& c, const Value* pArrayBegin, const Value* pArrayEnd, std::size_t nLive)
+	{
+		std::size_t nReleased = 0;
+
+		stopwatch.Restart();
+		for(const Value* p = pArrayBegin + nLive; p != pArrayEnd; ++p)
+		{
+			if constexpr(HasNodePool<Container>::value)
+			{
+				const auto nPooled = c.node_pool_size();
+				c.erase((p - nLive)->first);
+				nReleased += (c.node_pool_size() == nPooled);
+			}
+			else
+			{
+				c.erase((p - nLive)->first);
+				++nReleased;
+			}
+			c.insert(*p);
+		}
+		stopwatch.Stop();
+
+		sprintf(Benchmark::gScratchBuffer, "%u", (unsigned)c.size());
+		return nReleased;
+	}
+
 } // namespace
 
 
@@ -499,6 +605,376 @@ void BenchmarkHashTempl()
 	}
 }
 
+// Adapts a hashing policy to eastl::string, so every competitor hashes the same keys.
+template <typename Policy>
+struct PolicyStringHash
+{
+	std::size_t operator()(const eastl::string& s) const { return Policy::chars(s.data(), s.size()); }
+};
+
+template<int IX, typename IntHash, typename StrHash>
+void BenchmarkHashFunctionTempl()
+{
+	EA::StdC::Stopwatch stopwatch1(EA::StdC::Stopwatch::kUnitsCPUCycles);
+
+	const std::size_t sz = std::size_t(1) << 14;
+	eastl::vector<uint32_t> sequential(sz);
+	eastl::vector<uint32_t> strided(sz);
+	eastl::vector<eastl::string> shortStrings(sz);
+	eastl::vector<eastl::string> longStrings(sz / 16);
+
+	for(std::size_t i = 0; i != sz; ++i)
+	{
+		sequential[i] = uint32_t(i);
+		strided[i] = uint32_t(i * 4096);
+
+		char str[32];
+		sprintf(str, "id_%u", (unsigned)i);
+		shortStrings[i] = eastl::string(str);
+	}
+
+	for(std::size_t i = 0; i != longStrings.size(); ++i)
+	{
+		char str[32];
+		int len = sprintf(str, "%u", (unsigned)i);
+		longStrings[i].assign(1024, 'x');
+		longStrings[i].replace(0, len, str);
+	}
+
+	for(int i = 0; i < 2; i++)
+	{
+		///////////////////////////////
+		// Test hash throughput
+		///////////////////////////////
+
+		TestHashThroughput<IntHash>(stopwatch1, sequential.data(), sequential.data() + sequential.size());
+
+		if(i == 1)
+			Benchmark::AddResult("hash<uint32_t>/throughput", IX, stopwatch1);
+
+		TestHashThroughput<StrHash>(stopwatch1, shortStrings.data(), shortStrings.data() + shortStrings.size());
+
+		if(i == 1)
+			Benchmark::AddResult("hash<string>/throughput short", IX, stopwatch1);
+
+		TestHashThroughput<StrHash>(stopwatch1, longStrings.data(), longStrings.data() + longStrings.size());
+
+		if(i == 1)
+			Benchmark::AddResult("hash<string>/throughput 1024", IX, stopwatch1);
+
+
+		///////////////////////////////
+		// Test insert of strided keys, where distribution matters
+		///////////////////////////////
+
+		safememory::unordered_map<uint32_t, uint32_t, IntHash, eastl::equal_to<uint32_t>, safememory::memory_safety::none> stridedMap;
+
+		stopwatch1.Restart();
+		for(uint32_t each : strided)
+			stridedMap.insert(eastl::pair<const uint32_t, uint32_t>(each, each));
+		stopwatch1.Stop();
+
+		if(i == 1)
+			Benchmark::AddResult("hash<uint32_t>/insert strided", IX, stopwatch1);
+	}
+
+	///////////////////////////////
+	// Distribution quality
+	///////////////////////////////
+
+	char name[64];
+	sprintf(name, "hash #%d uint32_t sequential", IX);
+	PrintHashDistribution<IntHash>(name, sequential.data(), sequential.data() + sequential.size());
+	sprintf(name, "hash #%d uint32_t stride 4096", IX);
+	PrintHashDistribution<IntHash>(name, strided.data(), strided.data() + strided.size());
+	sprintf(name, "hash #%d string \"id_N\"", IX);
+	PrintHashDistribution<StrHash>(name, shortStrings.data(), shortStrings.data() + shortStrings.size());
+}
+
+// Same hash for all, so the difference is bucket count policy and
+// picking a bucket with modulo or with a mask.
+struct PrimeMixingHash : safememory::hash<uint32_t>
+{
+	typedef eastl::prime_rehash_policy rehash_policy;
+};
+
+template<int IX, typename Map, bool bReserve>
+void BenchmarkHashRehashTempl()
+{
+	EASTLTest_Rand  rng(GetRandSeed());
+	EA::StdC::Stopwatch stopwatch1(EA::StdC::Stopwatch::kUnitsCPUCycles);
+
+	// mb: 1M and not 10M entries, to keep whole benchmark run reasonable,
+	// table still doesn't fit in cache, and pauses grow linearly with size
+	const std::size_t sz = std::size_t(1) << 20;
+	eastl::vector<eastl::pair<uint32_t, uint32_t>> data(sz);
+	for(std::size_t i = 0; i != sz; ++i)
+		data[i] = eastl::pair<uint32_t, uint32_t>(rng.RandLimit(UINT32_MAX), uint32_t(i));
+
+	eastl::vector<uint64_t> latency;
+
+	for(int i = 0; i < 2; i++)
+	{
+		Map m;
+		if(bReserve)
+			m.reserve(sz);
+
+		///////////////////////////////
+		// Test insert latency
+		///////////////////////////////
+
+		TestInsertLatency(stopwatch1, m, data.data(), data.data() + data.size(), latency);
+
+		if(i == 1)
+			Benchmark::AddResult("unordered_map<uint32_t>/insert 1M", IX, stopwatch1);
+
+		SetLatency(stopwatch1, latency, 0.5);
+
+		if(i == 1)
+			Benchmark::AddResult("unordered_map<uint32_t>/insert 1M p50", IX, stopwatch1);
+
+		SetLatency(stopwatch1, latency, 0.99);
+
+		if(i == 1)
+			Benchmark::AddResult("unordered_map<uint32_t>/insert 1M p99", IX, stopwatch1);
+
+		SetLatency(stopwatch1, latency, 0.9999);
+
+		if(i == 1)
+			Benchmark::AddResult("unordered_map<uint32_t>/insert 1M p99.99", IX, stopwatch1);
+
+		SetLatency(stopwatch1, latency, 1.0);
+
+		if(i == 1)
+			Benchmark::AddResult("unordered_map<uint32_t>/insert 1M max", IX, stopwatch1);
+
+
+		///////////////////////////////
+		// Test find
+		///////////////////////////////
+
+		TestFind(stopwatch1, m, data.data(), data.data() + data.size());
+
+		if(i == 1)
+			Benchmark::AddResult("unordered_map<uint32_t>/find 1M", IX, stopwatch1);
+	}
+}
+
+template<int IX, typename Map>
+void BenchmarkHashNodePoolTempl(const char* pName)
+{
+	EA::StdC::Stopwatch stopwatch1(EA::StdC::Stopwatch::kUnitsCPUCycles);
+
+	// keys are distinct, multiplying by an odd number is a bijection on uint32_t
+	const std::size_t nLive = 1 << 16;
+	const std::size_t sz = std::size_t(1) << 20;
+	eastl::vector<eastl::pair<uint32_t, uint32_t>> data(sz);
+	for(std::size_t i = 0; i != sz; ++i)
+		data[i] = eastl::pair<uint32_t, uint32_t>(uint32_t(i) * 2654435761u, uint32_t(i));
+
+	for(int i = 0; i < 2; i++)
+	{
+		Map m;
+		for(std::size_t j = 0; j != nLive; ++j)
+			m.insert(data[j]);
+
+		///////////////////////////////
+		// Test erase / insert churn
+		///////////////////////////////
+
+		const std::size_t nReleased = TestChurn(stopwatch1, m, data.data(), data.data() + data.size(), nLive);
+
+		if(i == 1)
+		{
+			Benchmark::AddResult("unordered_map<uint32_t>/churn 1M", IX, stopwatch1);
+
+			// on safe containers each released node is zombie memory until collected
+			if(HasNodePool<Map>::value)
+				EASTLTest_Printf("%-50s | zombie bytes %10u\n", pName, (unsigned)(nReleased * sizeof(typename Map::node_type)));
+		}
+	}
+}
+
+// Result of insertion is discarded, only 'second' is used. On unordered_map_safe
+// a safe iterator hooks a soft_ptr on the node and the bucket array ControlBlock.
+template<int IX, typename Map, bool bStackOnly>
+void BenchmarkHashInsertReturnTempl()
+{
+	EA::StdC::Stopwatch stopwatch1(EA::StdC::Stopwatch::kUnitsCPUCycles);
+
+	const std::size_t sz = std::size_t(1) << 20;
+	eastl::vector<uint32_t> data(sz);
+	for(std::size_t i = 0; i != sz; ++i)
+		data[i] = uint32_t(i) * 2654435761u;
+
+	for(int i = 0; i < 2; i++)
+	{
+		Map m;
+		m.reserve(sz);
+
+		///////////////////////////////
+		// Test try_emplace
+		///////////////////////////////
+
+		std::size_t n = 0;
+		stopwatch1.Restart();
+		for(uint32_t each : data)
+		{
+			if constexpr(bStackOnly)
+				n += m.try_emplace_stack_only(each, each).second;
+			else
+				n += m.try_emplace(each, each).second;
+		}
+		stopwatch1.Stop();
+		sprintf(Benchmark::gScratchBuffer, "%u", (unsigned)n);
+
+		if(i == 1)
+			Benchmark::AddResult("unordered_map<uint32_t>/try_emplace 1M", IX, stopwatch1);
+
+		///////////////////////////////
+		// Test insert_or_assign on existing keys
+		///////////////////////////////
+
+		n = 0;
+		stopwatch1.Restart();
+		for(uint32_t each : data)
+		{
+			if constexpr(bStackOnly)
+				n += m.insert_or_assign_stack_only(each, each + 1).second;
+			else
+				n += m.insert_or_assign(each, each + 1).second;
+		}
+		stopwatch1.Stop();
+		sprintf(Benchmark::gScratchBuffer, "%u", (unsigned)n);
+
+		if(i == 1)
+			Benchmark::AddResult("unordered_map<uint32_t>/insert_or_assign 1M", IX, stopwatch1);
+	}
+}
+
+// Full table scan, summing the values with an iterator loop or with 'for_each'.
+template<int IX, typename Map, bool bForEach>
+void BenchmarkHashScanTempl()
+{
+	EA::StdC::Stopwatch stopwatch1(EA::StdC::Stopwatch::kUnitsCPUCycles);
+
+	const std::size_t sz = std::size_t(1) << 20;
+	Map m;
+	m.reserve(sz);
+	for(std::size_t i = 0; i != sz; ++i)
+		m.insert(eastl::make_pair(uint32_t(i) * 2654435761u, uint32_t(i)));
+
+	for(int i = 0; i < 2; i++)
+	{
+		uint64_t sum = 0;
+		stopwatch1.Restart();
+		for(int j = 0; j < 10; ++j)
+		{
+			if constexpr(bForEach)
+				m.for_each([&sum](const typename Map::value_type& v) { sum += v.second; });
+			else
+			{
+				for(auto it = m.begin(), itEnd = m.end(); it != itEnd; ++it)
+					sum += it->second;
+			}
+		}
+		stopwatch1.Stop();
+		sprintf(Benchmark::gScratchBuffer, "%u", (unsigned)sum);
+
+		if(i == 1)
+			Benchmark::AddResult("unordered_map<uint32_t>/scan 1M", IX, stopwatch1);
+	}
+}
+
+// find and operator[] on many empty and small tables, where per call checks weigh the most.
+template<int IX, typename Map>
+void BenchmarkHashSmallTempl()
+{
+	EA::StdC::Stopwatch stopwatch1(EA::StdC::Stopwatch::kUnitsCPUCycles);
+
+	const std::size_t nMaps = 1024;
+	const uint32_t nKeys = 8;
+
+	eastl::vector<Map> emptyMaps(nMaps);
+	eastl::vector<Map> smallMaps(nMaps);
+	for(auto& m : smallMaps)
+	{
+		for(uint32_t k = 0; k != nKeys; k += 2)
+			m.insert(eastl::make_pair(k, k + 1));
+	}
+
+	for(int i = 0; i < 2; i++)
+	{
+		///////////////////////////////
+		// Test find on empty tables
+		///////////////////////////////
+
+		uint64_t sum = 0;
+		stopwatch1.Restart();
+		for(int j = 0; j < 64; ++j)
+		{
+			for(const auto& m : emptyMaps)
+			{
+				for(uint32_t k = 0; k != nKeys; ++k)
+				{
+					auto it = m.find(k);
+					if(it != m.end())
+						sum += it->second;
+				}
+			}
+		}
+		stopwatch1.Stop();
+		sprintf(Benchmark::gScratchBuffer, "%u", (unsigned)sum);
+
+		if(i == 1)
+			Benchmark::AddResult("unordered_map<uint32_t>/find empty", IX, stopwatch1);
+
+		///////////////////////////////
+		// Test find on small tables, half of them hit
+		///////////////////////////////
+
+		sum = 0;
+		stopwatch1.Restart();
+		for(int j = 0; j < 64; ++j)
+		{
+			for(const auto& m : smallMaps)
+			{
+				for(uint32_t k = 0; k != nKeys; ++k)
+				{
+					auto it = m.find(k);
+					if(it != m.end())
+						sum += it->second;
+				}
+			}
+		}
+		stopwatch1.Stop();
+		sprintf(Benchmark::gScratchBuffer, "%u", (unsigned)sum);
+
+		if(i == 1)
+			Benchmark::AddResult("unordered_map<uint32_t>/find small", IX, stopwatch1);
+
+		///////////////////////////////
+		// Test operator[] on small tables, existing keys
+		///////////////////////////////
+
+		sum = 0;
+		stopwatch1.Restart();
+		for(int j = 0; j < 64; ++j)
+		{
+			for(auto& m : smallMaps)
+			{
+				for(uint32_t k = 0; k != nKeys; k += 2)
+					sum += m[k];
+			}
+		}
+		stopwatch1.Stop();
+		sprintf(Benchmark::gScratchBuffer, "%u", (unsigned)sum);
+
+		if(i == 1)
+			Benchmark::AddResult("unordered_map<uint32_t>/operator[] small", IX, stopwatch1);
+	}
+}
+
 template<class K, class V>
 using StdMap1 = std::unordered_map<K, V>;
 
@@ -538,5 +1014,65 @@ void BenchmarkHash()
 	BenchmarkHashTempl<2, UnsafeMap1, UnsafeMap2>();
 	BenchmarkHashTempl<3, SafeMap1, SafeMap2>();
 	BenchmarkHashTempl<4, ReallySafeMap1, ReallySafeMap2>();
+
+	EASTLTest_Printf("HashFunction\n");
+
+	BenchmarkHashFunctionTempl<1, eastl::hash<uint32_t>, eastl::hash<eastl::string>>();
+	BenchmarkHashFunctionTempl<2, safememory::hash<uint32_t, safememory::identity_hash_policy>, PolicyStringHash<safememory::identity_hash_policy>>();
+	BenchmarkHashFunctionTempl<3, safememory::hash<uint32_t, safememory::mixing_hash_policy>, PolicyStringHash<safememory::mixing_hash_policy>>();
+	BenchmarkHashFunctionTempl<4, safememory::hash<uint32_t>, PolicyStringHash<safememory::default_hash_policy>>();
+
+	EASTLTest_Printf("HashRehash\n");
+
+	// columns are eastl prime buckets, prime buckets, power-of-two buckets, and power-of-two buckets reserved up front
+	typedef safememory::unordered_map<uint32_t, uint32_t, PrimeMixingHash, eastl::equal_to<uint32_t>, safememory::memory_safety::none> PrimeMap;
+	typedef safememory::unordered_map<uint32_t, uint32_t, safememory::hash<uint32_t>, eastl::equal_to<uint32_t>, safememory::memory_safety::none> Pow2Map;
+
+	BenchmarkHashRehashTempl<1, eastl::unordered_map<uint32_t, uint32_t, safememory::hash<uint32_t>>, false>();
+	BenchmarkHashRehashTempl<2, PrimeMap, false>();
+	BenchmarkHashRehashTempl<3, Pow2Map, false>();
+	BenchmarkHashRehashTempl<4, Pow2Map, true>();
+
+	EASTLTest_Printf("HashNodePool\n");
+
+	// columns are eastl, safe without node pool, safe with node pool, and heap_safe with node pool
+	typedef safememory::unordered_map<uint32_t, uint32_t, safememory::hash<uint32_t>, eastl::equal_to<uint32_t>, safememory::memory_safety::safe> SafeMap;
+	typedef safememory::unordered_map_safe<uint32_t, uint32_t, safememory::hash<uint32_t>, eastl::equal_to<uint32_t>, safememory::memory_safety::safe> ReallySafeMap;
+
+	struct SafeMapNoPool : SafeMap
+	{
+		SafeMapNoPool() { this->node_pool_capacity(0); }
+	};
+
+	BenchmarkHashNodePoolTempl<1, eastl::unordered_map<uint32_t, uint32_t, safememory::hash<uint32_t>>>(nullptr);
+	BenchmarkHashNodePoolTempl<2, SafeMapNoPool>("safememory::unordered_map, no node pool");
+	BenchmarkHashNodePoolTempl<3, SafeMap>("safememory::unordered_map");
+	BenchmarkHashNodePoolTempl<4, ReallySafeMap>("safememory::unordered_map_safe");
+
+	EASTLTest_Printf("HashInsertReturn\n");
+
+	// columns are eastl, regular iterator, unordered_map_safe '_stack_only' variants, and unordered_map_safe safe iterator
+	BenchmarkHashInsertReturnTempl<1, eastl::unordered_map<uint32_t, uint32_t, safememory::hash<uint32_t>>, false>();
+	BenchmarkHashInsertReturnTempl<2, SafeMap, false>();
+	BenchmarkHashInsertReturnTempl<3, ReallySafeMap, true>();
+	BenchmarkHashInsertReturnTempl<4, ReallySafeMap, false>();
+
+	EASTLTest_Printf("HashScan\n");
+
+	// columns are eastl iterator loop, regular iterator loop, 'for_each', and unordered_map_safe safe iterator loop
+	BenchmarkHashScanTempl<1, eastl::unordered_map<uint32_t, uint32_t, safememory::hash<uint32_t>>, false>();
+	BenchmarkHashScanTempl<2, SafeMap, false>();
+	BenchmarkHashScanTempl<3, SafeMap, true>();
+	BenchmarkHashScanTempl<4, ReallySafeMap, false>();
+
+	EASTLTest_Printf("HashSmall\n");
+
+	// columns are eastl, memory_safety::none, memory_safety::safe, and unordered_map_safe
+	typedef safememory::unordered_map<uint32_t, uint32_t, safememory::hash<uint32_t>, eastl::equal_to<uint32_t>, safememory::memory_safety::none> UnsafeMap;
+
+	BenchmarkHashSmallTempl<1, eastl::unordered_map<uint32_t, uint32_t, safememory::hash<uint32_t>>>();
+	BenchmarkHashSmallTempl<2, UnsafeMap>();
+	BenchmarkHashSmallTempl<3, SafeMap>();
+	BenchmarkHashSmallTempl<4, ReallySafeMap>();
 }
 
@@ -0,0 +1,219 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+
+#include "EASTLBenchmark.h"
+#include "EASTLTest.h"
+#include "EAStopwatch.h"
+#include <safememory/map.h>
+#include <EASTL/vector.h>
+
+
+
+EA_DISABLE_ALL_VC_WARNINGS()
+#include <map>
+#include <stdio.h>
+EA_RESTORE_ALL_VC_WARNINGS()
+
+
+
+using namespace EA;
+
+
+namespace
+{
+	template <typename ValueType, typename Container, typename Container2>
+	void TestInsert(EA::StdC::Stopwatch& stopwatch, Container& c, const Container2& c2)
+	{
+		stopwatch.Restart();
+		for(auto& Each : c2)
+			c.insert(ValueType(Each.first, Each.second));
+		stopwatch.Stop();
+	}
+
+	template <typename Container>
+	void TestIteration(EA::StdC::Stopwatch& stopwatch, const Container& c)
+	{
+		uint64_t temp = 0;
+		stopwatch.Restart();
+		for(auto it = c.begin(); it != c.end(); ++it)
+			temp += it->second;
+		stopwatch.Stop();
+		sprintf(Benchmark::gScratchBuffer, "%u", (unsigned)temp);
+	}
+
+	template <typename Container, typename Value>
+	void TestFind(EA::StdC::Stopwatch& stopwatch, Container& c, const Value* pArrayBegin, const Value* pArrayEnd)
+	{
+		stopwatch.Restart();
+		while(pArrayBegin != pArrayEnd)
+		{
+			typename Container::iterator it = c.find(pArrayBegin->first);
+			Benchmark::DoNothing(&it);
+			++pArrayBegin;
+		}
+		stopwatch.Stop();
+	}
+
+	// The use case ordered containers are wanted for: take all entries in a window of keys,
+	// i.e. events between two timestamps.
+	template <typename Container, typename Value>
+	void TestRangeScan(EA::StdC::Stopwatch& stopwatch, const Container& c, const Value* pArrayBegin, const Value* pArrayEnd, uint32_t window)
+	{
+		uint64_t temp = 0;
+		stopwatch.Restart();
+		while(pArrayBegin != pArrayEnd)
+		{
+			auto it = c.lower_bound(pArrayBegin->first);
+			auto last = c.upper_bound(pArrayBegin->first + window);
+			for(; it != last; ++it)
+				temp += it->second;
+			++pArrayBegin;
+		}
+		stopwatch.Stop();
+		sprintf(Benchmark::gScratchBuffer, "%u", (unsigned)temp);
+	}
+
+	template <typename Container, typename Value>
+	void TestEraseValue(EA::StdC::Stopwatch& stopwatch, Container& c, const Value* pArrayBegin, const Value* pArrayEnd)
+	{
+		stopwatch.Restart();
+		while(pArrayBegin != pArrayEnd)
+		{
+			c.erase(pArrayBegin->first);
+			++pArrayBegin;
+		}
+		stopwatch.Stop();
+		sprintf(Benchmark::gScratchBuffer, "%u", (unsigned)c.size());
+	}
+
+	template <typename Container>
+	void TestClear(EA::StdC::Stopwatch& stopwatch, Container& c)
+	{
+		stopwatch.Restart();
+		c.clear();
+		stopwatch.Stop();
+		sprintf(Benchmark::gScratchBuffer, "%u", (unsigned)c.size());
+	}
+
+} // namespace
+
+
+template<int IX, template<typename, typename> typename Map>
+void BenchmarkMapTempl()
+{
+	EASTLTest_Rand  rng(GetRandSeed());
+	EA::StdC::Stopwatch stopwatch1(EA::StdC::Stopwatch::kUnitsCPUCycles);
+
+	std::size_t sz = 10000;
+	eastl::vector<uint32_t> baseData(sz);
+	for(std::size_t i = 0; i != sz; ++i) {
+		baseData[i] = i;
+	}
+
+	for(std::size_t i = sz - 1; i > 0; --i) {
+		std::size_t j = rng.RandLimit(i + 1);
+		eastl::swap(baseData[i], baseData[j]);
+	}
+
+	eastl::vector<eastl::pair<uint32_t, uint32_t>> stdVectorUT(sz);
+	for(std::size_t i = 0; i != sz; ++i)
+		stdVectorUT[i] = eastl::pair<uint32_t, uint32_t>(baseData[i], baseData[baseData[i]]);
+
+	for(int i = 0; i < 2; i++)
+	{
+		Map<uint32_t, uint32_t> mapUint32TO;
+
+		typedef typename Map<uint32_t, uint32_t>::value_type Vt1;
+
+		///////////////////////////////
+		// Test insert(const value_type&)
+		///////////////////////////////
+
+		TestInsert<Vt1>(stopwatch1, mapUint32TO, stdVectorUT);
+
+		if(i == 1)
+			Benchmark::AddResult("map<uint32_t, uint32_t>/insert", IX, stopwatch1);
+
+
+		///////////////////////////////
+		// Test iteration
+		///////////////////////////////
+
+		TestIteration(stopwatch1, mapUint32TO);
+
+		if(i == 1)
+			Benchmark::AddResult("map<uint32_t, uint32_t>/iteration", IX, stopwatch1);
+
+
+		///////////////////////////////
+		// Test find
+		///////////////////////////////
+
+		TestFind(stopwatch1, mapUint32TO, stdVectorUT.data(), stdVectorUT.data() + stdVectorUT.size());
+
+		if(i == 1)
+			Benchmark::AddResult("map<uint32_t, uint32_t>/find", IX, stopwatch1);
+
+
+		///////////////////////////////
+		// Test lower_bound/upper_bound range scans
+		///////////////////////////////
+
+		TestRangeScan(stopwatch1, mapUint32TO, stdVectorUT.data(), stdVectorUT.data() + stdVectorUT.size() / 10, 16);
+
+		if(i == 1)
+			Benchmark::AddResult("map<uint32_t, uint32_t>/range scan 16", IX, stopwatch1);
+
+		TestRangeScan(stopwatch1, mapUint32TO, stdVectorUT.data(), stdVectorUT.data() + stdVectorUT.size() / 100, 1000);
+
+		if(i == 1)
+			Benchmark::AddResult("map<uint32_t, uint32_t>/range scan 1000", IX, stopwatch1);
+
+
+		///////////////////////////////
+		// Test erase(const key_type& key)
+		///////////////////////////////
+
+		TestEraseValue(stopwatch1, mapUint32TO, stdVectorUT.data(), stdVectorUT.data() + (stdVectorUT.size() / 2));
+
+		if(i == 1)
+			Benchmark::AddResult("map<uint32_t, uint32_t>/erase val", IX, stopwatch1);
+
+
+		///////////////////////////////
+		// Test clear()
+		///////////////////////////////
+
+		TestClear(stopwatch1, mapUint32TO);
+		TestInsert<Vt1>(stopwatch1, mapUint32TO, stdVectorUT);
+		TestClear(stopwatch1, mapUint32TO);
+
+		if(i == 1)
+			Benchmark::AddResult("map<uint32_t, uint32_t>/clear", IX, stopwatch1);
+	}
+}
+
+template<class K, class V>
+using StdMap = std::map<K, V>;
+
+template<class K, class V>
+using UnsafeMap = safememory::map<K, V, safememory::less<K>, safememory::memory_safety::none>;
+
+template<class K, class V>
+using SafeMap = safememory::map<K, V, safememory::less<K>, safememory::memory_safety::safe>;
+
+template<class K, class V>
+using ReallySafeMap = safememory::map_safe<K, V, safememory::less<K>, safememory::memory_safety::safe>;
+
+void BenchmarkMap()
+{
+	EASTLTest_Printf("Map\n");
+
+	// first column is std::map here, as the b-tree is meant to compete with it and not with eastl::map
+	BenchmarkMapTempl<1, StdMap>();
+	BenchmarkMapTempl<2, UnsafeMap>();
+	BenchmarkMapTempl<3, SafeMap>();
+	BenchmarkMapTempl<4, ReallySafeMap>();
+}
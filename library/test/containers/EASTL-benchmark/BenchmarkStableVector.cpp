@@ -0,0 +1,161 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+
+#include "EASTLBenchmark.h"
+#include "EASTLTest.h"
+#include "EAStopwatch.h"
+#include <safememory/stable_vector.h>
+#include <safememory/vector.h>
+#include <EASTL/vector.h>
+#include <EASTL/unique_ptr.h>
+
+
+
+EA_DISABLE_ALL_VC_WARNINGS()
+#include <stdio.h>
+EA_RESTORE_ALL_VC_WARNINGS()
+
+
+
+using namespace EA;
+
+
+namespace
+{
+	// Long lived references to elements of a growing collection, a handle for stable_vector,
+	// a soft_ptr for vector<owning_ptr>. Column 1 are the unchecked eastl equivalents,
+	// an index into a vector of values and a raw pointer into a vector of unique_ptr.
+
+	template <typename T, safememory::memory_safety S>
+	safememory::stable_vector_handle AddElement(safememory::stable_vector<T, S>& c, uint32_t x) { return c.insert(x); }
+
+	template <typename Ptr, safememory::memory_safety S>
+	safememory::soft_ptr<uint32_t, S> AddElement(safememory::vector<Ptr, S>& c, uint32_t x)
+	{
+		c.push_back(safememory::make_owning_2<uint32_t, S>(x));
+		return c.back();
+	}
+
+	uint32_t AddElement(eastl::vector<uint32_t>& c, uint32_t x) { c.push_back(x); return (uint32_t)c.size() - 1; }
+
+	uint32_t* AddElement(eastl::vector<eastl::unique_ptr<uint32_t>>& c, uint32_t x)
+	{
+		c.push_back(eastl::unique_ptr<uint32_t>(new uint32_t(x)));
+		return c.back().get();
+	}
+
+	template <typename T, safememory::memory_safety S>
+	uint32_t GetElement(const safememory::stable_vector<T, S>& c, safememory::stable_vector_handle h) { return c[h]; }
+
+	template <typename Container, typename Ptr>
+	uint32_t GetElement(const Container&, const Ptr& p) { return *p; }
+
+	uint32_t GetElement(const eastl::vector<uint32_t>& c, uint32_t index) { return c[index]; }
+
+	uint32_t GetValue(uint32_t x) { return x; }
+
+	template <typename Ptr>
+	uint32_t GetValue(const Ptr& p) { return *p; }
+
+
+	template <typename Container, typename Refs>
+	void TestInsert(EA::StdC::Stopwatch& stopwatch, Container& c, Refs& refs, const eastl::vector<uint32_t>& v)
+	{
+		stopwatch.Restart();
+		for(uint32_t each : v)
+			refs.push_back(AddElement(c, each));
+		stopwatch.Stop();
+		sprintf(Benchmark::gScratchBuffer, "%u", (unsigned)c.size());
+	}
+
+	template <typename Container, typename Refs>
+	void TestLookup(EA::StdC::Stopwatch& stopwatch, const Container& c, const Refs& refs, const eastl::vector<uint32_t>& order)
+	{
+		uint64_t temp = 0;
+		stopwatch.Restart();
+		for(uint32_t each : order)
+			temp += GetElement(c, refs[each]);
+		stopwatch.Stop();
+		sprintf(Benchmark::gScratchBuffer, "%u", (unsigned)temp);
+	}
+
+	template <typename Container>
+	void TestIteration(EA::StdC::Stopwatch& stopwatch, const Container& c)
+	{
+		uint64_t temp = 0;
+		stopwatch.Restart();
+		for(auto it = c.begin(); it != c.end(); ++it)
+			temp += GetValue(*it);
+		stopwatch.Stop();
+		sprintf(Benchmark::gScratchBuffer, "%u", (unsigned)temp);
+	}
+
+} // namespace
+
+
+template<int IX, typename Container, typename Ref>
+void BenchmarkStableRefsTempl(const char* insertName, const char* lookupName, const char* iterationName)
+{
+	EASTLTest_Rand  rng(GetRandSeed());
+	EA::StdC::Stopwatch stopwatch1(EA::StdC::Stopwatch::kUnitsCPUCycles);
+
+	eastl::vector<uint32_t> data(100000);
+	eastl::vector<uint32_t> order(data.size());
+	for(std::size_t i = 0; i != data.size(); ++i)
+	{
+		data[i] = rng.RandLimit(10000);
+		order[i] = rng.RandLimit((uint32_t)data.size());
+	}
+
+	for(int i = 0; i < 2; i++)
+	{
+		Container c;
+		eastl::vector<Ref> refs;
+
+		TestInsert(stopwatch1, c, refs, data);
+
+		if(i == 1)
+			Benchmark::AddResult(insertName, IX, stopwatch1);
+
+		TestLookup(stopwatch1, c, refs, order);
+
+		if(i == 1)
+			Benchmark::AddResult(lookupName, IX, stopwatch1);
+
+		TestIteration(stopwatch1, c);
+
+		if(i == 1)
+			Benchmark::AddResult(iterationName, IX, stopwatch1);
+	}
+}
+
+template<int IX, safememory::memory_safety S>
+void BenchmarkStableVectorTempl()
+{
+	BenchmarkStableRefsTempl<IX, safememory::stable_vector<uint32_t, S>, safememory::stable_vector_handle>(
+		"stable_vector<uint32_t>/insert", "stable_vector<uint32_t>/lookup", "stable_vector<uint32_t>/iteration");
+}
+
+template<int IX, safememory::memory_safety S>
+void BenchmarkOwningVectorTempl()
+{
+	BenchmarkStableRefsTempl<IX, safememory::vector<safememory::owning_ptr<uint32_t, S>, S>, safememory::soft_ptr<uint32_t, S>>(
+		"vector<owning_ptr<uint32_t>>/insert", "vector<owning_ptr<uint32_t>>/lookup", "vector<owning_ptr<uint32_t>>/iteration");
+}
+
+void BenchmarkStableVector()
+{
+	EASTLTest_Printf("StableVector\n");
+
+	BenchmarkStableRefsTempl<1, eastl::vector<uint32_t>, uint32_t>(
+		"stable_vector<uint32_t>/insert", "stable_vector<uint32_t>/lookup", "stable_vector<uint32_t>/iteration");
+	BenchmarkStableVectorTempl<2, safememory::memory_safety::none>();
+	BenchmarkStableVectorTempl<3, safememory::memory_safety::safe>();
+
+	BenchmarkStableRefsTempl<1, eastl::vector<eastl::unique_ptr<uint32_t>>, uint32_t*>(
+		"vector<owning_ptr<uint32_t>>/insert", "vector<owning_ptr<uint32_t>>/lookup", "vector<owning_ptr<uint32_t>>/iteration");
+	BenchmarkOwningVectorTempl<2, safememory::memory_safety::none>();
+	BenchmarkOwningVectorTempl<3, safememory::memory_safety::safe>();
+}
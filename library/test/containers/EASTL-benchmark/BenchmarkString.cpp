@@ -9,13 +9,18 @@
 #include <algorithm>
 #include <string>
 #include <safememory/string.h>
+#include <safememory/string_view.h>
+#include <safememory/string_format.h>
+#include <safememory/literal_switch.h>
 #include <EASTL/string.h>
+#include <EASTL/vector.h>
 
 EA_DISABLE_ALL_VC_WARNINGS()
 #include <algorithm>
 #include <string>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 EA_RESTORE_ALL_VC_WARNINGS()
 
 // namespace safememory {
@@ -43,6 +48,19 @@ namespace
 	}
 
 
+	// Many short appends to an initially empty string, time is dominated by reallocations
+	template <typename Container>
+	void TestAppendN(EA::StdC::Stopwatch& stopwatch, Container& c, size_t n)
+	{
+		const typename Container::value_type p[] = { 'a', 'b', 'c', 'd', 'e', 'f', 'g', 0 };
+
+		stopwatch.Restart();
+		while(c.size() < n)
+			c.append(p);
+		stopwatch.Stop();
+	}
+
+
 	template <typename Container> 
 	void TestInsert1(EA::StdC::Stopwatch& stopwatch, Container& c, Container& p)
 	{
@@ -110,6 +128,23 @@ namespace
 	}
 
 
+	// Tight loop that is vectorized when the iterator is a raw pointer,
+	// repeated to measure iterator overhead and not memory bandwidth
+	template <typename Container>
+	void TestIterationSum(EA::StdC::Stopwatch& stopwatch, const Container& c)
+	{
+		uint32_t temp = 0;
+		stopwatch.Restart();
+		for(int j = 0; j < 100; j++)
+		{
+			for(auto it = c.begin(), itEnd = c.end(); it != itEnd; ++it)
+				temp += (uint32_t)*it;
+		}
+		stopwatch.Stop();
+		sprintf(Benchmark::gScratchBuffer, "%u", (unsigned)temp);
+	}
+
+
 	template <typename Container>
 	void TestFind(EA::StdC::Stopwatch& stopwatch, Container& c)
 	{
@@ -198,6 +233,245 @@ namespace
 		stopwatch.Stop();
 	}
 
+
+	bool IsJsonSpace(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+	bool IsJsonNum(char c) { return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E'; }
+	bool IsJsonWord(char c) { return c >= 'a' && c <= 'z'; }
+
+
+	// A JSON tokenizer, scanning char by char with iterators
+	template <typename It>
+	uint32_t TokenizeJsonIt(It it, It end)
+	{
+		uint32_t tokens = 0;
+		while(it != end)
+		{
+			char c = *it;
+			if(IsJsonSpace(c))
+			{
+				++it;
+				continue;
+			}
+
+			++it;
+			if(c == '"')
+			{
+				while(it != end && *it != '"')
+					++it;
+				if(it != end)
+					++it;
+			}
+			else if(IsJsonNum(c))
+			{
+				while(it != end && IsJsonNum(*it))
+					++it;
+			}
+			else if(IsJsonWord(c))
+			{
+				while(it != end && IsJsonWord(*it))
+					++it;
+			}
+			++tokens;
+		}
+		return tokens;
+	}
+
+
+	// Same tokenizer, but a whole token is taken with a single call to the view
+	template <typename View>
+	uint32_t TokenizeJsonView(View v)
+	{
+		uint32_t tokens = 0;
+		while(true)
+		{
+			auto pos = v.find_if_not(IsJsonSpace);
+			if(pos == View::npos)
+				break;
+			v.remove_prefix(pos);
+
+			char c = v.front();
+			if(c == '"')
+			{
+				pos = v.find('"', 1);
+				pos = pos == View::npos ? v.size() : pos + 1;
+			}
+			else if(IsJsonNum(c))
+				pos = v.find_if_not(IsJsonNum, 1);
+			else if(IsJsonWord(c))
+				pos = v.find_if_not(IsJsonWord, 1);
+			else
+				pos = 1;
+
+			v.remove_prefix(pos == View::npos ? v.size() : pos);
+			++tokens;
+		}
+		return tokens;
+	}
+
+
+	const eastl::string& GetJsonText()
+	{
+		static eastl::string text;
+		if(text.empty())
+		{
+			EASTLTest_Rand rng(GetRandSeed());
+			text += "[\n";
+			for(int i = 0; i < 2000; i++)
+			{
+				text.append_sprintf("  {\"id\": %u, \"name\": \"item%u\", \"price\": -%u.%u, ",
+					rng.RandLimit(100000), rng.RandLimit(1000), rng.RandLimit(1000), rng.RandLimit(100));
+				text += "\"tags\": [true, false, null], \"ref\": {\"a\": 1, \"b\": \"\"}},\n";
+			}
+			text += "  {}\n]\n";
+		}
+		return text;
+	}
+
+	void AssignJsonText(eastl::string& str) { str = GetJsonText(); }
+
+	template <typename S>
+	void AssignJsonText(S& str) { str.assign_unsafe(GetJsonText().c_str()); }
+
+
+	void AssignText(eastl::string& str, const char* text) { str = text; }
+
+	template <typename S>
+	void AssignText(S& str, const char* text) { str.assign_unsafe(text); }
+
+	template <typename S>
+	auto BeginSafe(S& str) { return str.begin_safe(); }
+
+	template <typename S>
+	auto EndSafe(S& str) { return str.end_safe(); }
+
+	auto BeginSafe(eastl::string& str) { return str.begin(); }
+	auto EndSafe(eastl::string& str) { return str.end(); }
+
+
+	// Serialization of metrics, as "name=value;" pairs
+	template <typename S, typename V>
+	void AppendMetric(S& str, const char* name, V value)
+	{
+		str.append_unsafe(name, name + strlen(name));
+		str.append(1, '=');
+		str.append_number(value);
+		str.append(1, ';');
+	}
+
+	template <typename V>
+	void AppendMetric(eastl::string& str, const char* name, V value)
+	{
+		str.append(name);
+		if constexpr(std::is_floating_point_v<V>)
+			str.append_sprintf("=%.17g;", value);
+		else
+			str.append_sprintf("=%d;", value);
+	}
+
+	uint32_t ParseInt(const eastl::string& str)
+	{
+		uint32_t sum = 0;
+		const char* p = str.c_str();
+		while(*p)
+		{
+			char* end;
+			sum += (uint32_t)strtol(p, &end, 10);
+			p = end + 1;
+		}
+		return sum;
+	}
+
+	template <typename View>
+	uint32_t ParseInt(View v)
+	{
+		uint32_t sum = 0;
+		while(!v.empty())
+		{
+			int value = 0;
+			auto r = safememory::from_chars(v, value);
+			sum += (uint32_t)value;
+			v.remove_prefix(r.count + 1 < v.size() ? r.count + 1 : v.size());
+		}
+		return sum;
+	}
+
+
+	// A typical log line, eastl::string goes through a temporary std::string from fmt::format
+	const char* const kLogLevel[] = {"debug", "info", "warning", "error"};
+
+	void FormatLogLine(eastl::string& str, uint32_t i)
+	{
+		std::string tmp = fmt::format("[{}] {:<7} GET /api/items/{} from {}.{}.{}.{}:{} took {:.3f}ms status={}\n",
+			1600000000u + i, kLogLevel[i % 4], i * 7, 10, i % 256, (i / 256) % 256, 1, 40000 + i % 1000, i / 1000.0, 200);
+		str.append(tmp.data(), tmp.size());
+	}
+
+	template <typename S>
+	void FormatLogLine(S& str, uint32_t i)
+	{
+		safememory::format_to(str, "[{}] {:<7} GET /api/items/{} from {}.{}.{}.{}:{} took {:.3f}ms status={}\n",
+			1600000000u + i, kLogLevel[i % 4], i * 7, 10, i % 256, (i / 256) % 256, 1, 40000 + i % 1000, i / 1000.0, 200);
+	}
+
+
+	// Protocol dispatch over header names
+	#define HEADER_NAMES(X) X("host") X("accept") X("accept-encoding") X("accept-language") X("authorization") \
+		X("cache-control") X("connection") X("content-length") X("content-type") X("cookie") X("date") X("etag") \
+		X("expect") X("if-match") X("if-modified-since") X("if-none-match") X("origin") X("pragma") X("range") \
+		X("referer") X("transfer-encoding") X("upgrade") X("user-agent") X("via")
+
+	const char* const kHeaderNames[] = {
+	#define HEADER_NAME_STR(s) s,
+		HEADER_NAMES(HEADER_NAME_STR)
+		"x-request-id", "x-forwarded-for"
+	};
+
+	template <size_t N>
+	bool HeaderEquals(const eastl::string& name, const char (&lit)[N])
+	{
+		return eastl::string_view(name.data(), name.size()) == eastl::string_view(lit, N - 1);
+	}
+
+	template <typename S, size_t N>
+	bool HeaderEquals(const S& name, const char (&lit)[N])
+	{
+		return name == safememory::string_literal(lit);
+	}
+
+	template <typename S>
+	uint32_t DispatchLinear(const S& name)
+	{
+		// a chain of comparisons, as written by hand
+		uint32_t ix = 0;
+	#define HEADER_NAME_CMP(s) if(HeaderEquals(name, s)) return ix; ++ix;
+		HEADER_NAMES(HEADER_NAME_CMP)
+		return ix;
+	}
+
+	template <typename S>
+	uint32_t DispatchSwitch(const S& name)
+	{
+		using namespace safememory::literals;
+		static constexpr auto sw = safememory::make_literal_switch("host"_lit, "accept"_lit, "accept-encoding"_lit,
+			"accept-language"_lit, "authorization"_lit, "cache-control"_lit, "connection"_lit, "content-length"_lit,
+			"content-type"_lit, "cookie"_lit, "date"_lit, "etag"_lit, "expect"_lit, "if-match"_lit,
+			"if-modified-since"_lit, "if-none-match"_lit, "origin"_lit, "pragma"_lit, "range"_lit, "referer"_lit,
+			"transfer-encoding"_lit, "upgrade"_lit, "user-agent"_lit, "via"_lit);
+		return static_cast<uint32_t>(sw.find(name));
+	}
+
+
+	// A parsed request, with short header values that fit in SSO
+	template <typename S>
+	struct HeaderField
+	{
+		S name;
+		S value;
+	};
+
+	const char* const kHeaderText[] = {"Host", "localhost", "Accept", "text/html", "Connection", "keep-alive",
+		"Accept-Encoding", "gzip", "Content-Length", "1024", "Cache-Control", "no-cache"};
+
 } // namespace
 
 template<int IX, class S8, class S16>
@@ -224,6 +498,12 @@ void BenchmarkStringTempl()
 		if(i == 1)
 			Benchmark::AddResult("string<char16_t>/push_back", IX, stopwatch1);
 
+		S8 bigs8;
+		TestAppendN(stopwatch1, bigs8, 10000000);
+
+		if(i == 1)
+			Benchmark::AddResult("string<char8_t>/append 10M", IX, stopwatch1);
+
 
 		///////////////////////////////
 		// Test insert(size_type position, const value_type* p)
@@ -335,6 +615,11 @@ void BenchmarkStringTempl()
 		if(i == 1)
 			Benchmark::AddResult("string<char16_t>/iteration", IX, stopwatch1);
 
+		TestIterationSum(stopwatch1, stds8);
+
+		if(i == 1)
+			Benchmark::AddResult("string<char8_t>/iteration sum", IX, stopwatch1);
+
 
 		///////////////////////////////
 		// Test find(const basic_string& str, size_type position)
@@ -476,6 +761,220 @@ void BenchmarkStringTempl()
 }
 
 
+template<int IX, class S, bool AsView = false>
+void BenchmarkJsonTempl()
+{
+	Stopwatch stopwatch1(Stopwatch::kUnitsCPUCycles);
+
+	S str;
+	AssignJsonText(str);
+
+	for(int i = 0; i < 2; i++)
+	{
+		stopwatch1.Restart();
+		uint32_t tokens = TokenizeJsonIt(str.begin(), str.end());
+		stopwatch1.Stop();
+		sprintf(Benchmark::gScratchBuffer, "%u", (unsigned)tokens);
+
+		if(i == 1)
+			Benchmark::AddResult(AsView ? "string<char>/json tokenize view" : "string<char>/json tokenize iterators", IX, stopwatch1);
+	}
+}
+
+
+template<int IX, class View, class S>
+void BenchmarkJsonViewTempl()
+{
+	Stopwatch stopwatch1(Stopwatch::kUnitsCPUCycles);
+
+	S str;
+	AssignJsonText(str);
+
+	for(int i = 0; i < 2; i++)
+	{
+		stopwatch1.Restart();
+		uint32_t tokens = TokenizeJsonView(View(str));
+		stopwatch1.Stop();
+		sprintf(Benchmark::gScratchBuffer, "%u", (unsigned)tokens);
+
+		if(i == 1)
+			Benchmark::AddResult("string<char>/json tokenize view", IX, stopwatch1);
+	}
+}
+
+
+template<int IX, class S, class View = void>
+void BenchmarkNumberTempl()
+{
+	EASTLTest_Rand rng(GetRandSeed());
+	Stopwatch stopwatch1(Stopwatch::kUnitsCPUCycles);
+
+	eastl::vector<int> ints(10000);
+	eastl::vector<double> doubles(10000);
+	for(size_t i = 0; i != ints.size(); ++i)
+	{
+		ints[i] = (int)rng.RandLimit(2000000) - 1000000;
+		doubles[i] = ints[i] / 1000.0;
+	}
+
+	for(int i = 0; i < 2; i++)
+	{
+		S str;
+
+		stopwatch1.Restart();
+		for(int value : ints)
+			AppendMetric(str, "m", value);
+		stopwatch1.Stop();
+		sprintf(Benchmark::gScratchBuffer, "%u", (unsigned)str.size());
+
+		if(i == 1)
+			Benchmark::AddResult("string<char>/append_number int", IX, stopwatch1);
+
+		if constexpr(!std::is_void_v<View>)
+		{
+			// remove names, to leave a list of numbers
+			S nums;
+			for(size_t j = 0; j != ints.size(); ++j)
+			{
+				nums.append_number(ints[j]);
+				nums.append(1, ' ');
+			}
+
+			stopwatch1.Restart();
+			uint32_t sum = ParseInt(View(nums));
+			stopwatch1.Stop();
+			sprintf(Benchmark::gScratchBuffer, "%u", (unsigned)sum);
+		}
+		else
+		{
+			eastl::string nums;
+			for(size_t j = 0; j != ints.size(); ++j)
+				nums.append_sprintf("%d ", ints[j]);
+
+			stopwatch1.Restart();
+			uint32_t sum = ParseInt(nums);
+			stopwatch1.Stop();
+			sprintf(Benchmark::gScratchBuffer, "%u", (unsigned)sum);
+		}
+
+		if(i == 1)
+			Benchmark::AddResult("string<char>/from_chars int", IX, stopwatch1);
+
+		str.clear();
+
+		stopwatch1.Restart();
+		for(double value : doubles)
+			AppendMetric(str, "m", value);
+		stopwatch1.Stop();
+		sprintf(Benchmark::gScratchBuffer, "%u", (unsigned)str.size());
+
+		if(i == 1)
+			Benchmark::AddResult("string<char>/append_number double", IX, stopwatch1);
+	}
+}
+
+
+template<int IX, class S>
+void BenchmarkFormatTempl()
+{
+	Stopwatch stopwatch1(Stopwatch::kUnitsCPUCycles);
+
+	for(int i = 0; i < 2; i++)
+	{
+		// each line in a new string
+		uint32_t sum = 0;
+		stopwatch1.Restart();
+		for(uint32_t j = 0; j < 10000; j++)
+		{
+			S line;
+			FormatLogLine(line, j);
+			sum += (uint32_t)line.size();
+		}
+		stopwatch1.Stop();
+		sprintf(Benchmark::gScratchBuffer, "%u", (unsigned)sum);
+
+		if(i == 1)
+			Benchmark::AddResult("string<char>/format log line", IX, stopwatch1);
+
+		// appending to a log buffer
+		S log;
+		stopwatch1.Restart();
+		for(uint32_t j = 0; j < 10000; j++)
+			FormatLogLine(log, j);
+		stopwatch1.Stop();
+		sprintf(Benchmark::gScratchBuffer, "%u", (unsigned)log.size());
+
+		if(i == 1)
+			Benchmark::AddResult("string<char>/format_to log buffer", IX, stopwatch1);
+	}
+}
+
+
+template<int IX, class S, bool Switch, bool SwitchRow = Switch>
+void BenchmarkDispatchTempl()
+{
+	EASTLTest_Rand rng(GetRandSeed());
+	Stopwatch stopwatch1(Stopwatch::kUnitsCPUCycles);
+
+	eastl::vector<S> names(10000);
+	for(auto& each : names)
+		AssignText(each, kHeaderNames[rng.RandLimit(sizeof(kHeaderNames) / sizeof(kHeaderNames[0]))]);
+
+	for(int i = 0; i < 2; i++)
+	{
+		uint32_t sum = 0;
+		stopwatch1.Restart();
+		for(const auto& each : names)
+		{
+			if constexpr(Switch)
+				sum += DispatchSwitch(each);
+			else
+				sum += DispatchLinear(each);
+		}
+		stopwatch1.Stop();
+		sprintf(Benchmark::gScratchBuffer, "%u", (unsigned)sum);
+
+		if(i == 1)
+			Benchmark::AddResult(SwitchRow ? "string<char>/header dispatch switch" : "string<char>/header dispatch linear", IX, stopwatch1);
+	}
+}
+
+
+// heap safe iterators on short strings, members of an owned object
+template<int IX, class S>
+void BenchmarkSsoIteratorTempl()
+{
+	Stopwatch stopwatch1(Stopwatch::kUnitsCPUCycles);
+
+	const size_t kFieldCount = sizeof(kHeaderText) / sizeof(kHeaderText[0]) / 2;
+
+	for(int i = 0; i < 2; i++)
+	{
+		uint32_t sum = 0;
+		stopwatch1.Restart();
+		for(int r = 0; r < 10000; r++)
+		{
+			for(size_t f = 0; f != kFieldCount; ++f)
+			{
+				auto h = safememory::make_owning<HeaderField<S>>();
+				AssignText(h->name, kHeaderText[f * 2]);
+				AssignText(h->value, kHeaderText[f * 2 + 1]);
+
+				for(auto it = BeginSafe(h->name), end = EndSafe(h->name); it != end; ++it)
+					sum += *it;
+				for(auto it = BeginSafe(h->value), end = EndSafe(h->value); it != end; ++it)
+					sum += *it;
+			}
+		}
+		stopwatch1.Stop();
+		sprintf(Benchmark::gScratchBuffer, "%u", (unsigned)sum);
+
+		if(i == 1)
+			Benchmark::AddResult("string<char>/sso safe iterators", IX, stopwatch1);
+	}
+}
+
+
 void BenchmarkString()
 {
 	EASTLTest_Printf("String\n");
@@ -500,6 +999,46 @@ void BenchmarkString()
 	BenchmarkStringTempl<2, Unsafe8, Unsafe16>();
 	BenchmarkStringTempl<3, Safe8, Safe16>();
 	BenchmarkStringTempl<4, VerySafe8, VerySafe16>();
+
+	BenchmarkJsonTempl<1, eastl::string>();
+	BenchmarkJsonTempl<2, safememory::basic_string<char, safememory::memory_safety::none>>();
+	BenchmarkJsonTempl<3, safememory::basic_string<char, safememory::memory_safety::safe>>();
+	BenchmarkJsonTempl<4, safememory::basic_string_safe<char, safememory::memory_safety::safe>>();
+
+	// first column is eastl::string iterators, as eastl::string_view has no find_if.
+	// there is no heap_safe view, only three columns
+	typedef safememory::basic_string<char, safememory::memory_safety::none> UnsafeString;
+	typedef safememory::basic_string<char, safememory::memory_safety::safe> SafeString;
+
+	BenchmarkJsonTempl<1, eastl::string, true>();
+	BenchmarkJsonViewTempl<2, safememory::basic_string_view<char, safememory::memory_safety::none>, UnsafeString>();
+	BenchmarkJsonViewTempl<3, safememory::basic_string_view<char, safememory::memory_safety::safe>, SafeString>();
+
+	// first column is eastl::string with append_sprintf and strtol, as safememory::to_string was before
+	BenchmarkNumberTempl<1, eastl::string>();
+	BenchmarkNumberTempl<2, UnsafeString, safememory::basic_string_view<char, safememory::memory_safety::none>>();
+	BenchmarkNumberTempl<3, SafeString, safememory::basic_string_view<char, safememory::memory_safety::safe>>();
+	BenchmarkNumberTempl<4, safememory::basic_string_safe<char, safememory::memory_safety::safe>, safememory::basic_string_view<char, safememory::memory_safety::safe>>();
+
+	// first column is fmt::format to a std::string, then appended to eastl::string
+	BenchmarkFormatTempl<1, eastl::string>();
+	BenchmarkFormatTempl<2, UnsafeString>();
+	BenchmarkFormatTempl<3, SafeString>();
+	BenchmarkFormatTempl<4, safememory::basic_string_safe<char, safememory::memory_safety::safe>>();
+
+	BenchmarkDispatchTempl<1, eastl::string, false>();
+	BenchmarkDispatchTempl<2, UnsafeString, false>();
+	BenchmarkDispatchTempl<3, SafeString, false>();
+
+	// first column is eastl::string with linear comparisons
+	BenchmarkDispatchTempl<1, eastl::string, false, true>();
+	BenchmarkDispatchTempl<2, UnsafeString, true>();
+	BenchmarkDispatchTempl<3, SafeString, true>();
+
+	BenchmarkSsoIteratorTempl<1, eastl::string>();
+	BenchmarkSsoIteratorTempl<2, UnsafeString>();
+	BenchmarkSsoIteratorTempl<3, SafeString>();
+	BenchmarkSsoIteratorTempl<4, safememory::basic_string_safe<char, safememory::memory_safety::safe>>();
 }
 
 
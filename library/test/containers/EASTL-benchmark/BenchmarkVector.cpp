@@ -9,6 +9,7 @@
 #include <EASTL/algorithm.h>
 #include <EASTL/sort.h>
 #include <safememory/vector.h>
+#include <safememory/string.h>
 #include <safememory/algorithm.h>
 #include <EASTL/vector.h>
 
@@ -191,6 +192,34 @@ namespace
 	}
 
 
+	// Growth from empty, time is dominated by reallocations
+	template <typename Container>
+	void TestPushBackN(EA::StdC::Stopwatch& stopwatch, Container& c, uint32_t n)
+	{
+		stopwatch.Restart();
+		for(uint32_t j = 0; j < n; j++)
+			c.push_back(j);
+		stopwatch.Stop();
+	}
+
+
+	// Tight loop that is vectorized when the iterator is a raw pointer,
+	// repeated to measure iterator overhead and not memory bandwidth
+	template <typename Container>
+	void TestIterationSum(EA::StdC::Stopwatch& stopwatch, const Container& c)
+	{
+		uint32_t temp = 0;
+		stopwatch.Restart();
+		for(int j = 0; j < 100; j++)
+		{
+			for(auto it = c.begin(), itEnd = c.end(); it != itEnd; ++it)
+				temp += (uint32_t)*it;
+		}
+		stopwatch.Stop();
+		sprintf(Benchmark::gScratchBuffer, "%u", (unsigned)temp);
+	}
+
+
 	template <typename Container>
 	void TestBracket(EA::StdC::Stopwatch& stopwatch, Container& c, eastl::vector<uint32_t>& intVector)
 	{
@@ -226,6 +255,18 @@ namespace
 		sprintf(Benchmark::gScratchBuffer, "%u", (unsigned)(c[0] & 0xffffffff));
 	}
 
+	template <typename Container>
+	void TestSortAlgorithm(EA::StdC::Stopwatch& stopwatch, Container& c)
+	{
+		// safememory::sort validates the range once and sorts raw pointers,
+		// instead of copying (heap safe) iterators in the inner loop.
+		stopwatch.Restart();
+		safememory::sort(c.begin(), c.end()); 
+		stopwatch.Stop();
+		sprintf(Benchmark::gScratchBuffer, "%u", (unsigned)(c[0] & 0xffffffff));
+	}
+
+
 
 	template <typename Container>
 	void TestInsert(EA::StdC::Stopwatch& stopwatch, Container& c)
@@ -283,6 +324,16 @@ namespace
 	}
 
 
+	template <typename Container>
+	void TestRelocate(EA::StdC::Stopwatch& stopwatch, Container& c)
+	{
+		stopwatch.Restart();
+		for(int i = 0; i < 4; i++)
+			c.reserve(c.capacity() + 1);
+		stopwatch.Stop();
+	}
+
+
 	template <typename Container>
 	void TestMoveErase(EA::StdC::Stopwatch& stopwatch, Container& c)
 	{
@@ -293,6 +344,87 @@ namespace
 	}
 
 
+	template <typename T>
+	void AppendRange(eastl::vector<T>& c, const eastl::vector<T>& src, size_t first, size_t last)
+	{
+		c.insert(c.end(), src.begin() + first, src.begin() + last);
+	}
+
+	template <typename Container>
+	void AppendRange(Container& c, const Container& src, size_t first, size_t last)
+	{
+		c.append(src.begin() + first, src.begin() + last);
+	}
+
+
+	// Network buffer usage, chunks of a received packet appended to a buffer
+	template <typename Container>
+	void TestAppendChunks(EA::StdC::Stopwatch& stopwatch, Container& c, const Container& src, const eastl::vector<uint32_t>& chunks, bool useInsert)
+	{
+		uint64_t temp = 0;
+		stopwatch.Restart();
+		for(uint32_t each : chunks)
+		{
+			if(c.size() > 65536)
+			{
+				temp += c.size();
+				c.clear();
+			}
+
+			if(useInsert)
+				c.insert(c.end(), src.begin() + (each & 0xFF), src.begin() + each);
+			else
+				AppendRange(c, src, each & 0xFF, each);
+		}
+		stopwatch.Stop();
+		sprintf(Benchmark::gScratchBuffer, "%u", (unsigned)(temp + c.size()));
+	}
+
+
+	// A socket read into a buffer, 'recv' is a memcpy of part of the packet
+	template <typename T>
+	void ReceiveInto(eastl::vector<T>& c, const T* src, size_t len, bool)
+	{
+		c.resize(1500);
+		memcpy(c.data(), src, len);
+		c.resize(len);
+	}
+
+	template <typename Container>
+	void ReceiveInto(Container& c, const typename Container::value_type* src, size_t len, bool useOverwrite)
+	{
+		if(useOverwrite)
+		{
+			c.resize_and_overwrite_unsafe(1500, [src, len](typename Container::pointer p, size_t) {
+				memcpy(p, src, len);
+				return len;
+			});
+		}
+		else
+		{
+			c.resize(1500);
+			memcpy(c.data_unsafe(), src, len);
+			c.resize(len);
+		}
+	}
+
+
+	template <typename Container>
+	void TestReceive(EA::StdC::Stopwatch& stopwatch, Container& c, const Container& src, const eastl::vector<uint32_t>& chunks, bool useOverwrite)
+	{
+		uint64_t temp = 0;
+		stopwatch.Restart();
+		for(uint32_t each : chunks)
+		{
+			c.clear();
+			ReceiveInto(c, &*src.begin(), each, useOverwrite);
+			temp += c.back();
+		}
+		stopwatch.Stop();
+		sprintf(Benchmark::gScratchBuffer, "%u", (unsigned)temp);
+	}
+
+
 } // namespace
 
 template<int IX, template<typename> typename Vec> 
@@ -318,6 +450,12 @@ void BenchmarkVectorTempl()
 		if(i == 1)
 			Benchmark::AddResult("vector<uint64>/push_back", IX, stopwatch1);
 
+		Vec<uint32_t> bigVector;
+		TestPushBackN(stopwatch1, bigVector, 10000000);
+
+		if(i == 1)
+			Benchmark::AddResult("vector<uint32>/push_back 10M", IX, stopwatch1);
+
 
 		///////////////////////////////
 		// Test operator[].
@@ -339,6 +477,14 @@ void BenchmarkVectorTempl()
 		if(i == 1)
 			Benchmark::AddResult("vector<uint64>/iteration", IX, stopwatch1);
 
+		Vec<int> intVec;
+		for(uint32_t each : intVector)
+			intVec.push_back((int)each);
+		TestIterationSum(stopwatch1, intVec);
+
+		if(i == 1)
+			Benchmark::AddResult("vector<int>/iteration sum", IX, stopwatch1);
+
 
 		///////////////////////////////
 		// Test sort
@@ -351,6 +497,14 @@ void BenchmarkVectorTempl()
 
 			if(i == 1)
 				Benchmark::AddResult("vector<uint64>/sort", IX, stopwatch1);
+
+			Vec<uint64_t> sortVectorUint64;
+			for(uint32_t each : intVector)
+				sortVectorUint64.push_back(each);
+			TestSortAlgorithm(stopwatch1, sortVectorUint64);
+
+			if(i == 1)
+				Benchmark::AddResult("vector<uint64>/safememory::sort", IX, stopwatch1);
 		#endif
 
 		///////////////////////////////
@@ -392,6 +546,36 @@ void BenchmarkVectorTempl()
 			Benchmark::AddResult("vector<MovableType>/erase", IX, stopwatch1);
 
 
+		///////////////////////////////////////////
+		// Test reallocation of 1M elements that are
+		// trivially relocatable but not trivially copyable.
+		///////////////////////////////////////////
+
+		{
+			Vec<safememory::string> stringVector;
+			stringVector.reserve(1000000);
+			for(uint32_t a = 0; a < 1000000; a++)
+				stringVector.emplace_back("1234567");
+
+			TestRelocate(stopwatch1, stringVector);
+
+			if(i == 1)
+				Benchmark::AddResult("vector<string>/reallocate 1M", IX, stopwatch1);
+		}
+
+		{
+			Vec<safememory::owning_ptr<uint32_t>> owningVector;
+			owningVector.reserve(1000000);
+			for(uint32_t a = 0; a < 1000000; a++)
+				owningVector.push_back(safememory::make_owning<uint32_t>(a));
+
+			TestRelocate(stopwatch1, owningVector);
+
+			if(i == 1)
+				Benchmark::AddResult("vector<owning_ptr>/reallocate 1M", IX, stopwatch1);
+		}
+
+
 		///////////////////////////////////////////
 		// Test move of AutoRefCount
 		// Should be much faster with C++11 move.
@@ -411,9 +595,82 @@ void BenchmarkVectorTempl()
 
 		if(i == 1)
 			Benchmark::AddResult("vector<AutoRefCount>/erase", IX, stopwatch1);
+
+
+		///////////////////////////////////////////
+		// Test bulk append of bytes
+		///////////////////////////////////////////
+
+		Vec<uint8_t> src(1500);
+		eastl::generate(src.begin(), src.end(), [&]() { return static_cast<uint8_t>(rng(256)); });
+
+		eastl::vector<uint32_t> chunks(20000);
+		eastl::generate(chunks.begin(), chunks.end(), [&]() { return 256 + rng(1500 - 256); });
+
+		Vec<uint8_t> buffer;
+
+		TestAppendChunks(stopwatch1, buffer, src, chunks, true);
+
+		if(i == 1)
+			Benchmark::AddResult("vector<uint8>/insert range at end", IX, stopwatch1);
+
+		buffer.clear();
+		TestAppendChunks(stopwatch1, buffer, src, chunks, false);
+
+		if(i == 1)
+			Benchmark::AddResult("vector<uint8>/append range", IX, stopwatch1);
+
+
+		TestReceive(stopwatch1, buffer, src, chunks, false);
+
+		if(i == 1)
+			Benchmark::AddResult("vector<uint8>/receive with resize", IX, stopwatch1);
+
+		TestReceive(stopwatch1, buffer, src, chunks, true);
+
+		if(i == 1)
+			Benchmark::AddResult("vector<uint8>/receive with resize_and_overwrite", IX, stopwatch1);
+	}
+}
+
+// Bytes requested for the storage of arrays of 1..64 elements, with
+// flexible_array::calculateSize and with the sizeof(flexible_array) based size
+// it replaced. 'pow2' is the same rounded up to power of 2 buckets, and
+// 'capacity' is the extra elements calculateCapacity finds in those buckets.
+template <typename T>
+void PrintFlexibleArraySize(const char* pName)
+{
+	typedef safememory::detail::flexible_array<T> Array;
+
+	std::size_t nExact = 0, nSizeof = 0, nExactPow2 = 0, nSizeofPow2 = 0, nExtra = 0;
+	for(eastl_size_t n = 1; n <= 64; ++n)
+	{
+		const std::size_t exact = Array::calculateSize(n);
+		const std::size_t bySizeof = sizeof(Array) + n * sizeof(T);
+		std::size_t pow2 = 8, sizeofPow2 = 8;
+		while(pow2 < exact)
+			pow2 *= 2;
+		while(sizeofPow2 < bySizeof)
+			sizeofPow2 *= 2;
+
+		nExact += exact;
+		nSizeof += bySizeof;
+		nExactPow2 += pow2;
+		nSizeofPow2 += sizeofPow2;
+		nExtra += Array::calculateCapacity(pow2) - n;
 	}
+
+	EASTLTest_Printf("%-50s | bytes %6u (%5.1f%%) | pow2 %6u (%5.1f%%) | capacity +%u\n", pName,
+		(unsigned)nExact, 100.0 * ((double)nExact - (double)nSizeof) / (double)nSizeof,
+		(unsigned)nExactPow2, 100.0 * ((double)nExactPow2 - (double)nSizeofPow2) / (double)nSizeofPow2,
+		(unsigned)nExtra);
 }
 
+struct alignas(32) Aligned32Type
+{
+	char c[32];
+};
+
 template<class T>
 using StdVec = std::vector<T>;
 
@@ -439,5 +696,11 @@ void BenchmarkVector()
 	BenchmarkVectorTempl<2, UnsafeVec>();
 	BenchmarkVectorTempl<3, SafeVec>();
 	BenchmarkVectorTempl<4, VerySafeVec>();
+
+	PrintFlexibleArraySize<char>("flexible_array<char>/size 1..64");
+	PrintFlexibleArraySize<uint16_t>("flexible_array<uint16>/size 1..64");
+	PrintFlexibleArraySize<uint32_t>("flexible_array<uint32>/size 1..64");
+	PrintFlexibleArraySize<uint64_t>("flexible_array<uint64>/size 1..64");
+	PrintFlexibleArraySize<Aligned32Type>("flexible_array<aligned 32>/size 1..64");
 }
 
@@ -41,6 +41,7 @@ void BenchmarkDeque();
 void BenchmarkSet();
 void BenchmarkMap();
 void BenchmarkHash();
+void BenchmarkStableVector();
 void BenchmarkAlgorithm();
 void BenchmarkHeap();
 void BenchmarkBitset();
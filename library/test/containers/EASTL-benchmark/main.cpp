@@ -115,6 +115,9 @@ int main(int argc, char* argv[])
 	// Set up test information
 	Benchmark::Environment& environment = Benchmark::GetEnvironment();
 	environment.msPlatform = EA_PLATFORM_DESCRIPTION;
+
+	// results depend on SAFEMEMORY_SIZE_T_32BIT build option, run both to compare
+	EASTLTest_Printf("Containers size_type is %d bits\n", (int)(sizeof(eastl_size_t) * 8));
 	// environment.msSTLName1 = GetStdSTLName();
 	// environment.msSTLName2 = "node-dot-cpp/memory-safe-cpp";
 
@@ -132,10 +135,11 @@ int main(int argc, char* argv[])
 		// BenchmarkList();
 		BenchmarkString();
 		BenchmarkVector();
-		// BenchmarkDeque();
+		BenchmarkDeque();
 		// BenchmarkSet();
-		// BenchmarkMap();
+		BenchmarkMap();
 		BenchmarkHash();
+		BenchmarkStableVector();
 		// BenchmarkHeap();
 		// BenchmarkBitset();
 		// BenchmarkSort();
@@ -73,6 +73,7 @@ int TestSmartPtr();
 int TestSort();
 int TestSpan();
 int TestSparseMatrix();
+int TestStableVector();
 int TestString();
 int TestStringHashMap();
 int TestStringMap();
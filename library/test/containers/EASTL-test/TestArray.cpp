@@ -17,6 +17,8 @@
 // These tell the compiler to compile all the functions for the given class.
 template struct safememory::array<int>;
 template struct safememory::array<Align32>; // VC++ fails to compile due to error generated by the swap function. C2718: http://msdn.microsoft.com/en-us/library/vstudio/sxe76d9e.aspx
+template struct safememory::constexpr_array<int>;
+template struct safememory::constexpr_array<int, 1, safememory::memory_safety::none>;
 
 
 template<typename ARR>
@@ -218,6 +220,102 @@ int TestArrayHeap()
 	return TestArrayImpl(*a, *b, *c);
 }
 
+namespace
+{
+	constexpr safememory::constexpr_array<uint32_t, 256> MakeCrcTable()
+	{
+		safememory::constexpr_array<uint32_t, 256> t{};
+		for(uint32_t i = 0; i != 256; ++i)
+		{
+			uint32_t c = i;
+			for(int k = 0; k != 8; ++k)
+				c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+			t[i] = c;
+		}
+		return t;
+	}
+
+	constexpr safememory::constexpr_array<uint32_t, 256> crcTable = MakeCrcTable();
+
+	template<typename Table>
+	constexpr uint32_t Crc32(const Table& table, const char* str, size_t sz)
+	{
+		uint32_t crc = 0xFFFFFFFFu;
+		for(size_t i = 0; i != sz; ++i)
+			crc = table[(crc ^ static_cast<uint8_t>(str[i])) & 0xFF] ^ (crc >> 8);
+		return crc ^ 0xFFFFFFFFu;
+	}
+
+	template<typename T, size_t N>
+	constexpr bool IsIndexable(size_t i)
+	{
+		// a throw at compile time is not a constant expression
+		constexpr safememory::constexpr_array<T, N> a{};
+		return (a[i], true);
+	}
+}
+
+
+int TestConstexprArray()
+{
+	int nErrorCount = 0;
+
+	{
+		static_assert(crcTable[0] == 0);
+		static_assert(crcTable.get<1>() == 0x77073096u);
+		static_assert(safememory::get<255>(crcTable) == 0x2D02EF8Du);
+		static_assert(Crc32(crcTable, "123456789", 9) == 0xCBF43926u);
+		static_assert(IsIndexable<int, 4>(3));
+
+		constexpr safememory::constexpr_array<int, 4> a = { 0, 1, 2, 3 };
+		static_assert(a == safememory::constexpr_array<int, 4>{ 0, 1, 2, 3 });
+		static_assert(a != safememory::constexpr_array<int, 4>{ 0, 1, 2 });
+		static_assert(a.size() == 4 && !a.empty());
+		static_assert(a.front() == 0 && a.back() == 3 && a.at(2) == 2);
+
+		safememory::constexpr_array b = { 1, 2, 3 };
+		static_assert(std::is_same_v<decltype(b), safememory::constexpr_array<int, 3>>);
+
+		EATEST_VERIFY(Crc32(crcTable, "123456789", 9) == 0xCBF43926u);
+
+		// stack only iterators
+		int n = 0;
+		for(uint32_t each : crcTable)
+			n += (each & 1);
+		EATEST_VERIFY(n == 128);
+		EATEST_VERIFY(crcTable.end() - crcTable.begin() == 256);
+		EATEST_VERIFY(*crcTable.rbegin() == 0x2D02EF8Du);
+		EATEST_VERIFY((crcTable.validate_iterator(crcTable.begin()) & eastl::isf_can_dereference) != 0);
+
+		b.fill(7);
+		EATEST_VERIFY(b[0] == 7 && b[2] == 7);
+	}
+
+	#if EASTL_EXCEPTIONS_ENABLED
+	{
+		volatile size_t ix = 256;
+		try
+		{
+			uint32_t x = crcTable[ix];
+			EATEST_VERIFY(x == 0);  // Should not get here, as exception thrown.
+		}
+		catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+		catch (...) { EATEST_VERIFY(false); }
+
+		auto it = crcTable.end();
+		try
+		{
+			uint32_t x = *it;
+			EATEST_VERIFY(x == 0);  // Should not get here, as exception thrown.
+		}
+		catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+		catch (...) { EATEST_VERIFY(false); }
+	}
+	#endif
+
+	return nErrorCount;
+}
+
 template<typename T, size_t SZ>
 using ARR = safememory::array<T, SZ>;
 
@@ -231,6 +329,7 @@ int TestArray()
 	nErrorCount += TestArrayStack<ARR>();
 	nErrorCount += TestArrayHeap<ARR>();
 	nErrorCount += TestArrayHeap<ARR_SAFE>();
+	nErrorCount += TestConstexprArray();
 
 	return nErrorCount;
 }
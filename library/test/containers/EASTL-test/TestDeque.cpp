@@ -0,0 +1,307 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+
+#include "EASTLTest.h"
+#include <safememory/deque.h>
+#include <deque>
+#include <random>
+#include <cstring>
+
+
+// Template instantations.
+// These tell the compiler to compile all the functions for the given class.
+template class safememory::deque<int>;
+template class safememory::deque<TestObject>;
+template class safememory::deque_safe<int>;
+template class safememory::deque<int, safememory::memory_safety::none>;
+
+
+template <typename T>
+using DEQUE = safememory::deque<T>;
+
+template <typename T>
+using DEQUE_SAFE = safememory::deque_safe<T>;
+
+
+///////////////////////////////////////////////////////////////////////////////
+// TestDequeCompareStd
+//
+// Random operations at both ends and in the middle, checking against std::deque.
+// Enough operations are done to wrap around and grow several times.
+//
+template <typename T1>
+int TestDequeCompareStd()
+{
+	int nErrorCount = 0;
+
+	TestObject::Reset();
+
+	{
+		T1 t1;
+		std::deque<int> t2;
+
+		std::mt19937 rng(GetRandSeed());
+
+		for(int i = 0; i < 20000; i++)
+		{
+			int op = rng() % 8;
+			if(op < 2)
+			{
+				t1.push_back(TestObject(i));
+				t2.push_back(i);
+			}
+			else if(op < 4)
+			{
+				t1.push_front(TestObject(i));
+				t2.push_front(i);
+			}
+			else if(op == 4 && !t2.empty())
+			{
+				t1.pop_back();
+				t2.pop_back();
+			}
+			else if(op == 5 && !t2.empty())
+			{
+				t1.pop_front();
+				t2.pop_front();
+			}
+			else if(op == 6 && t2.size() < 200)
+			{
+				size_t pos = rng() % (t2.size() + 1);
+				auto it = t1.insert(t1.begin() + pos, TestObject(i));
+				t2.insert(t2.begin() + pos, i);
+				EATEST_VERIFY(it->mX == i);
+			}
+			else if(op == 7 && !t2.empty() && t2.size() < 200)
+			{
+				size_t pos = rng() % t2.size();
+				auto it = t1.erase(t1.begin() + pos);
+				auto it2 = t2.erase(t2.begin() + pos);
+				EATEST_VERIFY((it == t1.end()) == (it2 == t2.end()));
+			}
+
+			if(i % 1000 == 0)
+			{
+				EATEST_VERIFY(t1.size() == t2.size());
+				EATEST_VERIFY(std::equal(t1.begin(), t1.end(), t2.begin(),
+					[](const TestObject& a, int b) { return a.mX == b; }));
+			}
+		}
+
+		EATEST_VERIFY(t1.size() == t2.size());
+		EATEST_VERIFY(std::equal(t1.begin(), t1.end(), t2.begin(),
+			[](const TestObject& a, int b) { return a.mX == b; }));
+		EATEST_VERIFY(std::equal(t1.rbegin(), t1.rend(), t2.rbegin(),
+			[](const TestObject& a, int b) { return a.mX == b; }));
+
+		for(size_t i = 0; i < t2.size(); i++)
+			EATEST_VERIFY(t1[i].mX == t2[i]);
+
+		// erase a range in the middle
+		if(t2.size() > 10)
+		{
+			t1.erase(t1.begin() + 3, t1.end() - 3);
+			t2.erase(t2.begin() + 3, t2.end() - 3);
+			EATEST_VERIFY(t1.size() == 6);
+			EATEST_VERIFY(std::equal(t1.begin(), t1.end(), t2.begin(),
+				[](const TestObject& a, int b) { return a.mX == b; }));
+		}
+
+		t1.clear();
+		EATEST_VERIFY(t1.empty());
+		EATEST_VERIFY(t1.begin() == t1.end());
+	}
+
+	EATEST_VERIFY(TestObject::IsClear());
+	TestObject::Reset();
+
+	return nErrorCount;
+}
+
+
+template<template<typename> typename DEQ>
+int TestDequeImpl()
+{
+	int nErrorCount = 0;
+
+	nErrorCount += TestDequeCompareStd<DEQ<TestObject>>();
+
+	{
+		// ctors, assign, compare
+		DEQ<int> d1;
+		EATEST_VERIFY(d1.empty());
+		EATEST_VERIFY(d1.capacity() == 0);
+		EATEST_VERIFY(d1.begin() == d1.end());
+
+		DEQ<int> d2(5, 7);
+		EATEST_VERIFY(d2.size() == 5);
+		EATEST_VERIFY(d2.front() == 7 && d2.back() == 7);
+
+		DEQ<int> d3 = {1, 2, 3};
+		EATEST_VERIFY(d3.size() == 3);
+		EATEST_VERIFY(d3[0] == 1 && d3[2] == 3);
+
+		DEQ<int> d4(d3);
+		EATEST_VERIFY(d4 == d3);
+		d4.push_front(0);
+		EATEST_VERIFY(d4 != d3);
+		EATEST_VERIFY(d4 < d3);
+
+		DEQ<int> d5(std::move(d4));
+		EATEST_VERIFY(d4.empty());
+		EATEST_VERIFY(d5.size() == 4);
+
+		d1 = d5;
+		EATEST_VERIFY(d1 == d5);
+		d1.swap(d2);
+		EATEST_VERIFY(d1.size() == 5 && d2.size() == 4);
+
+		d1.assign(3, 9);
+		EATEST_VERIFY(d1 == DEQ<int>({9, 9, 9}));
+	}
+
+	{
+		// wrap around, elements keep order when growing with a wrapped buffer
+		DEQ<int> d;
+		d.reserve(8);
+		EATEST_VERIFY(d.capacity() == 8);
+
+		for(int i = 0; i < 8; i++)
+			d.push_back(i);
+		for(int i = 0; i < 4; i++)
+			d.pop_front();
+		for(int i = 8; i < 12; i++)
+			d.push_back(i);
+		EATEST_VERIFY(d.capacity() == 8);
+
+		d.push_front(3);
+		EATEST_VERIFY(d.capacity() == 16);
+		for(int i = 0; i < 9; i++)
+			EATEST_VERIFY(d[i] == i + 3);
+
+		// pushing an element of the deque itself while growing
+		d.shrink_to_fit();
+		EATEST_VERIFY(d.capacity() == d.size());
+		d.push_back(d.front());
+		EATEST_VERIFY(d.back() == 3);
+		d.push_front(d.back());
+		EATEST_VERIFY(d.front() == 3);
+
+		d.resize(20, d[1]);
+		EATEST_VERIFY(d.size() == 20);
+		EATEST_VERIFY(d.back() == 3);
+		d.resize(2);
+		EATEST_VERIFY(d.size() == 2);
+	}
+
+	{
+		// queue usage, capacity stays bounded
+		DEQ<int> d;
+		for(int i = 0; i < 10000; i++)
+		{
+			d.push_back(i);
+			if(d.size() > 10)
+			{
+				EATEST_VERIFY(d.front() == i - 10);
+				d.pop_front();
+			}
+		}
+		EATEST_VERIFY(d.capacity() <= 16);
+	}
+
+	{
+		// zeroed instance is a valid empty deque
+		typedef DEQ<int> DequeInt;
+		alignas(DequeInt) char buff[sizeof(DequeInt)];
+		memset(buff, 0, sizeof(buff));
+		DequeInt* d = reinterpret_cast<DequeInt*>(buff);
+
+		EATEST_VERIFY(d->empty());
+		EATEST_VERIFY(d->begin() == d->end());
+		d->push_back(1);
+		d->push_front(0);
+		EATEST_VERIFY(d->size() == 2 && d->front() == 0);
+		d->~DequeInt();
+		EATEST_VERIFY(d->empty());
+	}
+
+#if EASTL_EXCEPTIONS_ENABLED
+	{
+		DEQ<int> d = {1, 2, 3};
+
+		try
+		{
+			int x = d.at(3);
+			EATEST_VERIFY(x == -1);  // Should not get here, as exception thrown.
+		}
+		catch (std::out_of_range&) { EATEST_VERIFY(true); }
+		catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+		catch (...) { EATEST_VERIFY(false); }
+
+		d.clear();
+		try
+		{
+			d.pop_front();
+			EATEST_VERIFY(false);  // Should not get here, as exception thrown.
+		}
+		catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+		catch (...) { EATEST_VERIFY(false); }
+
+		// position from another deque
+		DEQ<int> d2 = {1, 2, 3};
+		try
+		{
+			d.insert(d2.begin(), 0);
+			EATEST_VERIFY(false);  // Should not get here, as exception thrown.
+		}
+		catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+		catch (...) { EATEST_VERIFY(false); }
+	}
+#endif
+
+	return nErrorCount;
+}
+
+
+int TestDeque()
+{
+	int nErrorCount = 0;
+
+	nErrorCount += TestDequeImpl<DEQUE>();
+	nErrorCount += TestDequeImpl<DEQUE_SAFE>();
+
+#if EASTL_EXCEPTIONS_ENABLED
+	{
+		// heap safe iterators detect the array going away when the deque grows
+		safememory::deque<int> d = {1, 2, 3};
+		d.shrink_to_fit();
+
+		auto it = d.begin_safe();
+		EATEST_VERIFY(*it == 1);
+
+		d.push_back(4);
+		try
+		{
+			int x = *it;
+			EATEST_VERIFY(x == -1);  // Should not get here, as exception thrown.
+		}
+		catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+		catch (...) { EATEST_VERIFY(false); }
+
+		// a position from before a push_front is not valid
+		auto it2 = d.begin();
+		d.push_front(0);
+		try
+		{
+			d.erase(it2);
+			EATEST_VERIFY(false);  // Should not get here, as exception thrown.
+		}
+		catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+		catch (...) { EATEST_VERIFY(false); }
+	}
+#endif
+
+	return nErrorCount;
+}
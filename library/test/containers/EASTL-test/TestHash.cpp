@@ -343,7 +343,7 @@ int TestHashSet()
 
 		hashSet.rehash(20);
 		typename HashSetInt::size_type n = hashSet.bucket_count();
-		EATEST_VERIFY((n >= 20) && (n < 25));
+		EATEST_VERIFY((n >= 20) && (n < 40)); // next prime or next power of two, depending on rehash policy
 		
 		for(int i = 0; i < 10000; i++)
 			hashSet.insert(i);
@@ -355,10 +355,11 @@ int TestHashSet()
 		EATEST_VERIFY(n >= ((hashSet.size() / hashSet.bucket_count()) / 2)); // It will be some high value. We divide by 2 to give it some slop.
 		EATEST_VERIFY(hashSet.validate());
 
-		// unordered_set<int>::rehash_policy_type rp = hashSet.rehash_policy();
-		// rp.mfGrowthFactor = 1.5f;
-		// hashSet.rehash_policy(rp);
-		// EATEST_VERIFY(hashSet.validate());
+		typename HashSetInt::rehash_policy_type rp = hashSet.rehash_policy();
+		rp.mfGrowthFactor = 1.5f;
+		hashSet.rehash_policy(rp);
+		EATEST_VERIFY(hashSet.rehash_policy().mfGrowthFactor == 1.5f);
+		EATEST_VERIFY(hashSet.validate());
 
 
 		// local_iterator       begin(size_type n);
@@ -367,7 +368,7 @@ int TestHashSet()
 		// const_local_iterator end(size_type n) const;
 
 		typename HashSetInt::size_type b = hashSet.bucket_count() - 1;
-		eastl::hash<int> IntHash;
+		safememory::hash<int> IntHash; // the hasher SET uses by default
 		for(typename HashSetInt::const_local_iterator cli = hashSet.begin(b); cli != hashSet.end(b); ++cli)
 		{
 			int v = *cli;
@@ -1569,6 +1570,403 @@ template <typename Key, typename T, typename Hash, typename Predicate>
 using MMAP4 = safememory::unordered_multimap<Key, T, Hash, Predicate>;
 
 
+// Integer hash that names its own rehash policy
+struct pow2_mixing_hash
+{
+	typedef safememory::pow2_rehash_policy rehash_policy;
+
+	size_t operator()(int val) const
+		{ return static_cast<size_t>(safememory::detail::hash_mix64(static_cast<uint64_t>(val))); }
+};
+
+static_assert(std::is_same_v<safememory::unordered_map<int, int>::rehash_policy_type, safememory::pow2_rehash_policy>);
+static_assert(std::is_same_v<safememory::unordered_set<int, safememory::hash<int, safememory::identity_hash_policy>>::rehash_policy_type, eastl::prime_rehash_policy>);
+static_assert(std::is_same_v<safememory::unordered_set<int, colliding_hash>::rehash_policy_type, eastl::prime_rehash_policy>);
+static_assert(std::is_same_v<safememory::unordered_multiset<int, pow2_mixing_hash>::rehash_policy_type, safememory::pow2_rehash_policy>);
+
+int TestHashRehashPolicy()
+{
+	int nErrorCount = 0;
+
+	auto isPow2 = [](size_t n) { return n >= 2 && (n & (n - 1)) == 0; };
+
+	{
+		safememory::pow2_rehash_policy rp;
+		EATEST_VERIFY(rp.GetNextBucketCount(0) == 2);
+		EATEST_VERIFY(rp.GetNextBucketCount(3) == 4);
+		EATEST_VERIFY(rp.GetNextBucketCount(1024) == 1024);
+		EATEST_VERIFY(rp.mnNextResize == 1024);
+		EATEST_VERIFY(rp.GetBucketCount(1000) == 1024);
+		EATEST_VERIFY(safememory::pow2_rehash_policy::GetPrevBucketCountOnly(1000) == 512);
+
+		// empty table has a single shared bucket, first insert always allocates
+		safememory::pow2_rehash_policy rp2;
+		EATEST_VERIFY(rp2.GetRehashRequired(1, 0, 1) == eastl::make_pair(true, uint32_t(2)));
+		EATEST_VERIFY(rp2.mnNextResize == 2);
+		EATEST_VERIFY(rp.GetRehashRequired(1024, 1000, 1) == eastl::make_pair(false, uint32_t(0)));
+		EATEST_VERIFY(rp.GetRehashRequired(1024, 1024, 1) == eastl::make_pair(true, uint32_t(2048)));
+
+		safememory::mask_range_hashing h;
+		EATEST_VERIFY(h(0x12345, 256) == 0x45);
+	}
+
+	{
+		// bucket count stays a power of two while growing, and load factor under its max
+		safememory::unordered_map<int, int> m;
+		size_t nRehashCount = 0;
+		size_t nBuckets = m.bucket_count();
+
+		for(int i = 0; i < 10000; i++)
+		{
+			m[i] = i;
+			if(m.bucket_count() != nBuckets)
+			{
+				nBuckets = m.bucket_count();
+				++nRehashCount;
+				EATEST_VERIFY(isPow2(nBuckets));
+			}
+			EATEST_VERIFY(m.load_factor() <= m.get_max_load_factor());
+		}
+		EATEST_VERIFY(m.validate());
+
+		// buckets are picked with a mask
+		safememory::hash<int> IntHash;
+		size_t b = m.bucket_count() - 1;
+		for(auto cli = m.begin(b); cli != m.end(b); ++cli)
+			EATEST_VERIFY((IntHash(cli->first) & (m.bucket_count() - 1)) == b);
+
+		// lower max load factor grows the table right away, keeping growth factor
+		safememory::pow2_rehash_policy rp(1.f, 4.f);
+		safememory::unordered_map<int, int> m4;
+		m4.rehash_policy(rp);
+		m4.set_max_load_factor(0.25f);
+		EATEST_VERIFY(m4.rehash_policy().mfGrowthFactor == 4.f);
+		EATEST_VERIFY(m4.get_max_load_factor() == 0.25f);
+
+		// larger growth factor means fewer rehashes
+		size_t nRehashCount4 = 0;
+		nBuckets = m4.bucket_count();
+		for(int i = 0; i < 10000; i++)
+		{
+			m4[i] = i;
+			if(m4.bucket_count() != nBuckets)
+			{
+				nBuckets = m4.bucket_count();
+				++nRehashCount4;
+				EATEST_VERIFY(isPow2(nBuckets));
+			}
+		}
+		EATEST_VERIFY(m4.load_factor() <= 0.25f);
+		EATEST_VERIFY(nRehashCount4 < nRehashCount);
+		EATEST_VERIFY(m4 == m);
+
+		m.set_max_load_factor(0.25f);
+		EATEST_VERIFY(m.load_factor() <= 0.25f);
+		EATEST_VERIFY(isPow2(m.bucket_count()));
+		EATEST_VERIFY(m.validate());
+	}
+
+	{
+		// reserve up front, no rehash at all while inserting
+		safememory::unordered_set<int> s;
+		s.reserve(5000);
+		size_t nBuckets = s.bucket_count();
+		EATEST_VERIFY(isPow2(nBuckets));
+
+		for(int i = 0; i < 5000; i++)
+			s.insert(i);
+		EATEST_VERIFY(s.bucket_count() == nBuckets);
+
+		s.insert(5000);
+		EATEST_VERIFY(s.size() == 5001);
+
+		s.rehash(100000);
+		EATEST_VERIFY(s.bucket_count() == 131072);
+		EATEST_VERIFY(s.validate());
+	}
+
+	{
+		safememory::unordered_multiset<int, pow2_mixing_hash> s(100);
+		EATEST_VERIFY(s.bucket_count() == 128);
+		for(int i = 0; i < 1000; i++)
+			s.insert(i % 100);
+		EATEST_VERIFY(s.count(42) == 10);
+		EATEST_VERIFY(isPow2(s.bucket_count()));
+		EATEST_VERIFY(s.validate());
+	}
+
+	return nErrorCount;
+}
+
+
+template<safememory::memory_safety Safety>
+int TestHashNodePoolImpl()
+{
+	int nErrorCount = 0;
+
+	TestObject::Reset();
+
+	{
+		typedef safememory::unordered_map<int, TestObject, safememory::hash<int>, safememory::equal_to<int>, Safety> Map;
+		Map m;
+		EATEST_VERIFY(m.node_pool_size() == 0);
+#if defined(NODECPP_SAFE_PTR_USE_ON_STACK_OPTIMIZATION) || defined(SAFEMEMORY_DEZOMBIEFY_ITERATORS)
+		if(Safety == safememory::memory_safety::safe)
+		{
+			// pool is disabled, erased nodes are deallocated
+			m.node_pool_capacity(10);
+			m.emplace(1, TestObject(1));
+			m.erase(1);
+			EATEST_VERIFY(m.node_pool_capacity() == 0);
+			EATEST_VERIFY(m.node_pool_size() == 0);
+			return nErrorCount;
+		}
+#endif
+		EATEST_VERIFY(m.node_pool_capacity() == SAFEMEMORY_HASHTABLE_NODE_POOL_CAPACITY);
+
+		for(int i = 0; i < 100; i++)
+			m.emplace(i, TestObject(i));
+
+		// erased node goes to the pool, and is reused by next insert
+		const TestObject* p = &m.find(7)->second;
+		m.erase(7);
+		EATEST_VERIFY(m.node_pool_size() == 1);
+		m.emplace(1000, TestObject(1000));
+		EATEST_VERIFY(m.node_pool_size() == 0);
+		EATEST_VERIFY(&m.find(1000)->second == p);
+		EATEST_VERIFY(m.find(1000)->second.mX == 1000);
+
+		// pool doesn't grow over capacity
+		m.node_pool_capacity(10);
+		for(int i = 0; i < 50; i++)
+			m.erase(i);
+		EATEST_VERIFY(m.node_pool_size() == 10);
+		EATEST_VERIFY(m.size() == 51);
+
+		m.node_pool_capacity(4);
+		EATEST_VERIFY(m.node_pool_size() == 4);
+
+		// copies start with an empty pool
+		Map m2(m);
+		EATEST_VERIFY(m2.node_pool_size() == 0);
+		EATEST_VERIFY(m2.node_pool_capacity() == 4);
+		EATEST_VERIFY(m2 == m);
+
+		m.swap(m2);
+		EATEST_VERIFY(m2 == m);
+		m2.clear();
+		EATEST_VERIFY(m2.node_pool_size() == 4);
+
+		m.node_pool_capacity(0);
+		m.erase(60);
+		EATEST_VERIFY(m.node_pool_size() == 0);
+		EATEST_VERIFY(m.validate());
+	}
+
+	// pooled nodes are released with the container
+	EATEST_VERIFY(TestObject::IsClear());
+	TestObject::Reset();
+
+	{
+		typedef safememory::unordered_multiset<int, safememory::hash<int>, safememory::equal_to<int>, Safety> Set;
+		Set s;
+		for(int i = 0; i < 1000; i++)
+		{
+			s.insert(i % 10);
+			if(s.size() > 20)
+				s.erase(s.begin());
+		}
+		EATEST_VERIFY(s.size() == 20);
+		EATEST_VERIFY(s.node_pool_size() == 1);
+		EATEST_VERIFY(s.validate());
+	}
+
+	return nErrorCount;
+}
+
+
+int TestHashNodePool()
+{
+	int nErrorCount = 0;
+
+	nErrorCount += TestHashNodePoolImpl<safememory::memory_safety::safe>();
+	nErrorCount += TestHashNodePoolImpl<safememory::memory_safety::none>();
+
+#if EASTL_EXCEPTIONS_ENABLED && !defined(NODECPP_SAFE_PTR_USE_ON_STACK_OPTIMIZATION)
+	{
+		// safe iterator to an erased element is invalidated, even after the node was recycled
+		safememory::unordered_map<int, int> m;
+		for(int i = 0; i < 10; i++)
+			m[i] = i;
+
+		auto it = m.find_safe(5);
+		EATEST_VERIFY(it->second == 5);
+		m.erase(5);
+		m[100] = 100;
+		EATEST_VERIFY(m.node_pool_size() == 0);
+
+		try
+		{
+			int x = it->second;
+			EATEST_VERIFY(x == -1);  // Should not get here, as exception thrown.
+		}
+		catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+		catch (...) { EATEST_VERIFY(false); }
+
+		// a new iterator to the recycled node works
+		auto it2 = m.find_safe(100);
+		EATEST_VERIFY(it2->second == 100);
+		m.erase_safe(it2);
+		try
+		{
+			int x = it2->second;
+			EATEST_VERIFY(x == -1);  // Should not get here, as exception thrown.
+		}
+		catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+		catch (...) { EATEST_VERIFY(false); }
+	}
+#endif
+
+	return nErrorCount;
+}
+
+
+int TestHashStackOnly()
+{
+	int nErrorCount = 0;
+
+	TestObject::Reset();
+
+	{
+		safememory::unordered_map_safe<int, TestObject> m;
+
+		EATEST_VERIFY(m.try_emplace_stack_only(1, 1).second);
+		EATEST_VERIFY(!m.try_emplace_stack_only(1, 2).second);
+		EATEST_VERIFY(m.emplace_stack_only(2, TestObject(2)).second);
+		EATEST_VERIFY(m.insert_stack_only(eastl::make_pair(3, TestObject(3))).second);
+
+		int k = 4;
+		auto r = m.try_emplace_stack_only(std::move(k), 4);
+		EATEST_VERIFY(r.second && r.first->second.mX == 4);
+
+		EATEST_VERIFY(!m.insert_or_assign_stack_only(1, TestObject(10)).second);
+		EATEST_VERIFY(m.insert_or_assign_stack_only(5, TestObject(5)).second);
+		EATEST_VERIFY(m.find(1)->second.mX == 10);
+		EATEST_VERIFY(m.size() == 5);
+
+		// regular iterator can be made safe when it has to be stored
+		safememory::unordered_map_safe<int, TestObject>::iterator it = m.make_safe(r.first);
+		EATEST_VERIFY(it->second.mX == 4);
+		EATEST_VERIFY(m.validate());
+	}
+
+	EATEST_VERIFY(TestObject::IsClear());
+	TestObject::Reset();
+
+	{
+		safememory::unordered_set_safe<int> s;
+		EATEST_VERIFY(s.insert_stack_only(1).second);
+		EATEST_VERIFY(!s.insert_stack_only(1).second);
+		EATEST_VERIFY(s.emplace_stack_only(2).second);
+		EATEST_VERIFY(*s.emplace_stack_only(2).first == 2);
+		EATEST_VERIFY(s.size() == 2);
+	}
+
+	return nErrorCount;
+}
+
+
+template<safememory::memory_safety Safety>
+int TestHashForEachImpl()
+{
+	int nErrorCount = 0;
+
+	{
+		safememory::unordered_map<int, int, safememory::hash<int>, safememory::equal_to<int>, Safety> m;
+		int count = 0;
+		m.for_each([&count](auto&) { ++count; });
+		EATEST_VERIFY(count == 0);
+
+		for(int i = 0; i < 1000; ++i)
+			m.insert(eastl::make_pair(i, i));
+
+		int sum = 0;
+		m.for_each([&](eastl::pair<const int, int>& v) { sum += v.first; ++v.second; ++count; });
+		EATEST_VERIFY(count == 1000 && sum == 999 * 1000 / 2);
+		EATEST_VERIFY(m.at(0) == 1 && m.at(999) == 1000);
+
+		const auto& cm = m;
+		sum = 0;
+		cm.for_each([&sum](const eastl::pair<const int, int>& v) { sum += v.second; });
+		EATEST_VERIFY(sum == 1000 * 1001 / 2);
+
+	#if EASTL_EXCEPTIONS_ENABLED
+		if constexpr (Safety == safememory::memory_safety::safe) {
+			try
+			{
+				m.for_each([&m](auto& v) { if(v.first == 500) m.erase(501); });
+				EATEST_VERIFY(false);  // Should not get here, as exception thrown.
+			}
+			catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+			catch (...) { EATEST_VERIFY(false); }
+		}
+	#endif
+	}
+
+#if EASTL_EXCEPTIONS_ENABLED
+	if constexpr (Safety == safememory::memory_safety::safe) {
+		// erase and insert the same number of elements, size and buckets don't change,
+		// but the next node may be released or recycled
+		safememory::unordered_map<int, int, safememory::hash<int>, safememory::equal_to<int>, Safety> m;
+		m.reserve(1000);
+		for(int i = 0; i < 100; ++i)
+			m.insert(eastl::make_pair(i, i));
+
+		const auto bucketCount = m.bucket_count();
+		bool done = false;
+		try
+		{
+			m.for_each([&](auto& v) {
+				if(done)
+					return;
+				done = true;
+				for(int i = 0; i < 100; ++i) {
+					if(i != v.first) {
+						m.erase(i);
+						m.insert(eastl::make_pair(i + 1000, i));
+					}
+				}
+			});
+			EATEST_VERIFY(false);  // Should not get here, as exception thrown.
+		}
+		catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+		catch (...) { EATEST_VERIFY(false); }
+		EATEST_VERIFY(done && m.size() == 100 && m.bucket_count() == bucketCount);
+		EATEST_VERIFY(m.validate());
+	}
+#endif
+
+	{
+		safememory::unordered_multiset<int, safememory::hash<int>, safememory::equal_to<int>, Safety> s = { 1, 2, 2, 3 };
+		int sum = 0;
+		s.for_each([&sum](const int& v) { sum += v; });
+		EATEST_VERIFY(sum == 8);
+	}
+
+	return nErrorCount;
+}
+
+int TestHashForEach()
+{
+	int nErrorCount = 0;
+
+	nErrorCount += TestHashForEachImpl<safememory::memory_safety::safe>();
+	nErrorCount += TestHashForEachImpl<safememory::memory_safety::none>();
+
+	return nErrorCount;
+}
+
+
 int TestHash()
 {
 	int nErrorCount = 0;
@@ -1583,6 +1981,11 @@ int TestHash()
 
 	nErrorCount += TestHashMultiMap<MMAP, MMAP4>();
 
+	nErrorCount += TestHashRehashPolicy();
+	nErrorCount += TestHashNodePool();
+	nErrorCount += TestHashStackOnly();
+	nErrorCount += TestHashForEach();
+
 	return nErrorCount;
 }
 
@@ -0,0 +1,325 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+
+#include "EASTLTest.h"
+#include "TestMap.h"
+#include <safememory/map.h>
+#include <map>
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <cstring>
+#include <string>
+
+
+// Template instantations.
+// These tell the compiler to compile all the functions for the given class.
+template class safememory::map<int, int>;
+template class safememory::map<TestObject, TestObject>;
+template class safememory::map_safe<int, int>;
+
+
+template <typename Key, typename T>
+using MAP = safememory::map<Key, T>;
+
+template <typename Key, typename T>
+using MAP_SAFE = safememory::map_safe<Key, T>;
+
+
+///////////////////////////////////////////////////////////////////////////////
+// TestMapCompareStd
+//
+// Random inserts and erases, checking against std::map after each step.
+// Enough elements are used to get a few levels of inner nodes.
+//
+template <typename T1>
+int TestMapCompareStd()
+{
+	int nErrorCount = 0;
+
+	TestObject::Reset();
+
+	{
+		T1 t1;
+		std::map<int, int> t2;
+
+		std::vector<int> keys;
+		for(int i = 0; i < 5000; i++)
+			keys.push_back(i);
+
+		std::mt19937 rng(GetRandSeed());
+
+		for(int p = 0; p < 3; p++)
+		{
+			std::shuffle(keys.begin(), keys.end(), rng);
+
+			for(size_t i = 0; i < keys.size(); i++)
+			{
+				auto r1 = t1.insert(typename T1::value_type(keys[i], TestObject(keys[i])));
+				auto r2 = t2.insert(std::make_pair(keys[i], keys[i]));
+				EATEST_VERIFY(r1.second == r2.second);
+				EATEST_VERIFY(r1.first->first == keys[i]);
+			}
+			EATEST_VERIFY(t1.validate());
+			EATEST_VERIFY(t1.size() == t2.size());
+			EATEST_VERIFY(std::equal(t1.begin(), t1.end(), t2.begin(),
+				[](const typename T1::value_type& a, const std::pair<const int, int>& b) { return a.first == b.first && a.second.mX == b.second; }));
+
+			// erase half of them, by key and by iterator
+			for(size_t i = 0; i < keys.size() / 2; i++)
+			{
+				if(i % 2)
+				{
+					EATEST_VERIFY(t1.erase(keys[i]) == t2.erase(keys[i]));
+				}
+				else
+				{
+					auto it1 = t1.erase(t1.find(keys[i]));
+					auto it2 = t2.erase(t2.find(keys[i]));
+					EATEST_VERIFY((it1 == t1.end()) == (it2 == t2.end()));
+					if(it2 != t2.end())
+						EATEST_VERIFY(it1->first == it2->first);
+				}
+			}
+			EATEST_VERIFY(t1.validate());
+			EATEST_VERIFY(t1.size() == t2.size());
+			EATEST_VERIFY(std::equal(t1.begin(), t1.end(), t2.begin(),
+				[](const typename T1::value_type& a, const std::pair<const int, int>& b) { return a.first == b.first && a.second.mX == b.second; }));
+
+			// erase a range in the middle
+			auto first1 = t1.lower_bound(1000);
+			auto last1 = t1.lower_bound(3000);
+			auto res1 = t1.erase(first1, last1);
+			t2.erase(t2.lower_bound(1000), t2.lower_bound(3000));
+			EATEST_VERIFY(t1.validate());
+			EATEST_VERIFY(t1.size() == t2.size());
+			EATEST_VERIFY(res1 == t1.lower_bound(3000));
+
+			// backwards iteration
+			auto r2 = t2.rbegin();
+			for(auto it = t1.end(); it != t1.begin(); ++r2)
+			{
+				--it;
+				EATEST_VERIFY(it->first == r2->first);
+			}
+		}
+
+		t1.clear();
+		EATEST_VERIFY(t1.validate());
+		EATEST_VERIFY(t1.empty());
+		EATEST_VERIFY(t1.begin() == t1.end());
+	}
+
+	EATEST_VERIFY(TestObject::IsClear());
+	TestObject::Reset();
+
+	return nErrorCount;
+}
+
+
+template <template<typename, typename> class MAP>
+int TestMapImpl()
+{
+	int nErrorCount = 0;
+
+	{
+		// C++11 emplace and related functionality
+		nErrorCount += TestMapCpp11<MAP<int, TestObject>>();
+	}
+
+	{
+		// C++17 try_emplace and related functionality
+		nErrorCount += TestMapCpp17<MAP<int, TestObject>>();
+	}
+
+	nErrorCount += TestMapCompareStd<MAP<int, TestObject>>();
+
+	{
+		// ascending and descending inserts leave nodes full
+		MAP<int, int> m1;
+		for(int i = 0; i < 10000; i++)
+			m1.insert({i, i});
+		EATEST_VERIFY(m1.validate());
+		EATEST_VERIFY(m1.size() == 10000);
+
+		MAP<int, int> m2;
+		for(int i = 10000; i > 0; i--)
+			m2.emplace(i, i);
+		EATEST_VERIFY(m2.validate());
+		EATEST_VERIFY(m2.size() == 10000);
+
+		// copy, move and compare
+		MAP<int, int> m3(m1);
+		EATEST_VERIFY(m3.validate());
+		EATEST_VERIFY(m3 == m1);
+		EATEST_VERIFY(m3 != m2);
+
+		MAP<int, int> m4(std::move(m3));
+		EATEST_VERIFY(m4 == m1);
+		EATEST_VERIFY(m3.empty());
+
+		m3 = m2;
+		EATEST_VERIFY(m3 == m2);
+		m3.swap(m4);
+		EATEST_VERIFY(m3 == m1);
+		EATEST_VERIFY(m4 == m2);
+	}
+
+	{
+		// search
+		MAP<int, int> m;
+		for(int i = 0; i < 1000; i += 2)
+			m[i] = i;
+
+		EATEST_VERIFY(m.find(-1) == m.end());
+		EATEST_VERIFY(m.find(1) == m.end());
+		EATEST_VERIFY(m.find(998)->second == 998);
+		EATEST_VERIFY(m.lower_bound(-1) == m.begin());
+		EATEST_VERIFY(m.lower_bound(5)->first == 6);
+		EATEST_VERIFY(m.lower_bound(6)->first == 6);
+		EATEST_VERIFY(m.upper_bound(6)->first == 8);
+		EATEST_VERIFY(m.upper_bound(998) == m.end());
+		EATEST_VERIFY(m.count(10) == 1);
+		EATEST_VERIFY(m.count(11) == 0);
+		EATEST_VERIFY(m.at(500) == 500);
+
+		auto er = m.equal_range(500);
+		EATEST_VERIFY(er.first->first == 500);
+		EATEST_VERIFY(er.second->first == 502);
+		er = m.equal_range(501);
+		EATEST_VERIFY(er.first == er.second);
+
+		int n = 0;
+		for(auto it = m.lower_bound(100), itEnd = m.lower_bound(200); it != itEnd; ++it)
+			++n;
+		EATEST_VERIFY(n == 50);
+	}
+
+	{
+		// zeroed instance is a valid empty map
+		alignas(MAP<int, int>) char buff[sizeof(MAP<int, int>)];
+		memset(buff, 0, sizeof(buff));
+		MAP<int, int>& m = *reinterpret_cast<MAP<int, int>*>(buff);
+
+		EATEST_VERIFY(m.empty());
+		EATEST_VERIFY(m.begin() == m.end());
+		EATEST_VERIFY(m.find(5) == m.end());
+		EATEST_VERIFY(m.validate());
+		m[5] = 5;
+		EATEST_VERIFY(m.size() == 1);
+		m.~MAP<int, int>();
+		EATEST_VERIFY(m.empty());
+	}
+
+#if EASTL_EXCEPTIONS_ENABLED
+	{
+		MAP<int, int> m;
+		try
+		{
+			int& r = m.at(6);
+			EATEST_VERIFY(r == -1);  // Should not get here, as exception thrown.
+		}
+		catch (std::out_of_range&) { EATEST_VERIFY(true); }
+		catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+		catch (...) { EATEST_VERIFY(false); }
+
+		try
+		{
+			auto it = m.end();
+			EATEST_VERIFY(it->first == -1);  // Should not get here, as exception thrown.
+		}
+		catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+		catch (...) { EATEST_VERIFY(false); }
+
+		m[1] = 1;
+		try
+		{
+			auto it = m.end();
+			EATEST_VERIFY(it->first == -1);  // Should not get here, as exception thrown.
+		}
+		catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+		catch (...) { EATEST_VERIFY(false); }
+	}
+#endif
+
+	return nErrorCount;
+}
+
+
+int TestMap()
+{
+	int nErrorCount = 0;
+
+	nErrorCount += TestMapImpl<MAP>();
+	nErrorCount += TestMapImpl<MAP_SAFE>();
+
+#if EASTL_EXCEPTIONS_ENABLED
+	{
+		// heap safe iterators check position against the node they point to
+		safememory::map<int, int> m = {{1, 1}, {2, 2}, {3, 3}};
+
+		auto it = m.end_safe();
+		try
+		{
+			int x = it->second;
+			EATEST_VERIFY(x == -1);  // Should not get here, as exception thrown.
+		}
+		catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+		catch (...) { EATEST_VERIFY(false); }
+
+		// erase shrinks the node, a stale iterator to its last value is detected
+		auto last = m.end_safe();
+		--last;
+		EATEST_VERIFY(last->first == 3);
+		m.erase(3);
+		try
+		{
+			int x = last->second;
+			EATEST_VERIFY(x == -1);  // Should not get here, as exception thrown.
+		}
+		catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+		catch (...) { EATEST_VERIFY(false); }
+
+		// a stale iterator past the node count can't start or end a range
+		m.erase(2);
+		try
+		{
+			m.erase_safe(last, m.end_safe());
+			EATEST_VERIFY(false);  // Should not get here, as exception thrown.
+		}
+		catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+		catch (...) { EATEST_VERIFY(false); }
+
+		try
+		{
+			m.erase_safe(m.begin_safe(), last);
+			EATEST_VERIFY(false);  // Should not get here, as exception thrown.
+		}
+		catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+		catch (...) { EATEST_VERIFY(false); }
+		EATEST_VERIFY(m.size() == 1);
+	}
+#endif
+
+	{
+		// arguments referring to values in the same map are read before any value is moved
+		safememory::map<int, std::string> m;
+		const std::string s(64, 'x');
+		for(int i = 0; i < 1000; i += 2)
+			m.try_emplace(i, s);
+
+		bool ok = true;
+		for(int i = 1; i < 1000; i += 4)
+		{
+			m.try_emplace(i, m.at(i + 1));
+			m.insert_or_assign(i + 2, m.at(i - 1));
+			ok = ok && m.at(i) == s && m.at(i + 2) == s;
+		}
+		EATEST_VERIFY(ok);
+		EATEST_VERIFY(m.validate());
+	}
+
+	return nErrorCount;
+}
@@ -0,0 +1,145 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+
+#include "EASTLTest.h"
+#include <safememory/ring_buffer.h>
+#include <deque>
+#include <cstring>
+
+
+// Template instantations.
+// These tell the compiler to compile all the functions for the given class.
+template class safememory::ring_buffer<int>;
+template class safememory::ring_buffer<TestObject>;
+template class safememory::ring_buffer<int, safememory::memory_safety::none>;
+
+
+int TestRingBuffer()
+{
+	int nErrorCount = 0;
+
+	TestObject::Reset();
+
+	{
+		// push_back on a full buffer overwrites the front, as a sliding window
+		safememory::ring_buffer<TestObject> rb(10);
+		std::deque<int> window;
+
+		EATEST_VERIFY(rb.empty());
+		EATEST_VERIFY(rb.capacity() == 10);
+
+		for(int i = 0; i < 1000; i++)
+		{
+			rb.push_back(TestObject(i));
+			window.push_back(i);
+			if(window.size() > 10)
+				window.pop_front();
+
+			EATEST_VERIFY(rb.size() == window.size());
+			EATEST_VERIFY(rb.front().mX == window.front());
+			EATEST_VERIFY(rb.back().mX == i);
+		}
+
+		EATEST_VERIFY(rb.full());
+		EATEST_VERIFY(rb.capacity() == 10);
+		EATEST_VERIFY(std::equal(rb.begin(), rb.end(), window.begin(),
+			[](const TestObject& a, int b) { return a.mX == b; }));
+		EATEST_VERIFY(std::equal(rb.rbegin(), rb.rend(), window.rbegin(),
+			[](const TestObject& a, int b) { return a.mX == b; }));
+		EATEST_VERIFY(std::equal(rb.begin_safe(), rb.end_safe(), window.begin(),
+			[](const TestObject& a, int b) { return a.mX == b; }));
+
+		for(size_t i = 0; i < window.size(); i++)
+			EATEST_VERIFY(rb[i].mX == window[i]);
+
+		// push_front on a full buffer overwrites the back
+		rb.push_front(TestObject(-1));
+		EATEST_VERIFY(rb.size() == 10);
+		EATEST_VERIFY(rb.front().mX == -1);
+		EATEST_VERIFY(rb.back().mX == 998);
+
+		rb.pop_front();
+		rb.pop_back();
+		EATEST_VERIFY(rb.size() == 8);
+		EATEST_VERIFY(rb.front().mX == 990 && rb.back().mX == 997);
+
+		// shrinking capacity drops the oldest elements
+		rb.set_capacity(4);
+		EATEST_VERIFY(rb.capacity() == 4 && rb.size() == 4);
+		EATEST_VERIFY(rb.front().mX == 994 && rb.back().mX == 997);
+
+		rb.reserve(2);
+		EATEST_VERIFY(rb.capacity() == 4);
+		rb.reserve(8);
+		EATEST_VERIFY(rb.capacity() == 8 && rb.size() == 4);
+
+		safememory::ring_buffer<TestObject> rb2(rb);
+		EATEST_VERIFY(rb2 == rb);
+		rb2.push_back(TestObject(0));
+		EATEST_VERIFY(rb2 != rb);
+
+		rb.clear();
+		EATEST_VERIFY(rb.empty());
+		EATEST_VERIFY(rb.capacity() == 8);
+	}
+
+	EATEST_VERIFY(TestObject::IsClear());
+	TestObject::Reset();
+
+	{
+		safememory::ring_buffer<int> rb = {1, 2, 3};
+		EATEST_VERIFY(rb.full());
+		rb.push_back(rb.front());
+		EATEST_VERIFY(rb[0] == 2 && rb[1] == 3 && rb[2] == 1);
+	}
+
+	{
+		// zeroed instance is a valid buffer with zero capacity, that discards pushes
+		typedef safememory::ring_buffer<int> RingInt;
+		alignas(RingInt) char buff[sizeof(RingInt)];
+		memset(buff, 0, sizeof(buff));
+		RingInt* rb = reinterpret_cast<RingInt*>(buff);
+
+		EATEST_VERIFY(rb->empty());
+		EATEST_VERIFY(rb->begin() == rb->end());
+		rb->push_back(1);
+		rb->push_front(1);
+		EATEST_VERIFY(rb->empty());
+		rb->~RingInt();
+	}
+
+#if EASTL_EXCEPTIONS_ENABLED
+	{
+		safememory::ring_buffer<int> rb(4);
+		try
+		{
+			rb.pop_back();
+			EATEST_VERIFY(false);  // Should not get here, as exception thrown.
+		}
+		catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+		catch (...) { EATEST_VERIFY(false); }
+
+		rb.push_back(1);
+		auto it = rb.begin_safe();
+		EATEST_VERIFY(*it == 1);
+
+		// overwriting doesn't reallocate, iterator still points inside the buffer
+		for(int i = 0; i < 10; i++)
+			rb.push_back(i);
+		EATEST_VERIFY(*it == 7);
+
+		rb.set_capacity(2);
+		try
+		{
+			int x = *it;
+			EATEST_VERIFY(x == -1);  // Should not get here, as exception thrown.
+		}
+		catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+		catch (...) { EATEST_VERIFY(false); }
+	}
+#endif
+
+	return nErrorCount;
+}
@@ -0,0 +1,102 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+
+#include "EASTLTest.h"
+#include <safememory/set.h>
+#include "TestSet.h"
+#include <set>
+#include <vector>
+#include <algorithm>
+#include <random>
+
+
+// Template instantations.
+// These tell the compiler to compile all the functions for the given class.
+template class safememory::set<int>;
+template class safememory::set<TestObject>;
+template class safememory::set_safe<int>;
+
+
+template <typename Key>
+using SET = safememory::set<Key>;
+
+template <typename Key>
+using SET_SAFE = safememory::set_safe<Key>;
+
+
+template <template<typename> class SET>
+int TestSetImpl()
+{
+	int nErrorCount = 0;
+
+	{
+		// C++11 emplace and related functionality
+		nErrorCount += TestSetCpp11<SET<TestObject>>();
+	}
+
+	TestObject::Reset();
+
+	{
+		SET<int> t1;
+		std::set<int> t2;
+
+		std::vector<int> keys;
+		for(int i = 0; i < 3000; i++)
+			keys.push_back(i % 2000);
+
+		std::mt19937 rng(GetRandSeed());
+		std::shuffle(keys.begin(), keys.end(), rng);
+
+		for(size_t i = 0; i < keys.size(); i++)
+		{
+			auto r1 = t1.insert(keys[i]);
+			auto r2 = t2.insert(keys[i]);
+			EATEST_VERIFY(r1.second == r2.second);
+			EATEST_VERIFY(*r1.first == keys[i]);
+		}
+		EATEST_VERIFY(t1.validate());
+		EATEST_VERIFY(t1.size() == t2.size());
+		EATEST_VERIFY(std::equal(t1.begin(), t1.end(), t2.begin()));
+
+		for(size_t i = 0; i < keys.size(); i += 2)
+			EATEST_VERIFY(t1.erase(keys[i]) == t2.erase(keys[i]));
+
+		EATEST_VERIFY(t1.validate());
+		EATEST_VERIFY(t1.size() == t2.size());
+		EATEST_VERIFY(std::equal(t1.begin(), t1.end(), t2.begin()));
+
+		EATEST_VERIFY(*t1.lower_bound(*t2.begin()) == *t2.begin());
+		EATEST_VERIFY(t1.upper_bound(*t2.rbegin()) == t1.end());
+		EATEST_VERIFY(t1.contains(*t2.begin()));
+
+		t1.erase(t1.begin(), t1.end());
+		EATEST_VERIFY(t1.validate());
+		EATEST_VERIFY(t1.empty());
+	}
+
+	{
+		SET<int> s = { 3, 1, 2, 3 };
+		EATEST_VERIFY(s.size() == 3);
+		EATEST_VERIFY(*s.begin() == 1);
+		auto it = s.end();
+		EATEST_VERIFY(*--it == 3);
+	}
+
+	EATEST_VERIFY(TestObject::IsClear());
+	TestObject::Reset();
+
+	return nErrorCount;
+}
+
+
+int TestSet()
+{
+	int nErrorCount = 0;
+
+	nErrorCount += TestSetImpl<SET>();
+	nErrorCount += TestSetImpl<SET_SAFE>();
+
+	return nErrorCount;
+}
@@ -0,0 +1,211 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+
+#include "EASTLTest.h"
+#include <safememory/stable_vector.h>
+#include <safememory/string.h>
+#include <vector>
+#include <random>
+#include <algorithm>
+
+
+// Template instantations.
+// These tell the compiler to compile all the functions for the given class.
+template class safememory::stable_vector<int>;
+template class safememory::stable_vector<TestObject>;
+template class safememory::stable_vector<int, safememory::memory_safety::none>;
+
+
+///////////////////////////////////////////////////////////////////////////////
+// TestStableVectorCompare
+//
+// Random inserts and erases, checking against a std::vector of handle and value.
+// Enough operations are done to add several chunks and reuse slots.
+//
+template <typename T1>
+int TestStableVectorCompare()
+{
+	int nErrorCount = 0;
+
+	TestObject::Reset();
+
+	{
+		T1 t1;
+		std::vector<std::pair<safememory::stable_vector_handle, int>> t2;
+		std::vector<safememory::stable_vector_handle> erased;
+
+		std::mt19937 rng(GetRandSeed());
+
+		for(int i = 0; i < 20000; i++)
+		{
+			if(rng() % 3 != 0 || t2.empty())
+			{
+				auto h = t1.insert(TestObject(i));
+				t2.push_back({h, i});
+			}
+			else
+			{
+				size_t pos = rng() % t2.size();
+				EATEST_VERIFY(t1.erase(t2[pos].first) == 1);
+				erased.push_back(t2[pos].first);
+				t2.erase(t2.begin() + pos);
+			}
+		}
+
+		EATEST_VERIFY(t1.size() == t2.size());
+		EATEST_VERIFY(t1.capacity() >= t1.size());
+
+		for(const auto& each : t2)
+		{
+			EATEST_VERIFY(t1.contains(each.first));
+			EATEST_VERIFY(t1[each.first].mX == each.second);
+			EATEST_VERIFY(t1.at(each.first).mX == each.second);
+			EATEST_VERIFY(t1.find(each.first)->mX == each.second);
+		}
+
+		// erased handles never match again, even when the slot was reused
+		for(const auto& each : erased)
+		{
+			EATEST_VERIFY(!t1.contains(each));
+			EATEST_VERIFY(t1.find(each) == t1.end());
+			EATEST_VERIFY(t1.erase(each) == 0);
+		}
+
+		// iteration visits every element once, with its handle
+		size_t n = 0;
+		for(auto it = t1.begin(); it != t1.end(); ++it, ++n)
+			EATEST_VERIFY(t1[it.get_handle()].mX == it->mX);
+		EATEST_VERIFY(n == t2.size());
+
+		// copy keeps handles
+		T1 t3(t1);
+		EATEST_VERIFY(t3.size() == t1.size());
+		for(const auto& each : t2)
+			EATEST_VERIFY(t3[each.first].mX == each.second);
+		for(const auto& each : erased)
+			EATEST_VERIFY(!t3.contains(each));
+
+		// erase while iterating
+		for(auto it = t3.begin(); it != t3.end(); )
+		{
+			if(it->mX % 2)
+				it = t3.erase(it);
+			else
+				++it;
+		}
+		for(const auto& each : t2)
+			EATEST_VERIFY(t3.contains(each.first) == (each.second % 2 == 0));
+
+		// clear invalidates all handles but keeps chunks
+		auto cap = t1.capacity();
+		t1.clear();
+		EATEST_VERIFY(t1.empty() && t1.capacity() == cap);
+		for(const auto& each : t2)
+			EATEST_VERIFY(!t1.contains(each.first));
+		EATEST_VERIFY(t1.begin() == t1.end());
+	}
+
+	EATEST_VERIFY(TestObject::IsClear());
+	TestObject::Reset();
+
+	return nErrorCount;
+}
+
+
+int TestStableVector()
+{
+	int nErrorCount = 0;
+
+	nErrorCount += TestStableVectorCompare<safememory::stable_vector<TestObject>>();
+	nErrorCount += TestStableVectorCompare<safememory::stable_vector<TestObject, safememory::memory_safety::none>>();
+
+	{
+		// elements never move, while the handle stays valid its element is at the same address
+		safememory::stable_vector<safememory::string> sv;
+		auto h = sv.emplace("abc");
+		const safememory::string* p = &sv[h];
+
+		std::vector<safememory::stable_vector_handle> all;
+		for(int i = 0; i < 1000; i++)
+			all.push_back(sv.emplace(safememory::to_string(i)));
+
+		EATEST_VERIFY(&sv[h] == p);
+		EATEST_VERIFY(sv[h] == "abc");
+		EATEST_VERIFY(sv[all[999]] == "999");
+
+		safememory::stable_vector<safememory::string> sv2;
+		sv2 = std::move(sv);
+		EATEST_VERIFY(sv.empty() && sv.begin() == sv.end());
+		EATEST_VERIFY(&sv2[h] == p);
+	}
+
+	{
+		// a default constructed handle is never valid
+		safememory::stable_vector<int> sv;
+		sv.insert(1);
+		EATEST_VERIFY(!sv.contains(safememory::stable_vector_handle()));
+		EATEST_VERIFY(*sv.begin() == 1);
+		EATEST_VERIFY(sv.begin().get_handle() != safememory::stable_vector_handle());
+
+		// a handle doesn't know its container, same slot and generation name an element here
+		safememory::stable_vector<int> other;
+		other.insert(2);
+		EATEST_VERIFY(other[sv.begin().get_handle()] == 2);
+	}
+
+#if EASTL_EXCEPTIONS_ENABLED
+	{
+		safememory::stable_vector<int> sv;
+		auto h = sv.insert(1);
+		sv.erase(h);
+		try
+		{
+			int x = sv[h];
+			EATEST_VERIFY(x == -1);  // Should not get here, as exception thrown.
+		}
+		catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+		catch (...) { EATEST_VERIFY(false); }
+
+		try
+		{
+			int x = sv.at(h);
+			EATEST_VERIFY(x == -1);  // Should not get here, as exception thrown.
+		}
+		catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+		catch (...) { EATEST_VERIFY(false); }
+
+		// iterator from another container
+		safememory::stable_vector<int> other;
+		other.insert(2);
+		try
+		{
+			sv.erase(other.begin());
+			EATEST_VERIFY(false);  // Should not get here, as exception thrown.
+		}
+		catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+		catch (...) { EATEST_VERIFY(false); }
+
+		// default constructed iterator has no container
+		safememory::stable_vector<int>::iterator it;
+		try
+		{
+			++it;
+			EATEST_VERIFY(false);  // Should not get here, as exception thrown.
+		}
+		catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+		catch (...) { EATEST_VERIFY(false); }
+
+		try
+		{
+			int x = *it;
+			EATEST_VERIFY(x == -1);  // Should not get here, as exception thrown.
+		}
+		catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+		catch (...) { EATEST_VERIFY(false); }
+	}
+#endif
+
+	return nErrorCount;
+}
@@ -8,9 +8,15 @@
 //#include <EAStdC/EAString.h>
 #include <string>
 #include <algorithm>
+#include <climits>
 //#include <EASTL/allocator_malloc.h>
 #include <safememory/string.h>
 #include <safememory/string_literal.h>
+#include <safememory/unordered_map.h>
+#include <safememory/vector.h>
+#include <safememory/string_format.h>
+#include <safememory/literal_switch.h>
+#include <safememory/string_view.h>
 
 // namespace safememory {
 // 	template<class T, class Alloc>
@@ -70,6 +76,60 @@ int TestToString() {
 #endif
 	}
 
+	// to_string matches sprintf at the limits
+	{
+		VERIFY(safememory::to_string(0) == "0");
+		VERIFY(safememory::to_string(-1) == "-1");
+		VERIFY(safememory::to_string(INT_MIN) == "-2147483648");
+		VERIFY(safememory::to_string(LLONG_MIN) == "-9223372036854775808");
+		VERIFY(safememory::to_string(ULLONG_MAX) == "18446744073709551615");
+		VERIFY(safememory::to_string(-0.5) == "-0.500000");
+		VERIFY(safememory::to_string(1e20) == "100000000000000000000.000000");
+
+		for(int i = 0; i < 1000; i++)
+		{
+			unsigned long long v = 1ull << (i % 64);
+			v += i;
+			char buff[32];
+			sprintf(buff, "%llu", v);
+			VERIFY(strcmp(safememory::to_string(v).c_str(), buff) == 0);
+			sprintf(buff, "%lld", -(long long)v);
+			VERIFY(strcmp(safememory::to_string(-(long long)v).c_str(), buff) == 0);
+		}
+	}
+
+	// append_number
+	{
+		safememory::string s("id=");
+		auto cap = s.capacity();
+		s.append_number(42).append(1, ' ').append_number(-7).append(1, ' ').append_number(2.5);
+		VERIFY(s == "id=42 -7 2.5");
+		// result fits, no reallocation
+		VERIFY(s.capacity() == cap);
+
+		s.clear();
+		s.append_number(0.1);
+		VERIFY(s == "0.1");
+
+		s.clear();
+		s.append_number(3.141592653589793);
+		VERIFY(s == "3.141592653589793");
+
+		s.clear();
+		s.append_number(1e300, std::chars_format::scientific);
+		VERIFY(s == "1e+300");
+
+		s.clear();
+		s.append_number(1e300, std::chars_format::fixed, 2);
+		VERIFY(s.size() == 304);
+		VERIFY(s.find(".00") == 301);
+
+		safememory::basic_string<char, safememory::memory_safety::none> u;
+		u.append_number(uint8_t(255)).append_number(int16_t(-32768));
+		VERIFY(u == "255-32768");
+	}
+
+
 	// to_wstring
 // 	{
 // 		VERIFY(safememory::to_wstring(42)    == L"42");
@@ -89,6 +149,355 @@ int TestToString() {
 }
 
 
+struct StringHolder
+{
+	safememory::string s;
+	StringHolder(const char* str) : s(str) {}
+};
+
+struct StringIteratorHolder
+{
+	safememory::string::const_iterator_safe it;
+	StringIteratorHolder(const char* str) {
+		// a local in the constructor of an owned object is not part of it
+		safememory::string local(str);
+		it = local.cbegin_safe();
+	}
+};
+
+int TestStringSsoIterators() {
+
+	int nErrorCount = 0;
+
+	{
+		// string inside an owned object keeps its SSO buffer
+		auto h = safememory::make_owning<StringHolder>("abc");
+		auto cap = h->s.capacity();
+		const char* p = h->s.c_str();
+
+		auto it = h->s.begin_safe();
+		EATEST_VERIFY(h->s.capacity() == cap);
+		EATEST_VERIFY(h->s.c_str() == p);
+		EATEST_VERIFY(*it == 'a');
+		*(it + 1) = 'x';
+		EATEST_VERIFY(h->s == "axc");
+		EATEST_VERIFY(h->s.end_safe() - it == 3);
+		EATEST_VERIFY(h->s.cbegin_safe() == it);
+
+		// string moves to heap, old iterator still points inside the string body
+		h->s.append(100, 'z');
+		EATEST_VERIFY(h->s.c_str() != p);
+		EATEST_VERIFY(*it == 'a');
+
+		auto it2 = h->s.begin_safe();
+		EATEST_VERIFY(*(it2 + 100) == 'z');
+
+#if EASTL_EXCEPTIONS_ENABLED
+		h = nullptr;
+		try
+		{
+			char c = *it;
+			EATEST_VERIFY(c == -1);  // Should not get here, as exception thrown.
+		}
+		catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+		catch (...) { EATEST_VERIFY(false); }
+#endif
+	}
+
+	{
+		// a string on the stack still needs to move to heap
+		safememory::string s("abc");
+		const char* p = s.c_str();
+		auto it = s.begin_safe();
+		EATEST_VERIFY(s.c_str() != p);
+		EATEST_VERIFY(*it == 'a');
+	}
+
+#if EASTL_EXCEPTIONS_ENABLED
+	{
+		// a vector slot outlives the string in it, the iterator must not
+		safememory::vector<safememory::string> v;
+		v.emplace_back("abc");
+		v.emplace_back("def");
+		auto it = v.back().begin_safe();
+		EATEST_VERIFY(*it == 'd');
+		v.pop_back();
+		try
+		{
+			char c = *it;
+			EATEST_VERIFY(c == -1);  // Should not get here, as exception thrown.
+		}
+		catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+		catch (...) { EATEST_VERIFY(false); }
+	}
+
+	{
+		safememory::vector<safememory::string> v;
+		v.emplace_back("abc");
+		auto it = v.front().cbegin_safe();
+		EATEST_VERIFY(*it == 'a');
+		v.erase(v.begin());
+		try
+		{
+			char c = *it;
+			EATEST_VERIFY(c == -1);  // Should not get here, as exception thrown.
+		}
+		catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+		catch (...) { EATEST_VERIFY(false); }
+	}
+
+	{
+		// a hash node lives as long as the string in it, so it stays on SSO
+		safememory::unordered_map<int, safememory::string> m;
+		m.emplace(1, safememory::string("abc"));
+		const char* p = m.find(1)->second.c_str();
+		auto it = m.find(1)->second.begin_safe();
+		EATEST_VERIFY(m.find(1)->second.c_str() == p);
+		EATEST_VERIFY(*it == 'a');
+		m.erase(1);
+		try
+		{
+			char c = *it;
+			EATEST_VERIFY(c == -1);  // Should not get here, as exception thrown.
+		}
+		catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+		catch (...) { EATEST_VERIFY(false); }
+	}
+
+	{
+		auto h = safememory::make_owning<StringIteratorHolder>("abc");
+		try
+		{
+			char c = *h->it;
+			EATEST_VERIFY(c == -1);  // Should not get here, as exception thrown.
+		}
+		catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+		catch (...) { EATEST_VERIFY(false); }
+	}
+#endif
+
+	return nErrorCount;
+}
+
+
+struct FormatThrows {};
+
+template<>
+struct fmt::formatter<FormatThrows> : formatter<int> {
+	template<class FormatContext>
+	auto format(const FormatThrows&, FormatContext& ctx) const -> decltype(ctx.out()) {
+		throw std::runtime_error("format");
+	}
+};
+
+int TestStringFormat() {
+
+	int nErrorCount = 0;
+
+	{
+		safememory::string s = safememory::format("{} {}", 42, "abc");
+		VERIFY(s == "42 abc");
+
+		auto cap = s.capacity();
+		safememory::format_to(s, "{:>4}", 7);
+		VERIFY(s == "42 abc   7");
+		VERIFY(s.capacity() == cap);
+
+		safememory::format_to(s, " {:.2f}", 0.5).append(1, '!');
+		VERIFY(s == "42 abc   7 0.50!");
+
+		// string as its own argument
+		safememory::format_to(s, "|{}", s);
+		VERIFY(s == "42 abc   7 0.50!|42 abc   7 0.50!");
+
+		safememory::string s2;
+		safememory::format_to(s2, "{}", s);
+		VERIFY(s2 == s);
+	}
+
+	{
+		// long output grows the string
+		safememory::basic_string<char, safememory::memory_safety::none> s;
+		eastl::string s2;
+		for(int i = 0; i < 1000; i++)
+		{
+			safememory::format_to(s, "{},", i);
+			s2.append_sprintf("%d,", i);
+		}
+		VERIFY(s.size() == s2.size());
+		VERIFY(s.to_string_view_unsafe() == s2);
+
+		safememory::basic_string_safe<char> s3;
+		safememory::format_to(s3, "{:x}", 255);
+		VERIFY(s3 == "ff");
+	}
+
+#if EASTL_EXCEPTIONS_ENABLED
+	{
+		// an exception after the string has grown keeps its previous size
+		safememory::string s("abc");
+		try
+		{
+			safememory::format_to(s, "{}{}{}", eastl::string(200, 'x').c_str(), eastl::string(2000, 'y').c_str(), FormatThrows());
+			VERIFY(false);  // Should not get here, as exception thrown.
+		}
+		catch (std::runtime_error&) { VERIFY(true); }
+		VERIFY(s == "abc");
+		VERIFY(s.size() == 3);
+	}
+#endif
+
+	return nErrorCount;
+}
+
+int TestStringLiteral() {
+
+	using namespace safememory::literals;
+
+	int nErrorCount = 0;
+
+	{
+		// hash at compile time, same for equal literals
+		constexpr safememory::string_literal a("content-type");
+		static_assert(a.hash() == safememory::detail::fnv1a_32("content-type", 12));
+		// hash fits in padding, when size_type is 32 bits
+		static_assert(sizeof(eastl_size_t) != 4 || sizeof(a) == 2 * sizeof(const char*));
+
+		safememory::string_literal b("content-type");
+		VERIFY(a.hash() == b.hash());
+		VERIFY(a == b);
+		VERIFY(a != safememory::string_literal("content-typE"));
+		VERIFY(safememory::string_literal() == safememory::string_literal(""));
+
+		// interned literals share characters
+		auto c = "content-type"_lit;
+		auto d = "content-type"_lit;
+		VERIFY(c.c_str() == d.c_str());
+		VERIFY(c == d && c == a);
+		VERIFY(c.size() == 12 && c.hash() == a.hash());
+		VERIFY(u"abc"_lit == safememory::u16string_literal(u"abc"));
+	}
+
+	{
+		static constexpr auto sw = safememory::make_literal_switch("host"_lit, "accept"_lit,
+			"content-type"_lit, "content-length"_lit, "connection"_lit, "cookie"_lit);
+
+		VERIFY(sw.size() == 6);
+		VERIFY(sw[2] == "content-type"_lit);
+
+		safememory::string s("cookie");
+		switch(sw.find(s))
+		{
+			case sw.index_of("cookie"_lit): VERIFY(true); break;
+			default: VERIFY(false);
+		}
+
+		for(size_t i = 0; i != sw.size(); ++i)
+		{
+			VERIFY(sw.find(sw[i]) == i);
+			safememory::string str;
+			str.append(sw[i]);
+			VERIFY(sw.find(str) == i);
+		}
+
+		VERIFY(sw.find(safememory::string("cookies")) == sw.npos);
+		VERIFY(sw.find(safememory::string("")) == sw.npos);
+		VERIFY(sw.find(safememory::string_literal("Host")) == sw.npos);
+
+		safememory::string_view v(s);
+		VERIFY(sw.find(v) == 5);
+	}
+
+	return nErrorCount;
+}
+
+int TestStringResizeAndOverwrite() {
+
+	int nErrorCount = 0;
+
+	{
+		safememory::string s("abc");
+		s.resize_and_overwrite(100, [](safememory::string::iterator it, size_t n) {
+			EA_UNUSED(n);
+			it[3] = '-';
+			for(int i = 0; i < 5; i++)
+				it[4 + i] = static_cast<char>('0' + i);
+			return 9;
+		});
+		EATEST_VERIFY(s == "abc-01234");
+		EATEST_VERIFY(s.capacity() >= 100);
+		EATEST_VERIFY(strlen(s.c_str()) == 9);
+
+		// shrink
+		s.resize_and_overwrite(2, [](safememory::string::iterator, size_t n) { return n; });
+		EATEST_VERIFY(s == "ab");
+
+		// as a receive into a buffer
+		const char msg[] = "GET / HTTP/1.1";
+		s.resize_and_overwrite_unsafe(1500, [&msg](char* p, size_t n) {
+			size_t len = sizeof(msg) - 1 < n ? sizeof(msg) - 1 : n;
+			memcpy(p, msg, len);
+			return len;
+		});
+		EATEST_VERIFY(s == msg);
+	}
+
+#if EASTL_EXCEPTIONS_ENABLED
+	{
+		safememory::string s("abc");
+		try
+		{
+			s.resize_and_overwrite(10, [](safememory::string::iterator, size_t n) { return n + 1; });
+			EATEST_VERIFY(false);  // Should not get here, as exception thrown.
+		}
+		catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+		catch (...) { EATEST_VERIFY(false); }
+		EATEST_VERIFY(s == "abc");
+
+		try
+		{
+			s.resize_and_overwrite(10, [](safememory::string::iterator it, size_t) {
+				it[1000] = 'x';
+				return 0;
+			});
+			EATEST_VERIFY(false);  // Should not get here, as exception thrown.
+		}
+		catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+		catch (...) { EATEST_VERIFY(false); }
+		EATEST_VERIFY(s == "abc");
+
+		// op changing the string itself
+		try
+		{
+			s.resize_and_overwrite(100, [&s](safememory::string::iterator, size_t n) {
+				s.clear();
+				s.shrink_to_fit();
+				return n;
+			});
+			EATEST_VERIFY(false);  // Should not get here, as exception thrown.
+		}
+		catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+		catch (...) { EATEST_VERIFY(false); }
+		EATEST_VERIFY(s.size() <= s.capacity());
+
+		try
+		{
+			s.resize_and_overwrite(100, [&s](safememory::string::iterator, size_t n) {
+				while(s.capacity() <= n)
+					s.push_back('x');
+				return n;
+			});
+			EATEST_VERIFY(false);  // Should not get here, as exception thrown.
+		}
+		catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+		catch (...) { EATEST_VERIFY(false); }
+		EATEST_VERIFY(s.size() <= s.capacity());
+	}
+#endif
+
+	return nErrorCount;
+}
+
 int TestString()
 {
 	int nErrorCount = 0;
@@ -108,6 +517,10 @@ int TestString()
 #endif
 
 	nErrorCount += TestToString();
+	nErrorCount += TestStringSsoIterators();
+	nErrorCount += TestStringFormat();
+	nErrorCount += TestStringLiteral();
+	nErrorCount += TestStringResizeAndOverwrite();
 
 	return nErrorCount;
 
@@ -0,0 +1,241 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Electronic Arts Inc. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+
+#include "EASTLTest.h"
+#include <safememory/string_view.h>
+
+
+// Template instantations.
+// These tell the compiler to compile all the functions for the given class.
+template class safememory::basic_string_view<char>;
+template class safememory::basic_string_view<char16_t>;
+template class safememory::basic_string_view<char, safememory::memory_safety::none>;
+
+
+template<safememory::memory_safety Safety>
+int TestStringViewImpl()
+{
+	typedef safememory::basic_string_view<char, Safety> View;
+	typedef safememory::basic_string<char, Safety> String;
+
+	int nErrorCount = 0;
+
+	{
+		View v;
+		EATEST_VERIFY(v.empty());
+		EATEST_VERIFY(v.size() == 0);
+		EATEST_VERIFY(v.begin() == v.end());
+		EATEST_VERIFY(v.find('a') == View::npos);
+		EATEST_VERIFY(v.substr(0).empty());
+	}
+
+	{
+		// short string stays on SSO, view doesn't move it to the heap
+		String s("abc");
+		const char* p = s.c_str();
+		View v(s);
+		EATEST_VERIFY(v.size() == 3);
+		EATEST_VERIFY(v == safememory::string_literal("abc"));
+		EATEST_VERIFY(v[0] == 'a' && v.front() == 'a' && v.back() == 'c');
+		EATEST_VERIFY(s.c_str() == p);
+
+		int n = 0;
+		for(char c : v)
+			n += c;
+		EATEST_VERIFY(n == 'a' + 'b' + 'c');
+		EATEST_VERIFY(std::equal(v.rbegin(), v.rend(), "cba"));
+	}
+
+	{
+		String s("  {\"key\": [12, true]}  ");
+		View v(s);
+
+		// skip whitespace, take a token
+		v.remove_prefix(v.find_first_not_of(' '));
+		EATEST_VERIFY(v.starts_with('{'));
+		v.remove_suffix(v.size() - v.find_last_not_of(' ') - 1);
+		EATEST_VERIFY(v.ends_with('}'));
+
+		auto q1 = v.find('"');
+		auto q2 = v.find('"', q1 + 1);
+		EATEST_VERIFY(v.substr(q1 + 1, q2 - q1 - 1) == safememory::string_literal("key"));
+
+		auto d1 = v.find_if([](char c) { return c >= '0' && c <= '9'; });
+		auto d2 = v.find_if_not([](char c) { return c >= '0' && c <= '9'; }, d1);
+		EATEST_VERIFY(v.substr(d1, d2 - d1) == safememory::string_literal("12"));
+		EATEST_VERIFY(v.substr(d2 + 2).starts_with(safememory::string_literal("true")));
+
+		EATEST_VERIFY(v.find(View(safememory::string_literal("true"))) == d2 + 2);
+		EATEST_VERIFY(v.rfind(']') == v.size() - 2);
+		EATEST_VERIFY(v.find_first_of(View(safememory::string_literal("[]"))) == 8);
+		EATEST_VERIFY(v.find_if([](char) { return false; }) == View::npos);
+		EATEST_VERIFY(v.find_if([](char) { return true; }, v.size()) == View::npos);
+
+		// arguments out of range on searching methods are fine
+		EATEST_VERIFY(v.find('a', 1000) == View::npos);
+		EATEST_VERIFY(v.find_if_not([](char) { return true; }, 1000) == View::npos);
+
+		View v2(v);
+		EATEST_VERIFY(v2 == v);
+		v2.remove_prefix(1);
+		EATEST_VERIFY(v2 != v);
+		EATEST_VERIFY(v2 < v);
+		EATEST_VERIFY(v.compare(v2) > 0);
+		v2.swap(v);
+		EATEST_VERIFY(v.size() + 1 == v2.size());
+	}
+
+	return nErrorCount;
+}
+
+
+int TestStringView()
+{
+	int nErrorCount = 0;
+
+	nErrorCount += TestStringViewImpl<safememory::memory_safety::safe>();
+	nErrorCount += TestStringViewImpl<safememory::memory_safety::none>();
+
+	{
+		safememory::u16string s(u"hello");
+		safememory::u16string_view v(s);
+		EATEST_VERIFY(v.size() == 5);
+		EATEST_VERIFY(v.find(u'l') == 2);
+		EATEST_VERIFY(v == safememory::u16string_literal(u"hello"));
+	}
+
+	{
+		// from_chars
+		safememory::string s("1234 -56 0x1f 2.5e3 abc");
+		safememory::string_view v(s);
+
+		int i = 0;
+		auto r = safememory::from_chars(v, i);
+		EATEST_VERIFY(r.ec == std::errc() && r.count == 4 && i == 1234);
+		v.remove_prefix(r.count + 1);
+
+		r = safememory::from_chars(v, i);
+		EATEST_VERIFY(r.ec == std::errc() && r.count == 3 && i == -56);
+		v.remove_prefix(r.count + 3);
+
+		unsigned u = 0;
+		r = safememory::from_chars(v, u, 16);
+		EATEST_VERIFY(r.ec == std::errc() && r.count == 2 && u == 31);
+		v.remove_prefix(r.count + 1);
+
+		double d = 0;
+		r = safememory::from_chars(v, d);
+		EATEST_VERIFY(r.ec == std::errc() && r.count == 5 && d == 2500.0);
+		v.remove_prefix(r.count + 1);
+
+		r = safememory::from_chars(v, i);
+		EATEST_VERIFY(r.ec == std::errc::invalid_argument && r.count == 0 && i == -56);
+
+		uint8_t b = 0;
+		r = safememory::from_chars(safememory::string_literal("300"), b);
+		EATEST_VERIFY(r.ec == std::errc::result_out_of_range);
+
+		r = safememory::from_chars(s, i);
+		EATEST_VERIFY(r.ec == std::errc() && i == 1234);
+
+		r = safememory::from_chars(safememory::string_view(), i);
+		EATEST_VERIFY(r.ec == std::errc::invalid_argument);
+
+		// round-trip of shortest representation
+		for(double x : {0.1, 1.0 / 3, 1e-300, 123456789.125, -2.5e17})
+		{
+			safememory::string str;
+			str.append_number(x);
+			double y = 0;
+			r = safememory::from_chars(str, y);
+			EATEST_VERIFY(r.ec == std::errc() && r.count == str.size() && x == y);
+		}
+	}
+
+#if EASTL_EXCEPTIONS_ENABLED
+	{
+		safememory::string s("abc");
+		safememory::string_view v(s);
+
+		try
+		{
+			auto v2 = v.substr(4);
+			EATEST_VERIFY(v2.empty() && false);  // Should not get here, as exception thrown.
+		}
+		catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+		catch (...) { EATEST_VERIFY(false); }
+
+		try
+		{
+			v.remove_prefix(4);
+			EATEST_VERIFY(false);  // Should not get here, as exception thrown.
+		}
+		catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+		catch (...) { EATEST_VERIFY(false); }
+
+		try
+		{
+			char c = v[3];
+			EATEST_VERIFY(c == -1);  // Should not get here, as exception thrown.
+		}
+		catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+		catch (...) { EATEST_VERIFY(false); }
+
+		try
+		{
+			char c = *v.end();
+			EATEST_VERIFY(c == -1);  // Should not get here, as exception thrown.
+		}
+		catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+		catch (...) { EATEST_VERIFY(false); }
+
+		safememory::string_view empty;
+		try
+		{
+			char c = empty.front();
+			EATEST_VERIFY(c == -1);  // Should not get here, as exception thrown.
+		}
+		catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+		catch (...) { EATEST_VERIFY(false); }
+	}
+#endif
+
+#if defined(SAFEMEMORY_DEZOMBIEFY_ITERATORS) && EASTL_EXCEPTIONS_ENABLED
+	{
+		// the view is pinned to the viewed string, a shrunk or moved string is detected
+		safememory::string s("a string long enough to live on the heap");
+		safememory::string_view v(s);
+		auto it = v.begin();
+		s.resize(3);
+		try
+		{
+			char c = v.back();
+			EATEST_VERIFY(c == -1);  // Should not get here, as exception thrown.
+		}
+		catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+		catch (...) { EATEST_VERIFY(false); }
+
+		try
+		{
+			char c = *it;
+			EATEST_VERIFY(c == -1);  // Should not get here, as exception thrown.
+		}
+		catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+		catch (...) { EATEST_VERIFY(false); }
+
+		safememory::string_view v2(s);
+		safememory::string s2(std::move(s));
+		try
+		{
+			auto n = v2.find('a');
+			EATEST_VERIFY(n == 0);  // Should not get here, as exception thrown.
+		}
+		catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+		catch (...) { EATEST_VERIFY(false); }
+	}
+#endif
+
+	return nErrorCount;
+}
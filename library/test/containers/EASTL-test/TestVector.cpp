@@ -4,6 +4,8 @@
 
 #include "EASTLTest.h"
 #include <safememory/vector.h>
+#include <safememory/string.h>
+#include <safememory/algorithm.h>
 #include <string>
 #include <deque>
 #include <list>
@@ -1723,6 +1725,353 @@ int TestVectorImpl()
 		// static_assert(sizeof(EboVector) == 3 * sizeof(void*), "");
 	// }
 
+	{
+		// void resize_and_overwrite(size_type n, Operation op);
+		// void resize_and_overwrite_unsafe(size_type n, Operation op);
+
+		VEC<uint8_t> buff(3, 1);
+		buff.resize_and_overwrite(1500, [](typename VEC<uint8_t>::iterator it, size_t n) {
+			for(size_t j = 3; j < 10; j++)
+				it[j] = (uint8_t)j;
+			return n < 10 ? n : 10;
+		});
+		EATEST_VERIFY(buff.size() == 10 && buff.capacity() >= 1500);
+		EATEST_VERIFY(buff[2] == 1 && buff[9] == 9);
+
+		buff.resize_and_overwrite_unsafe(4, [](uint8_t* p, size_t n) {
+			p[3] = 42;
+			return n;
+		});
+		EATEST_VERIFY(buff.size() == 4 && buff.back() == 42);
+
+#if EASTL_EXCEPTIONS_ENABLED
+		try
+		{
+			buff.resize_and_overwrite(8, [](typename VEC<uint8_t>::iterator, size_t n) { return n + 1; });
+			EATEST_VERIFY(false);  // Should not get here, as exception thrown.
+		}
+		catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+		catch (...) { EATEST_VERIFY(false); }
+		EATEST_VERIFY(buff.size() == 4);
+
+		// op changing the vector itself
+		try
+		{
+			buff.resize_and_overwrite(64, [&buff](typename VEC<uint8_t>::iterator, size_t n) {
+				buff.clear();
+				buff.shrink_to_fit();
+				return n;
+			});
+			EATEST_VERIFY(false);  // Should not get here, as exception thrown.
+		}
+		catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+		catch (...) { EATEST_VERIFY(false); }
+		EATEST_VERIFY(buff.size() <= buff.capacity());
+
+		try
+		{
+			buff.resize_and_overwrite(64, [&buff](typename VEC<uint8_t>::iterator, size_t n) {
+				while(buff.capacity() <= n)
+					buff.push_back(0);
+				return n;
+			});
+			EATEST_VERIFY(false);  // Should not get here, as exception thrown.
+		}
+		catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+		catch (...) { EATEST_VERIFY(false); }
+		EATEST_VERIFY(buff.size() <= buff.capacity());
+#endif
+	}
+
+	{
+		// void append(const_iterator_arg first, const_iterator_arg last);
+		// void append(const this_type& other);
+		// void append_unsafe(const_pointer p, size_type n);
+
+		VEC<uint8_t> src(300);
+		for(i = 0; i < src.size(); i++)
+			src[i] = (uint8_t)i;
+
+		VEC<uint8_t> buff;
+		buff.append(src.begin(), src.begin() + 10);
+		EATEST_VERIFY(buff.size() == 10 && buff[9] == 9);
+		buff.append(src.begin() + 10, src.end());
+		EATEST_VERIFY(buff.size() == 300 && buff == src);
+		buff.append(src.begin(), src.begin());
+		EATEST_VERIFY(buff.size() == 300);
+
+		uint8_t raw[3] = { 7, 8, 9 };
+		buff.append_unsafe(raw, 3);
+		EATEST_VERIFY(buff.size() == 303 && buff.back() == 9);
+
+		// appending our own elements while growing
+		buff.shrink_to_fit();
+		buff.append(buff.begin(), buff.end());
+		EATEST_VERIFY(buff.size() == 606 && buff[303] == 0 && buff[605] == 9);
+		buff.append(buff);
+		EATEST_VERIFY(buff.size() == 1212 && buff[1211] == 9);
+
+		// not trivially copyable
+		VEC<TestObject> toArray(2, TestObject(3));
+		VEC<TestObject> toArray2;
+		toArray2.append(toArray);
+		toArray2.append(toArray2.begin(), toArray2.end());
+		EATEST_VERIFY(toArray2.size() == 4 && toArray2[3] == TestObject(3));
+	}
+
+	{
+		// safememory::sort
+		VEC<int> v = { 5, 3, 4, 1, 2 };
+		safememory::sort(v.begin(), v.end());
+		EATEST_VERIFY(VerifySequence(v.begin(), v.end(), int(), "vector::sort", 1, 2, 3, 4, 5, -1));
+
+		safememory::sort(v.begin() + 1, v.end(), [](int a, int b) { return a > b; });
+		EATEST_VERIFY(VerifySequence(v.begin(), v.end(), int(), "vector::sort", 1, 5, 4, 3, 2, -1));
+
+		VEC<int> v2;
+		safememory::sort(v2.begin(), v2.end());
+		EATEST_VERIFY(v2.empty());
+
+		// larger than the insertion sort limit, with duplicates
+		VEC<int> v3;
+		for(int j = 0; j < 1000; j++)
+			v3.push_back((j * 7919) % 101);
+		safememory::sort(v3.begin(), v3.end());
+		EATEST_VERIFY(eastl::is_sorted(v3.begin(), v3.end()));
+		EATEST_VERIFY(v3.front() == 0 && v3.back() == 100);
+
+		VEC<TestObject> v4;
+		for(int j = 0; j < 100; j++)
+			v4.push_back(TestObject((j * 31) % 17));
+		safememory::sort(v4.begin(), v4.end(), [](const TestObject& a, const TestObject& b) { return a.mX > b.mX; });
+		EATEST_VERIFY(v4.front().mX == 16 && v4.back().mX == 0);
+		EATEST_VERIFY(eastl::is_sorted(v4.begin(), v4.end(), [](const TestObject& a, const TestObject& b) { return a.mX > b.mX; }));
+
+		// not a strict weak ordering, order is unspecified but stays in range
+		VEC<int> v5(100, 7);
+		safememory::sort(v5.begin(), v5.end(), [](int a, int b) { return a <= b; });
+		EATEST_VERIFY(v5.size() == 100 && eastl::count(v5.begin(), v5.end(), 7) == 100);
+		safememory::sort(v5.begin(), v5.end(), [](int, int) { return true; });
+		EATEST_VERIFY(eastl::count(v5.begin(), v5.end(), 7) == 100);
+
+	#if EASTL_EXCEPTIONS_ENABLED
+		try
+		{
+			safememory::sort(v.end(), v.begin());
+			EATEST_VERIFY(false);  // Should not get here, as exception thrown.
+		}
+		catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+		catch (...) { EATEST_VERIFY(false); }
+	#endif
+	}
+
+	EATEST_VERIFY(TestObject::IsClear());
+	TestObject::Reset();
+
+#if EASTL_EXCEPTIONS_ENABLED
+	{
+		VEC<int> v1 = { 1, 2, 3 };
+		VEC<int> v2 = { 1, 2, 3 };
+		VEC<int> v3;
+		try
+		{
+			v3.append(v1.begin(), v2.end());
+			EATEST_VERIFY(false);  // Should not get here, as exception thrown.
+		}
+		catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+		catch (...) { EATEST_VERIFY(false); }
+
+		try
+		{
+			v3.append(v1.end(), v1.begin());
+			EATEST_VERIFY(false);  // Should not get here, as exception thrown.
+		}
+		catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+		catch (...) { EATEST_VERIFY(false); }
+		EATEST_VERIFY(v3.empty());
+
+		// iterators may go out of range, but not be dereferenced there
+		auto it = v1.begin();
+		EATEST_VERIFY(it[2] == 3 && *(it + 1) == 2);
+		--it;
+		try
+		{
+			int x = *it;
+			EATEST_VERIFY(x == -1);  // Should not get here, as exception thrown.
+		}
+		catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+		catch (...) { EATEST_VERIFY(false); }
+		++it;
+		EATEST_VERIFY(it == v1.begin());
+
+		it += v1.capacity();
+		try
+		{
+			int x = *it;
+			EATEST_VERIFY(x == -1);  // Should not get here, as exception thrown.
+		}
+		catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+		catch (...) { EATEST_VERIFY(false); }
+
+		try
+		{
+			int x = *v3.begin();
+			EATEST_VERIFY(x == -1);  // Should not get here, as exception thrown.
+		}
+		catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+		catch (...) { EATEST_VERIFY(false); }
+
+		EATEST_VERIFY(v1.begin() != v3.begin());
+
+		// with 64 bits size_type, a count whose size in bytes overflows std::size_t
+		if constexpr (sizeof(eastl_size_t) == sizeof(std::size_t))
+		{
+			try
+			{
+				v3.reserve(std::numeric_limits<eastl_size_t>::max() / 2);
+				EATEST_VERIFY(false);  // Should not get here, as exception thrown.
+			}
+			catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+			catch (...) { EATEST_VERIFY(false); }
+			EATEST_VERIFY(v3.empty() && v3.capacity() == 0);
+		}
+	}
+#endif
+
+	return nErrorCount;
+}
+
+// usable size of a block from an allocator with power of 2 buckets
+static std::size_t Pow2BucketSize(std::size_t bytes)
+{
+	std::size_t r = 8;
+	while(r < bytes)
+		r *= 2;
+	return r;
+}
+
+template <typename T>
+int TestFlexibleArrayCapacityImpl()
+{
+	typedef safememory::detail::flexible_array<T> Array;
+	int nErrorCount = 0;
+
+	EATEST_VERIFY(Array::data_offset >= sizeof(typename Array::size_type));
+	EATEST_VERIFY(Array::data_offset % alignof(T) == 0);
+	EATEST_VERIFY(Array::calculateCapacity(0) == 0);
+	EATEST_VERIFY(Array::calculateCapacity(Array::data_offset) == 0);
+	EATEST_VERIFY(Array::calculateCapacity(Array::data_offset + sizeof(T) - 1) == 0);
+	EATEST_VERIFY(Array::calculateCapacity(sizeof(Array) - 1) == 0);
+
+	for(eastl_size_t n = 0; n <= 64; ++n)
+	{
+		const std::size_t bytes = Array::calculateSize(n);
+		EATEST_VERIFY(bytes >= sizeof(Array)); // the header object itself is constructed there
+		EATEST_VERIFY(bytes == eastl::max(sizeof(Array), Array::data_offset + n * sizeof(T)));
+		EATEST_VERIFY(n == 0 || bytes < sizeof(Array) + n * sizeof(T)); // no tail padding of sizeof(Array)
+
+		// exact size gives back at least the same count, and exactly the size again
+		const eastl_size_t exact = Array::calculateCapacity(bytes);
+		EATEST_VERIFY(exact >= n);
+		EATEST_VERIFY(Array::calculateSize(exact) == bytes);
+		EATEST_VERIFY(Array::calculateCapacity(bytes + sizeof(T)) == exact + 1);
+
+		// capacity from the usable size fits in it, and nothing more would
+		const std::size_t usable = Pow2BucketSize(bytes);
+		const eastl_size_t capacity = Array::calculateCapacity(usable);
+		EATEST_VERIFY(capacity >= n);
+		EATEST_VERIFY(Array::calculateSize(capacity) <= usable);
+		EATEST_VERIFY(Array::calculateSize(capacity + 1) > usable);
+	}
+
+	return nErrorCount;
+}
+
+struct alignas(32) Aligned32Type
+{
+	char c[32];
+};
+
+int TestFlexibleArrayCapacity()
+{
+	int nErrorCount = 0;
+
+	nErrorCount += TestFlexibleArrayCapacityImpl<char>();
+	nErrorCount += TestFlexibleArrayCapacityImpl<uint16_t>();
+	nErrorCount += TestFlexibleArrayCapacityImpl<uint32_t>();
+	nErrorCount += TestFlexibleArrayCapacityImpl<uint64_t>();
+	nErrorCount += TestFlexibleArrayCapacityImpl<Aligned32Type>();
+
+	return nErrorCount;
+}
+
+int TestVectorRelocatable()
+{
+	int nErrorCount = 0;
+
+	{
+		// owning pointers are moved to the new storage as raw bytes
+		vector<safememory::owning_ptr<int>> v;
+		for(int i = 0; i != 100; ++i)
+			v.push_back(safememory::make_owning<int>(i));
+
+		for(int i = 0; i != 100; ++i)
+			EATEST_VERIFY(*v[i] == i);
+
+		v.resize(1000);
+		EATEST_VERIFY(*v[99] == 99 && v[999] == nullptr);
+	}
+
+	{
+		// soft pointers on the heap are registered by address, the relocated ones
+		// must still be found when the owner goes away
+		auto o = safememory::make_owning<int>(5);
+		vector<safememory::soft_ptr<int>> v;
+		for(int i = 0; i != 100; ++i)
+			v.push_back(o);
+
+		for(int i = 0; i != 100; ++i)
+			EATEST_VERIFY(*v[i] == 5);
+
+#if EASTL_EXCEPTIONS_ENABLED
+		o = nullptr;
+		try
+		{
+			int i = *v[50];
+			EATEST_VERIFY(i == -1);  // Should not get here, as exception thrown.
+		}
+		catch (nodecpp::error::memory_error&) { EATEST_VERIFY(true); }
+		catch (...) { EATEST_VERIFY(false); }
+#endif
+	}
+
+	{
+		// strings don't anchor on the storage, their safe iterators hold
+		// the string own buffer, that moves with it
+		vector<safememory::string> v;
+		v.emplace_back("abc");
+		auto it0 = v[0].begin_safe();
+
+		for(int i = 1; i != 100; ++i)
+			v.emplace_back("abc");
+
+		auto it = v[0].begin_safe();
+		EATEST_VERIFY(*it == 'a');
+		*(it + 1) = 'x';
+		EATEST_VERIFY(v[0] == "axc");
+		EATEST_VERIFY(v[99] == "abc");
+		EATEST_VERIFY(*(it0 + 1) == 'x');
+	}
+
+	{
+		vector<vector<int>> v;
+		for(int i = 0; i != 100; ++i)
+			v.push_back(vector<int>(i, i));
+
+		for(int i = 0; i != 100; ++i)
+			EATEST_VERIFY(v[i].size() == (size_t)i && (i == 0 || v[i].back() == i));
+	}
+
 	return nErrorCount;
 }
 
@@ -1739,6 +2088,8 @@ int TestVector()
 
 	nErrorCount += TestVectorImpl<VEC>();
 	nErrorCount += TestVectorImpl<VEC_SAFE>();
+	nErrorCount += TestVectorRelocatable();
+	nErrorCount += TestFlexibleArrayCapacity();
 
 	return nErrorCount;
 }
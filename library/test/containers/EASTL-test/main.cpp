@@ -66,7 +66,7 @@ int main(int argc, char* argv[])
 		// testSuite.AddTest("Bitset",					TestBitset);
 		// testSuite.AddTest("CharTraits",			    TestCharTraits);
 		// testSuite.AddTest("Chrono",					TestChrono);
-		// testSuite.AddTest("Deque",					TestDeque);
+		nErrorCount += TestDeque();
 		// testSuite.AddTest("Extra",					TestExtra);
 		// testSuite.AddTest("Finally",				TestFinally);
 		// testSuite.AddTest("FixedFunction",			TestFixedFunction);
@@ -89,25 +89,26 @@ int main(int argc, char* argv[])
 		// testSuite.AddTest("LRUCache",				TestLruCache);
 		// testSuite.AddTest("List",					TestList);
 		// testSuite.AddTest("ListMap",				TestListMap);
-		// testSuite.AddTest("Map",					TestMap);
+		nErrorCount += TestMap();
 		// testSuite.AddTest("Memory",					TestMemory);
 		// testSuite.AddTest("Meta",				    TestMeta);
 		// testSuite.AddTest("NumericLimits",			TestNumericLimits);
 		// testSuite.AddTest("Optional",				TestOptional);
 		// testSuite.AddTest("Random",					TestRandom);
 		// testSuite.AddTest("Ratio",					TestRatio);
-		// testSuite.AddTest("RingBuffer",				TestRingBuffer);
+		nErrorCount += TestRingBuffer();
 		// testSuite.AddTest("SList",					TestSList);
 		// testSuite.AddTest("SegmentedVector",		TestSegmentedVector);
-		// testSuite.AddTest("Set",					TestSet);
+		nErrorCount += TestSet();
 		// testSuite.AddTest("SmartPtr",				TestSmartPtr);
 		// testSuite.AddTest("Sort",					TestSort);
 		// testSuite.AddTest("Span",				    TestSpan);
 		// testSuite.AddTest("SparseMatrix",			TestSparseMatrix);
+		nErrorCount += TestStableVector();
 		nErrorCount += TestString();
 		// testSuite.AddTest("StringHashMap",			TestStringHashMap);
 		// testSuite.AddTest("StringMap",				TestStringMap);
-		// testSuite.AddTest("StringView",			    TestStringView);
+		nErrorCount += TestStringView();
 		// testSuite.AddTest("TestCppCXTypeTraits",	TestCppCXTypeTraits);
 		// testSuite.AddTest("Tuple",					TestTuple);
 		// testSuite.AddTest("TupleVector",			TestTupleVector);